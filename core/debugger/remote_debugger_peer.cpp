@@ -70,14 +70,14 @@ void RemoteDebuggerPeerTCP::close() {
 		thread.wait_to_finish();
 	}
 	tcp_client->disconnect_from_host();
-	out_buf.clear();
+	out_buf.reset();
 	in_buf.clear();
 }
 
 RemoteDebuggerPeerTCP::RemoteDebuggerPeerTCP(Ref<StreamPeerTCP> p_tcp) {
 	// This means remote debugger takes 16 MiB just because it exists...
 	in_buf.resize((8 << 20) + 4); // 8 MiB should be way more than enough (need 4 extra bytes for encoding packet size).
-	out_buf.resize(8 << 20); // 8 MiB should be way more than enough
+	out_buf.reserve(8 << 20); // 8 MiB should be way more than enough
 	tcp_client = p_tcp;
 	if (tcp_client.is_valid()) { // Attaching to an already connected stream.
 		connected = true;
@@ -94,7 +94,6 @@ RemoteDebuggerPeerTCP::~RemoteDebuggerPeerTCP() {
 
 void RemoteDebuggerPeerTCP::_write_out() {
 	while (tcp_client->get_status() == StreamPeerTCP::STATUS_CONNECTED && tcp_client->wait(NetSocket::POLL_TYPE_OUT) == OK) {
-		uint8_t *buf = out_buf.ptrw();
 		if (out_left <= 0) {
 			if (out_queue.size() == 0) {
 				break; // Nothing left to send
@@ -103,14 +102,15 @@ void RemoteDebuggerPeerTCP::_write_out() {
 			Variant var = out_queue[0];
 			out_queue.pop_front();
 			mutex.unlock();
-			int size = 0;
-			Error err = encode_variant(var, nullptr, size);
-			ERR_CONTINUE(err != OK || size > out_buf.size() - 4); // 4 bytes separator.
-			encode_uint32(size, buf);
-			encode_variant(var, buf + 4, size);
+			out_buf.resize(4); // 4 bytes separator.
+			Error err = encode_variant(var, out_buf, false, 8 << 20);
+			ERR_CONTINUE(err != OK);
+			int size = out_buf.size() - 4;
+			encode_uint32(size, out_buf.ptr());
 			out_left = size + 4;
 			out_pos = 0;
 		}
+		uint8_t *buf = out_buf.ptr();
 		int sent = 0;
 		tcp_client->put_partial_data(buf + out_pos, out_left, sent);
 		out_left -= sent;
@@ -36,6 +36,7 @@
 #include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
 
 class RemoteDebuggerPeer : public RefCounted {
 protected:
@@ -63,7 +64,7 @@ private:
 	List<Array> out_queue;
 	int out_left = 0;
 	int out_pos = 0;
-	Vector<uint8_t> out_buf;
+	LocalVector<uint8_t> out_buf;
 	int in_left = 0;
 	int in_pos = 0;
 	Vector<uint8_t> in_buf;
@@ -349,6 +349,59 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+Vector<uint8_t> Compression::build_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	// Zstandard's dictionary trainer isn't part of the bundled library, so build a raw content
+	// dictionary instead from the leading bytes of each sample, where headers and other shared
+	// content usually live.
+	Vector<uint8_t> dictionary;
+	if (p_samples.is_empty() || p_max_size <= 0) {
+		return dictionary;
+	}
+
+	const int per_sample = CLAMP(p_max_size / p_samples.size(), 64, 4096);
+	for (int i = 0; i < p_samples.size() && dictionary.size() < p_max_size; i++) {
+		const Vector<uint8_t> &sample = p_samples[i];
+		int amount = MIN(MIN(per_sample, sample.size()), p_max_size - dictionary.size());
+		int ofs = dictionary.size();
+		dictionary.resize(ofs + amount);
+		memcpy(dictionary.ptrw() + ofs, sample.ptr(), amount);
+	}
+
+	return dictionary;
+}
+
+Compression::ZstdDictionary::ZstdDictionary(const Vector<uint8_t> &p_data, bool p_for_compression, bool p_for_decompression) {
+	data = p_data;
+	if (p_for_compression) {
+		cdict = ZSTD_createCDict(data.ptr(), data.size(), zstd_level);
+	}
+	if (p_for_decompression) {
+		ddict = ZSTD_createDDict(data.ptr(), data.size());
+	}
+}
+
+Compression::ZstdDictionary::~ZstdDictionary() {
+	ZSTD_freeCDict(cdict);
+	ZSTD_freeDDict(ddict);
+}
+
+int Compression::compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const ZstdDictionary *p_dictionary) {
+	ERR_FAIL_COND_V_MSG(!p_dictionary || !p_dictionary->cdict, -1, "Dictionary wasn't prepared for compression.");
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
+	size_t ret = ZSTD_compress_usingCDict(cctx, p_dst, max_dst_size, p_src, p_src_size, p_dictionary->cdict);
+	ZSTD_freeCCtx(cctx);
+	return ZSTD_isError(ret) ? -1 : (int)ret;
+}
+
+int Compression::decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const ZstdDictionary *p_dictionary) {
+	ERR_FAIL_COND_V_MSG(!p_dictionary || !p_dictionary->ddict, -1, "Dictionary wasn't prepared for decompression.");
+	ZSTD_DCtx *dctx = ZSTD_createDCtx();
+	size_t ret = ZSTD_decompress_usingDDict(dctx, p_dst, p_dst_max_size, p_src, p_src_size, p_dictionary->ddict);
+	ZSTD_freeDCtx(dctx);
+	return ZSTD_isError(ret) ? -1 : (int)ret;
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
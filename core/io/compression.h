@@ -34,6 +34,9 @@
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 class Compression {
 public:
 	static int zlib_level;
@@ -55,6 +58,26 @@ public:
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	// Zstandard raw content dictionary, digested once and then shared by every buffer of a set, from any thread.
+	class ZstdDictionary {
+		friend class Compression;
+
+		Vector<uint8_t> data;
+		ZSTD_CDict_s *cdict = nullptr;
+		ZSTD_DDict_s *ddict = nullptr;
+
+	public:
+		_FORCE_INLINE_ const Vector<uint8_t> &get_data() const { return data; }
+
+		ZstdDictionary(const Vector<uint8_t> &p_data, bool p_for_compression, bool p_for_decompression);
+		~ZstdDictionary();
+	};
+
+	// Zstandard using a raw content dictionary, for sets of small buffers that share content.
+	static Vector<uint8_t> build_zstd_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size);
+	static int compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const ZstdDictionary *p_dictionary);
+	static int decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const ZstdDictionary *p_dictionary);
 };
 
 #endif // COMPRESSION_H
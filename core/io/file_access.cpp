@@ -36,7 +36,10 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/os/condition_variable.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
 
@@ -724,19 +727,12 @@ void FileAccess::store_buffer(const Vector<uint8_t> &p_buffer) {
 }
 
 void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
+	LocalVector<uint8_t> buff;
+	Error err = encode_variant(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
-	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
-	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-
-	store_32(len);
-	store_buffer(buff);
+	store_32(buff.size());
+	store_buffer(buff.ptr(), buff.size());
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
@@ -798,6 +794,127 @@ String FileAccess::get_md5(const String &p_file) {
 	return String::md5(hash);
 }
 
+static BinaryMutex async_mutex;
+static ConditionVariable async_cond;
+static Thread *async_thread = nullptr;
+static LocalVector<FileAccess::AsyncRead> async_queue;
+static uint32_t async_pending = 0;
+static bool async_exit = false;
+
+static void _async_read(const FileAccess::AsyncRead &p_read) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_read.resolve_path ? p_read.resolve_path(p_read.path) : p_read.path, FileAccess::READ, &err);
+
+	uint64_t length = 0;
+	if (f.is_valid()) {
+		uint64_t file_length = f->get_length();
+		uint64_t offset = MIN(p_read.offset, file_length);
+		length = p_read.length == 0 ? file_length - offset : MIN(p_read.length, file_length - offset);
+
+		if (!p_read.callback) {
+			f->prefetch(offset, length);
+			return;
+		}
+
+		Vector<uint8_t> data;
+		data.resize(length);
+		f->seek(offset);
+		length = f->get_buffer(data.ptrw(), length);
+		data.resize(length);
+		p_read.callback(p_read.userdata, p_read.path, OK, data);
+	} else if (p_read.callback) {
+		p_read.callback(p_read.userdata, p_read.path, err, Vector<uint8_t>());
+	}
+}
+
+static void _async_thread_func(void *p_userdata) {
+	LocalVector<FileAccess::AsyncRead> batch;
+
+	while (true) {
+		{
+			MutexLock lock(async_mutex);
+			while (async_queue.is_empty() && !async_exit) {
+				async_cond.wait(lock);
+			}
+			if (async_exit) {
+				break;
+			}
+			batch = async_queue;
+			async_queue.clear();
+		}
+
+		for (const FileAccess::AsyncRead &read : batch) {
+			_async_read(read);
+		}
+
+		MutexLock lock(async_mutex);
+		async_pending -= batch.size();
+		batch.clear();
+		async_cond.notify_all();
+	}
+}
+
+void FileAccess::read_async(const Vector<AsyncRead> &p_reads) {
+	if (p_reads.is_empty()) {
+		return;
+	}
+
+#ifdef THREADS_ENABLED
+	MutexLock lock(async_mutex);
+	if (async_exit) {
+		return;
+	}
+	if (!async_thread) {
+		async_thread = memnew(Thread);
+		async_thread->start(_async_thread_func, nullptr);
+	}
+	for (const AsyncRead &read : p_reads) {
+		async_queue.push_back(read);
+	}
+	async_pending += p_reads.size();
+	async_cond.notify_all();
+#else
+	for (const AsyncRead &read : p_reads) {
+		if (read.callback) {
+			_async_read(read); // Nothing to gain from prefetching without a thread to do it.
+		}
+	}
+#endif
+}
+
+void FileAccess::prefetch_async(const Vector<String> &p_paths, AsyncResolvePath p_resolve_path) {
+	Vector<AsyncRead> reads;
+	reads.resize(p_paths.size());
+	for (int i = 0; i < p_paths.size(); i++) {
+		reads.write[i].path = p_paths[i];
+		reads.write[i].resolve_path = p_resolve_path;
+	}
+	read_async(reads);
+}
+
+void FileAccess::wait_for_async_reads() {
+	MutexLock lock(async_mutex);
+	while (async_pending > 0 && async_thread) {
+		async_cond.wait(lock);
+	}
+}
+
+void FileAccess::finish_async_reads() {
+	{
+		MutexLock lock(async_mutex);
+		async_exit = true;
+		async_pending -= async_queue.size();
+		async_queue.clear();
+		async_cond.notify_all();
+	}
+
+	if (async_thread) {
+		async_thread->wait_to_finish();
+		memdelete(async_thread);
+		async_thread = nullptr;
+	}
+}
+
 String FileAccess::get_multiple_md5(const Vector<String> &p_file) {
 	CryptoCore::MD5Context ctx;
 	ctx.start();
@@ -149,6 +149,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_mapped_range(uint64_t p_offset, uint64_t p_length) const { return nullptr; } ///< get a read-only pointer to a range of the file without copying it, valid until the file is closed; nullptr if the file can't be mapped
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const { return false; } ///< hint that a range of the file will be read soon, so it can be brought into memory ahead of time; false if the backend can't do it without reading the range itself
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -223,6 +225,25 @@ public:
 	static Vector<uint8_t> get_file_as_bytes(const String &p_path, Error *r_error = nullptr);
 	static String get_file_as_string(const String &p_path, Error *r_error = nullptr);
 
+	// Reads queued here are done on a dedicated I/O thread, so the threads
+	// that submit them (usually WorkerThreadPool ones) are not blocked.
+	typedef void (*AsyncReadCallback)(void *p_userdata, const String &p_path, Error p_error, const Vector<uint8_t> &p_data);
+	typedef String (*AsyncResolvePath)(const String &p_path);
+
+	struct AsyncRead {
+		String path;
+		uint64_t offset = 0;
+		uint64_t length = 0; // Up to the end of the file if zero.
+		AsyncReadCallback callback = nullptr; // If null, the range is only prefetched.
+		void *userdata = nullptr;
+		AsyncResolvePath resolve_path = nullptr; // If set, maps the path to the file to read, on the I/O thread.
+	};
+
+	static void read_async(const Vector<AsyncRead> &p_reads); ///< submit a batch of reads, callbacks are called from the I/O thread
+	static void prefetch_async(const Vector<String> &p_paths, AsyncResolvePath p_resolve_path = nullptr); ///< submit a batch of whole files to prefetch
+	static void wait_for_async_reads();
+	static void finish_async_reads(); ///< drop pending reads and stop the I/O thread
+
 	static PackedByteArray _get_file_as_bytes(const String &p_path) { return get_file_as_bytes(p_path, &last_file_open_error); }
 	static String _get_file_as_string(const String &p_path) { return get_file_as_string(p_path, &last_file_open_error); }
 
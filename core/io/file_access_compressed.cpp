@@ -30,8 +30,13 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
+// Reads spanning at least this many whole blocks decompress them in parallel.
+static const uint32_t PARALLEL_READ_MIN_BLOCKS = 8;
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -40,6 +45,68 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+void FileAccessCompressed::set_dictionary(const Compression::ZstdDictionary *p_dictionary) {
+	ERR_FAIL_COND_MSG(p_dictionary && cmode != Compression::MODE_ZSTD, "Dictionaries are only supported with Zstandard compression.");
+	dictionary = p_dictionary;
+}
+
+int FileAccessCompressed::_compress_block(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Compression::Mode p_mode, const Compression::ZstdDictionary *p_dictionary) {
+	if (p_dictionary) {
+		return Compression::compress_zstd_with_dictionary(p_dst, p_src, p_src_size, p_dictionary);
+	}
+	return Compression::compress(p_dst, p_src, p_src_size, p_mode);
+}
+
+int FileAccessCompressed::_decompress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const {
+	if (dictionary) {
+		return Compression::decompress_zstd_with_dictionary(p_dst, p_dst_max_size, p_src, p_src_size, dictionary);
+	}
+	return Compression::decompress(p_dst, p_dst_max_size, p_src, p_src_size, cmode);
+}
+
+uint32_t FileAccessCompressed::_get_block_size(uint32_t p_block) const {
+	return p_block == read_block_count - 1 ? read_total % block_size : block_size;
+}
+
+Error FileAccessCompressed::compress_buffer(const uint8_t *p_src, uint64_t p_length, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, const Compression::ZstdDictionary *p_dictionary, Vector<uint8_t> &r_dst) {
+	ERR_FAIL_COND_V(p_block_size == 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_length > UINT32_MAX, ERR_INVALID_PARAMETER, "Compressed files can't hold more than 4 GiB.");
+
+	CharString mgc = p_magic.utf8();
+	ERR_FAIL_COND_V(mgc.length() != 4, ERR_INVALID_PARAMETER);
+
+	uint32_t bc = (p_length / p_block_size) + 1;
+	uint64_t header_size = 16 + bc * 4;
+
+	r_dst.resize(header_size);
+	uint8_t *w = r_dst.ptrw();
+	memcpy(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, w + 4); //write compression mode 4
+	encode_uint32(p_block_size, w + 8); //write block size 4
+	encode_uint32(p_length, w + 12); //max amount of data written 4
+
+	LocalVector<uint8_t> cblock;
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? p_length % p_block_size : p_block_size;
+		const uint8_t *bp = &p_src[(uint64_t)i * p_block_size];
+
+		cblock.resize(Compression::get_max_compressed_buffer_size(bl, p_mode));
+		int s = _compress_block(cblock.ptr(), bp, bl, p_mode, p_dictionary);
+		ERR_FAIL_COND_V(s < 0, ERR_CANT_CREATE);
+
+		uint64_t ofs = r_dst.size();
+		r_dst.resize(ofs + s);
+		memcpy(r_dst.ptrw() + ofs, cblock.ptr(), s);
+		encode_uint32(s, r_dst.ptrw() + 16 + i * 4); //compressed size
+	}
+
+	uint64_t ofs = r_dst.size();
+	r_dst.resize(ofs + 4);
+	memcpy(r_dst.ptrw() + ofs, mgc.get_data(), 4); //magic at the end too
+
+	return OK;
+}
+
 #define WRITE_FIT(m_bytes)                                  \
 	{                                                       \
 		if (write_pos + (m_bytes) > write_max) {            \
@@ -82,7 +149,7 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	read_block_count = bc;
 	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
+	int ret = _decompress_block(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize);
 	read_block = 0;
 	read_pos = 0;
 
@@ -132,37 +199,13 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+		Vector<uint8_t> data;
+		Error err = compress_buffer(write_ptr, write_max, magic, cmode, block_size, dictionary, data);
+		if (err == OK) {
+			f->store_buffer(data.ptr(), data.size());
+		} else {
+			ERR_PRINT("Can't compress file '" + f->get_path() + "'.");
 		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 
 		buffer.clear();
 
@@ -214,7 +257,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 				read_block = block_idx;
 				f->seek(read_blocks[read_block].offset);
 				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				int ret = _decompress_block(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize);
 				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			}
@@ -278,7 +321,7 @@ uint8_t FileAccessCompressed::get_8() const {
 		if (read_block < read_block_count) {
 			//read another block of compressed data
 			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+			int total = _decompress_block(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize);
 			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
 			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			read_pos = 0;
@@ -302,34 +345,121 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t done = 0;
+	while (true) {
+		uint64_t chunk = MIN(p_length - done, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + done, read_ptr + read_pos, chunk);
+		done += chunk;
+		read_pos += chunk;
+		if (read_pos < read_block_size) {
+			break;
+		}
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
-				}
-				return i + 1;
+		if (read_block + 1 >= read_block_count) {
+			at_end = true;
+			if (done < p_length) {
+				read_eof = true;
 			}
+			return done;
+		}
+
+		// Whole blocks covered by the rest of the read are decompressed in parallel, straight into the destination.
+		uint32_t whole_blocks = 0;
+		uint64_t whole_size = 0;
+		for (uint32_t i = read_block + 1; i < read_block_count; i++) {
+			uint32_t bs = _get_block_size(i);
+			if (whole_size + bs > p_length - done) {
+				break;
+			}
+			whole_size += bs;
+			whole_blocks++;
+		}
+
+		// Waiting for a group task doesn't help running it, so reads made from a worker thread (e.g. threaded
+		// resource loads) stay serial rather than risk blocking every thread of the pool.
+		if (whole_blocks >= PARALLEL_READ_MIN_BLOCKS && WorkerThreadPool::get_thread_index() == -1) {
+			uint64_t read = _read_blocks_parallel(read_block + 1, whole_blocks, p_dst + done);
+			ERR_FAIL_COND_V_MSG(read != whole_size, -1, "Compressed file is corrupt.");
+			done += read;
+			continue; // The last block is now current, and fully read.
+		}
+
+		//read another block of compressed data
+		read_block++;
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
+		int ret = _decompress_block(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize);
+		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
+		read_block_size = _get_block_size(read_block);
+		read_pos = 0;
+
+		if (done == p_length) {
+			break;
 		}
 	}
 
 	return p_length;
 }
 
+bool FileAccessCompressed::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), false, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(writing, false, "File has not been opened in read mode.");
+
+	if (p_offset >= read_total || p_length == 0) {
+		return true;
+	}
+	p_length = MIN(p_length, read_total - p_offset);
+
+	// Only hint the compressed blocks holding the range, decompressing them is left to the reads.
+	const ReadBlock &first = read_blocks[p_offset / block_size];
+	const ReadBlock &last = read_blocks[(p_offset + p_length - 1) / block_size];
+	return f->prefetch(first.offset, last.offset + last.csize - first.offset);
+}
+
+void FileAccessCompressed::_decompress_block_task(uint32_t p_index, BulkRead *p_read) const {
+	uint32_t block = p_read->first_block + p_index;
+	uint32_t size = _get_block_size(block);
+	int ret = _decompress_block(p_read->dst + (uint64_t)p_index * block_size, size, p_read->src + p_read->src_offsets[p_index], read_blocks[block].csize);
+	if (ret != (int)size) {
+		p_read->failed.set();
+	}
+}
+
+uint64_t FileAccessCompressed::_read_blocks_parallel(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const {
+	// Compressed blocks are stored back to back, so they can be read in one go.
+	uint64_t src_size = 0;
+	BulkRead bulk;
+	bulk.first_block = p_first_block;
+	bulk.dst = p_dst;
+	bulk.src_offsets.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		bulk.src_offsets[i] = src_size;
+		src_size += read_blocks[p_first_block + i].csize;
+	}
+
+	Vector<uint8_t> src;
+	src.resize(src_size);
+	f->seek(read_blocks[p_first_block].offset);
+	if (f->get_buffer(src.ptrw(), src_size) != src_size) {
+		return 0;
+	}
+	bulk.src = src.ptr();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessCompressed::_decompress_block_task, &bulk, p_count, -1, true, SNAME("FileAccessCompressedRead"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (bulk.failed.is_set()) {
+		return 0;
+	}
+
+	// Leave the last block as the current one, as if it was read sequentially.
+	uint32_t last = p_first_block + p_count - 1;
+	read_block = last;
+	read_block_size = _get_block_size(last);
+	memcpy(buffer.ptrw(), p_dst + (uint64_t)(p_count - 1) * block_size, read_block_size);
+	read_pos = read_block_size;
+
+	return (uint64_t)(p_count - 1) * block_size + read_block_size;
+}
+
 Error FileAccessCompressed::get_error() const {
 	return read_eof ? ERR_FILE_EOF : OK;
 }
@@ -33,6 +33,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
@@ -63,10 +65,32 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	const Compression::ZstdDictionary *dictionary = nullptr;
+
+	struct BulkRead {
+		uint32_t first_block = 0;
+		const uint8_t *src = nullptr;
+		LocalVector<uint64_t> src_offsets;
+		uint8_t *dst = nullptr;
+		SafeFlag failed;
+	};
+
+	static int _compress_block(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Compression::Mode p_mode, const Compression::ZstdDictionary *p_dictionary);
+	int _decompress_block(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const;
+	uint32_t _get_block_size(uint32_t p_block) const;
+	uint64_t _read_blocks_parallel(uint32_t p_first_block, uint32_t p_count, uint8_t *p_dst) const;
+	void _decompress_block_task(uint32_t p_index, BulkRead *p_read) const;
+
 	void _close();
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	// Zstandard dictionary used for every block. Must be set before opening, match the one used to write,
+	// and outlive the file.
+	void set_dictionary(const Compression::ZstdDictionary *p_dictionary);
+
+	// Compresses a whole buffer into the format written by this class, so it can be produced off-thread.
+	static Error compress_buffer(const uint8_t *p_src, uint64_t p_length, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, const Compression::ZstdDictionary *p_dictionary, Vector<uint8_t> &r_dst);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
@@ -85,6 +109,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
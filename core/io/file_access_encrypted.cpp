@@ -31,6 +31,7 @@
 #include "file_access_encrypted.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/marshalls.h"
 #include "core/string/print_string.h"
 #include "core/variant/variant.h"
 
@@ -115,46 +116,62 @@ Error FileAccessEncrypted::open_internal(const String &p_path, int p_mode_flags)
 	return OK;
 }
 
-void FileAccessEncrypted::_close() {
-	if (file.is_null()) {
-		return;
+uint64_t FileAccessEncrypted::get_encrypted_size(uint64_t p_length) {
+	uint64_t len = p_length;
+	if (len % 16) { // Pad to encryption block size.
+		len += 16 - (len % 16);
 	}
+	return 16 + 8 + 16 + len; // MD5 hash, data size, IV, data.
+}
 
-	if (writing) {
-		Vector<uint8_t> compressed;
-		uint64_t len = data.size();
-		if (len % 16) {
-			len += 16 - (len % 16);
-		}
-
-		unsigned char hash[16];
-		ERR_FAIL_COND(CryptoCore::md5(data.ptr(), data.size(), hash) != OK); // Bug?
+Error FileAccessEncrypted::encrypt_buffer(const uint8_t *p_src, uint64_t p_length, const Vector<uint8_t> &p_key, const uint8_t p_iv[16], uint8_t *r_dst) {
+	ERR_FAIL_COND_V(p_key.size() != 32, ERR_INVALID_PARAMETER);
 
-		compressed.resize(len);
-		memset(compressed.ptrw(), 0, len);
-		for (int i = 0; i < data.size(); i++) {
-			compressed.write[i] = data[i];
-		}
+	unsigned char hash[16];
+	Error err = CryptoCore::md5(p_src, p_length, hash);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	memcpy(r_dst, hash, 16);
+	r_dst += 16;
+	encode_uint64(p_length, r_dst);
+	r_dst += 8;
+	memcpy(r_dst, p_iv, 16);
+	r_dst += 16;
+
+	uint64_t len = get_encrypted_size(p_length) - 40;
+	memset(r_dst, 0, len);
+	if (p_length) {
+		memcpy(r_dst, p_src, p_length);
+	}
 
-		CryptoCore::AESContext ctx;
-		ctx.set_encode_key(key.ptrw(), 256);
+	uint8_t iv[16];
+	memcpy(iv, p_iv, 16);
 
-		if (use_magic) {
-			file->store_32(ENCRYPTED_HEADER_MAGIC);
-		}
+	CryptoCore::AESContext ctx;
+	ctx.set_encode_key(p_key.ptr(), 256);
+	return ctx.encrypt_cfb(len, iv, r_dst, r_dst);
+}
 
-		file->store_buffer(hash, 16);
-		file->store_64(data.size());
+void FileAccessEncrypted::_close() {
+	if (file.is_null()) {
+		return;
+	}
 
+	if (writing) {
 		unsigned char iv[16];
 		for (int i = 0; i < 16; i++) {
 			iv[i] = Math::rand() % 256;
-			file->store_8(iv[i]);
 		}
 
-		ctx.encrypt_cfb(len, iv, compressed.ptrw(), compressed.ptrw());
+		Vector<uint8_t> encrypted;
+		encrypted.resize(get_encrypted_size(data.size()));
+		ERR_FAIL_COND(encrypt_buffer(data.ptr(), data.size(), key, iv, encrypted.ptrw()) != OK);
 
-		file->store_buffer(compressed.ptr(), compressed.size());
+		if (use_magic) {
+			file->store_32(ENCRYPTED_HEADER_MAGIC);
+		}
+
+		file->store_buffer(encrypted.ptr(), encrypted.size());
 		data.clear();
 	}
 
@@ -234,6 +251,19 @@ uint64_t FileAccessEncrypted::get_buffer(uint8_t *p_dst, uint64_t p_length) cons
 	return to_copy;
 }
 
+const uint8_t *FileAccessEncrypted::get_mapped_range(uint64_t p_offset, uint64_t p_length) const {
+	if (writing) {
+		return nullptr;
+	}
+
+	// The whole file is decrypted in memory when opened for reading.
+	uint64_t len = get_length();
+	if (p_offset > len || p_length > len - p_offset) {
+		return nullptr;
+	}
+	return data.ptr() + p_offset;
+}
+
 Error FileAccessEncrypted::get_error() const {
 	return eofed ? ERR_FILE_EOF : OK;
 }
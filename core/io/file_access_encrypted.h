@@ -60,6 +60,11 @@ public:
 	Error open_and_parse(Ref<FileAccess> p_base, const Vector<uint8_t> &p_key, Mode p_mode, bool p_with_magic = true);
 	Error open_and_parse_password(Ref<FileAccess> p_base, const String &p_key, Mode p_mode);
 
+	// Encrypts a whole buffer into the layout written by MODE_WRITE_AES256 (without magic).
+	// Thread-safe; r_dst must hold get_encrypted_size(p_length) bytes.
+	static uint64_t get_encrypted_size(uint64_t p_length);
+	static Error encrypt_buffer(const uint8_t *p_src, uint64_t p_length, const Vector<uint8_t> &p_key, const uint8_t p_iv[16], uint8_t *r_dst);
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -75,6 +80,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
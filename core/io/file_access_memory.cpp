@@ -149,6 +149,15 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessMemory::get_mapped_range(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V(data, nullptr);
+
+	if (p_offset > length || p_length > length - p_offset) {
+		return nullptr;
+	}
+	return &data[p_offset];
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
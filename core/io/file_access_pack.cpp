@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, const uint8_t *p_mapped_pack, bool p_compressed, const Compression::ZstdDictionary *p_dictionary) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -62,6 +63,11 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.mapped_pack = p_mapped_pack;
+	pf.compressed = p_compressed;
+	if (p_compressed) {
+		pf.dictionary = p_dictionary;
+	}
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
@@ -118,10 +124,24 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+void PackedData::clear() {
+	files.clear();
+	_free_packed_dirs(root);
+	root = memnew(PackedDir);
+	mapped_packs.clear();
+	for (int i = 0; i < dictionaries.size(); i++) {
+		memdelete(dictionaries[i]);
+	}
+	dictionaries.clear();
+}
+
 PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (int i = 0; i < dictionaries.size(); i++) {
+		memdelete(dictionaries[i]);
+	}
 	_free_packed_dirs(root);
 }
 
@@ -201,7 +221,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_UNCOMPRESSED, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -209,13 +229,40 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
-	for (int i = 0; i < 16; i++) {
+	// Zstandard dictionary shared by compressed files, stored with the file data.
+	uint64_t dictionary_ofs = f->get_64();
+	uint32_t dictionary_size = f->get_32();
+
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->get_32();
 	}
 
 	int file_count = f->get_32();
 
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION && dictionary_size > 0, false, "Pack version " + itos(version) + " can't hold compressed files.");
+
+	// Digested once here, rather than for every block of every file that uses it.
+	const Compression::ZstdDictionary *dictionary = nullptr;
+	if (dictionary_size > 0) {
+		uint64_t index_ofs = f->get_position();
+		Vector<uint8_t> dictionary_data;
+		dictionary_data.resize(dictionary_size);
+		f->seek(file_base + dictionary_ofs + p_offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(dictionary_data.ptrw(), dictionary_size) != dictionary_size, false, "Can't read pack compression dictionary.");
+		f->seek(index_ofs);
+
+		Compression::ZstdDictionary *zstd_dictionary = memnew(Compression::ZstdDictionary(dictionary_data, false, true));
+		PackedData::get_singleton()->dictionaries.push_back(zstd_dictionary);
+		dictionary = zstd_dictionary;
+	}
+
+	// Map the whole pack once, so files in it don't each need their own handle and read copy.
+	const uint8_t *mapped_pack = f->get_mapped_range(0, f->get_length());
+	if (mapped_pack) {
+		PackedData::get_singleton()->mapped_packs.push_back(f);
+	}
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -247,8 +294,9 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION && (flags & PACK_FILE_COMPRESSED), false, "Pack version " + itos(version) + " can't hold compressed files.");
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), mapped_pack, (flags & PACK_FILE_COMPRESSED), dictionary);
 	}
 
 	return true;
@@ -266,7 +314,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -274,7 +324,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -282,7 +332,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -303,18 +355,22 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (mapped) {
+		return mapped[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -332,16 +388,58 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
+
+	if (mapped) {
+		memcpy(p_dst, mapped + pos - to_read, to_read);
+		return to_read;
+	}
 	f->get_buffer(p_dst, to_read);
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_range(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), nullptr, "File must be opened before use.");
+
+	if (p_offset > pf.size || p_length > pf.size - p_offset) {
+		return nullptr;
+	}
+
+	if (mapped) {
+		return mapped + p_offset;
+	}
+	return f->get_mapped_range(off + p_offset, p_length);
+}
+
+bool FileAccessPack::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), false, "File must be opened before use.");
+
+	if (p_offset >= pf.size) {
+		return true;
+	}
+	p_length = MIN(p_length, pf.size - p_offset);
+
+	if (mapped) {
+		// Touching a byte per page is enough to have it faulted in.
+		const uint64_t PAGE_SIZE = 4096;
+		volatile uint8_t sink = 0;
+		for (uint64_t i = 0; i < p_length; i += PAGE_SIZE) {
+			sink ^= mapped[p_offset + i];
+		}
+		(void)sink;
+		return true;
+	}
+	// Compressed files only hint the compressed blocks holding the range.
+	return f->prefetch(off + p_offset, p_length);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -369,15 +467,25 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (pf.mapped_pack && !pf.encrypted && !pf.compressed) {
+		// A view into the mapping of the pack, nothing to open.
+		mapped = pf.mapped_pack + pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -395,8 +503,22 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
+
+	if (pf.compressed) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure(PACK_COMPRESSED_MAGIC);
+		fac->set_dictionary(pf.dictionary);
+
+		uint8_t magic[4];
+		f->get_buffer(magic, 4);
+		ERR_FAIL_COND_MSG(memcmp(magic, PACK_COMPRESSED_MAGIC, 4) != 0, "Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+
+		Error err = fac->open_after_magic(f);
+		ERR_FAIL_COND_MSG(err, "Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+		f = fac;
+		off = 0;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/string/print_string.h"
@@ -41,22 +42,35 @@
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION 3
+// Packs without compressed files are still written with the previous version. Their layout didn't change,
+// so older engines can keep reading them.
+#define PACK_FORMAT_VERSION_UNCOMPRESSED 2
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1, // Stored in the FileAccessCompressed format (block index + Zstandard blocks).
 };
 
+// Magic of compressed files stored in packs.
+#define PACK_COMPRESSED_MAGIC "GCPK"
+// Compressed files are split in blocks of this size, so they can be read from any position.
+#define PACK_COMPRESSION_BLOCK_SIZE 65536
+// Files up to this size contribute their leading bytes to the compression dictionary of the pack.
+#define PACK_DICTIONARY_SAMPLE_FILE_MAX 16384
+#define PACK_DICTIONARY_SAMPLE_SIZE 4096
+
 class PackSource;
 
 class PackedData {
 	friend class FileAccessPack;
 	friend class DirAccessPack;
 	friend class PackSource;
+	friend class PackedSourcePCK;
 
 public:
 	struct PackedFile {
@@ -66,6 +80,9 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
+		const Compression::ZstdDictionary *dictionary = nullptr; // Shared by the compressed files of the pack, owned by PackedData.
+		const uint8_t *mapped_pack = nullptr; // Start of the read-only mapping of the whole pack, if any.
 	};
 
 private:
@@ -100,6 +117,11 @@ private:
 
 	Vector<PackSource *> sources;
 
+	// Packs that could be memory mapped, kept open so their files can be read straight from the mapping.
+	Vector<Ref<FileAccess>> mapped_packs;
+
+	Vector<Compression::ZstdDictionary *> dictionaries;
+
 	PackedDir *root = nullptr;
 
 	static PackedData *singleton;
@@ -109,13 +131,14 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, const uint8_t *p_mapped_pack = nullptr, bool p_compressed = false, const Compression::ZstdDictionary *p_dictionary = nullptr); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	void clear();
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
@@ -147,6 +170,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	const uint8_t *mapped = nullptr; // Contents of this file, when the pack is memory mapped.
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -171,6 +195,8 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_offset, uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
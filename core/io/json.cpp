@@ -32,6 +32,8 @@
 
 #include "core/config/engine.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant_internal.h"
 
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
@@ -46,12 +48,31 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	return p_indent.repeat(p_size);
+void JSON::StringifyOutput::append(const String &p_string) {
+	text += p_string;
+	if (file.is_valid() && text.length() >= FLUSH_SIZE) {
+		flush();
+	}
+}
+
+void JSON::StringifyOutput::flush() {
+	if (file.is_valid() && !text.is_empty()) {
+		file->store_string(text);
+		text = String();
+	}
+}
+
+void JSON::_append_indent(StringifyOutput &r_out, const String &p_indent, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		r_out.append(p_indent);
+	}
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	ERR_FAIL_COND_V_MSG(p_cur_indent > Variant::MAX_RECURSION_DEPTH, "...", "JSON structure is too deep. Bailing.");
+void JSON::_stringify(StringifyOutput &r_out, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		r_out.append("...");
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
+	}
 
 	String colon = ":";
 	String end_statement = "";
@@ -63,21 +84,25 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 
 	switch (p_var.get_type()) {
 		case Variant::NIL:
-			return "null";
+			r_out.append("null");
+			return;
 		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
+			r_out.append(p_var.operator bool() ? "true" : "false");
+			return;
 		case Variant::INT:
-			return itos(p_var);
+			r_out.append(itos(p_var));
+			return;
 		case Variant::FLOAT: {
 			double num = p_var;
 			if (p_full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				r_out.append(String::num(num, 17 - (int)floor(log10(num))));
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				r_out.append(String::num(num, 14 - (int)floor(log10(num))));
 			}
+			return;
 		}
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
@@ -87,33 +112,44 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 		case Variant::ARRAY: {
 			Array a = p_var;
 			if (a.size() == 0) {
-				return "[]";
+				r_out.append("[]");
+				return;
 			}
-			String s = "[";
-			s += end_statement;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
+			if (p_markers.has(a.id())) {
+				r_out.append("\"[...]\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(a.id());
 
+			r_out.append("[");
+			r_out.append(end_statement);
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_out.append(",");
+					r_out.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_stringify(r_out, a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
+			r_out.append(end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			r_out.append("]");
 			p_markers.erase(a.id());
-			return s;
+			return;
 		}
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
+			if (p_markers.has(d.id())) {
+				r_out.append("\"{...}\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(d.id());
 
+			r_out.append("{");
+			r_out.append(end_statement);
+
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
@@ -126,24 +162,235 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					r_out.append(",");
+					r_out.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_stringify(r_out, String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				r_out.append(colon);
+				_stringify(r_out, d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
+			r_out.append(end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			r_out.append("}");
 			p_markers.erase(d.id());
-			return s;
+			return;
 		}
 		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			r_out.append("\"" + String(p_var).json_escape() + "\"");
+			return;
+	}
+}
+
+// Sources the tokenizer reads characters from. Reading past the end gives 0, which the tokenizer treats as the end of the text.
+// release() tells a source that the characters before an index won't be read again.
+
+struct JSONStringSource {
+	const char32_t *str = nullptr;
+	int len = 0;
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) const { return p_index < len ? str[p_index] : 0; }
+	_FORCE_INLINE_ void release(int p_index) {}
+
+	// Appends a run of characters with no escapes in them to a string being tokenized.
+	_FORCE_INLINE_ void append_run(String &r_str, int p_from, int p_len) const { r_str += String(str + p_from, p_len); }
+};
+
+struct JSONUTF8Source {
+	const uint8_t *str = nullptr;
+	int len = 0;
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) const { return p_index < len ? str[p_index] : 0; }
+	_FORCE_INLINE_ void release(int p_index) {}
+	_FORCE_INLINE_ void append_run(String &r_str, int p_from, int p_len) const { r_str += String::utf8((const char *)str + p_from, p_len); }
+};
+
+// Reads UTF-8 text in chunks, only keeping what the token being read still needs.
+template <typename R>
+struct JSONChunkedSource {
+	static const int CHUNK_SIZE = 65536;
+
+	R reader;
+	LocalVector<uint8_t> window;
+	int window_start = 0; // Index of the first byte in the window.
+	int len = 0;
+
+	void fill(int p_offset) {
+		while ((int)window.size() <= p_offset) {
+			uint32_t size = window.size();
+			window.resize(size + CHUNK_SIZE);
+			uint64_t read = reader.read(window.ptr() + size, CHUNK_SIZE);
+			window.resize(size + read);
+			if (read == 0) {
+				break;
+			}
+		}
+	}
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) {
+		int offset = p_index - window_start;
+		if (unlikely(offset >= (int)window.size())) {
+			if (p_index >= len) {
+				return 0;
+			}
+			fill(offset);
+			if (offset >= (int)window.size()) {
+				return 0;
+			}
+		}
+		return window[offset];
+	}
+
+	void release(int p_index) {
+		int offset = p_index - window_start;
+		if (offset >= CHUNK_SIZE && offset <= (int)window.size()) {
+			memmove(window.ptr(), window.ptr() + offset, window.size() - offset);
+			window.resize(window.size() - offset);
+			window_start = p_index;
+		}
+	}
+
+	_FORCE_INLINE_ void append_run(String &r_str, int p_from, int p_len) const { r_str += String::utf8((const char *)window.ptr() + p_from - window_start, p_len); }
+
+	JSONChunkedSource(const R &p_reader, int p_len) {
+		reader = p_reader;
+		len = p_len;
+		fill(2);
+		if (window.size() >= 3 && window[0] == 0xEF && window[1] == 0xBB && window[2] == 0xBF) {
+			// Skip BOM.
+			memmove(window.ptr(), window.ptr() + 3, window.size() - 3);
+			window.resize(window.size() - 3);
+			len -= 3;
+		}
+	}
+};
+
+struct JSONFileReader {
+	Ref<FileAccess> file;
+
+	uint64_t read(uint8_t *p_dst, uint64_t p_size) { return file->get_buffer(p_dst, p_size); }
+};
+
+struct JSONStreamReader {
+	Ref<StreamPeer> stream;
+	int left = 0; // Bytes of the text not read yet, nothing past them is consumed from the stream.
+
+	uint64_t read(uint8_t *p_dst, uint64_t p_size) {
+		int size = MIN((int)p_size, left);
+		if (size <= 0 || stream->get_data(p_dst, size) != OK) {
+			return 0;
+		}
+		left -= size;
+		return size;
+	}
+
+	// Consumes the rest of the text when parsing stopped early, so the stream is left right after it.
+	void skip_rest() {
+		uint8_t buf[4096];
+		while (read(buf, sizeof(buf)) > 0) {
+		}
+	}
+};
+
+typedef JSONChunkedSource<JSONFileReader> JSONFileSource;
+typedef JSONChunkedSource<JSONStreamReader> JSONStreamSource;
+
+// Builds the Variant holding the parsed contents, containers are added to their parent once complete.
+struct JSONVariantSink {
+	LocalVector<Variant> containers; // Array or Dictionary being filled.
+	LocalVector<String> keys; // Key of the value being parsed, for each Dictionary in containers.
+	Variant result;
+	bool complete = false;
+
+	_FORCE_INLINE_ void begin_object() {
+		containers.push_back(Dictionary());
+		keys.push_back(String());
+	}
+
+	_FORCE_INLINE_ void key(const String &p_key) {
+		keys[keys.size() - 1] = p_key;
+	}
+
+	_FORCE_INLINE_ void end_object() {
+		keys.resize(keys.size() - 1);
+		_end_container();
+	}
+
+	_FORCE_INLINE_ void begin_array() {
+		containers.push_back(Array());
+	}
+
+	_FORCE_INLINE_ void end_array() {
+		_end_container();
+	}
+
+	_FORCE_INLINE_ void _end_container() {
+		Variant container = containers[containers.size() - 1];
+		containers.resize(containers.size() - 1);
+		value(container);
+	}
+
+	_FORCE_INLINE_ void value(const Variant &p_value) {
+		if (containers.is_empty()) {
+			result = p_value;
+			complete = true;
+			return;
+		}
+		Variant &parent = containers[containers.size() - 1];
+		if (parent.get_type() == Variant::ARRAY) {
+			VariantInternal::get_array(&parent)->push_back(p_value);
+		} else {
+			(*VariantInternal::get_dictionary(&parent))[keys[keys.size() - 1]] = p_value;
+		}
+	}
+};
+
+static _FORCE_INLINE_ bool _is_number_char(char32_t p_char) {
+	return is_digit(p_char) || p_char == '-' || p_char == '+' || p_char == '.' || p_char == 'e' || p_char == 'E';
+}
+
+static _FORCE_INLINE_ double _parse_number(JSONStringSource &p_str, int p_index, int &r_len) {
+	const char32_t *from = p_str.str + p_index;
+	const char32_t *rptr;
+	double number = String::to_float(from, &rptr);
+	r_len = rptr - from;
+	return number;
+}
+
+template <typename T>
+static double _parse_number(T &p_str, int p_index, int &r_len) {
+	// Numbers are ASCII, so widen just the characters that can be part of one and parse them like the UTF-32 text.
+	const int MAX_NUMBER_LENGTH = 128;
+	char32_t number[MAX_NUMBER_LENGTH + 1];
+	int len = 0;
+	while (len < MAX_NUMBER_LENGTH && _is_number_char(p_str[p_index + len])) {
+		number[len] = p_str[p_index + len];
+		len++;
+	}
+	number[len] = 0;
+
+	const char32_t *rptr;
+	if (len < MAX_NUMBER_LENGTH) {
+		double ret = String::to_float(number, &rptr);
+		r_len = rptr - number;
+		return ret;
+	}
+
+	// Unreasonably long, collect all of it.
+	String long_number = number;
+	while (_is_number_char(p_str[p_index + len])) {
+		long_number += p_str[p_index + len];
+		len++;
 	}
+	double ret = String::to_float(long_number.ptr(), &rptr);
+	r_len = rptr - long_number.ptr();
+	return ret;
 }
 
-Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
+template <typename T>
+Error JSON::_get_token(T &p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
+	p_str.release(index);
 	while (p_len > 0) {
 		switch (p_str[index]) {
 			case '\n': {
@@ -189,6 +436,18 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 				index++;
 				String str;
 				while (true) {
+					// Copy runs of characters with nothing to unescape at once.
+					int run_start = index;
+					while (p_str[index] != 0 && p_str[index] != '"' && p_str[index] != '\\') {
+						if (p_str[index] == '\n') {
+							line++;
+						}
+						index++;
+					}
+					if (index > run_start) {
+						p_str.append_run(str, run_start, index - run_start);
+					}
+
 					if (p_str[index] == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
@@ -311,12 +570,6 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 						}
 
 						str += res;
-
-					} else {
-						if (p_str[index] == '\n') {
-							line++;
-						}
-						str += p_str[index];
 					}
 					index++;
 				}
@@ -334,9 +587,9 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 
 				if (p_str[index] == '-' || is_digit(p_str[index])) {
 					//a number
-					const char32_t *rptr;
-					double number = String::to_float(&p_str[index], &rptr);
-					index += (rptr - &p_str[index]);
+					int number_len;
+					double number = _parse_number(p_str, index, number_len);
+					index += number_len;
 					r_token.type = TK_NUMBER;
 					r_token.value = number;
 					return OK;
@@ -363,42 +616,43 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename T, typename S>
+Error JSON::_parse_value(S &p_sink, Token &token, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
 		r_err_str = "JSON structure is too deep. Bailing.";
 		return ERR_OUT_OF_MEMORY;
 	}
 
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
-		Dictionary d;
-		Error err = _parse_object(d, p_str, index, p_len, line, p_depth + 1, r_err_str);
+		p_sink.begin_object();
+		Error err = _parse_object(p_sink, p_str, index, p_len, line, p_depth + 1, r_err_str);
 		if (err) {
 			return err;
 		}
-		value = d;
+		p_sink.end_object();
 	} else if (token.type == TK_BRACKET_OPEN) {
-		Array a;
-		Error err = _parse_array(a, p_str, index, p_len, line, p_depth + 1, r_err_str);
+		p_sink.begin_array();
+		Error err = _parse_array(p_sink, p_str, index, p_len, line, p_depth + 1, r_err_str);
 		if (err) {
 			return err;
 		}
-		value = a;
+		p_sink.end_array();
 	} else if (token.type == TK_IDENTIFIER) {
 		String id = token.value;
 		if (id == "true") {
-			value = true;
+			p_sink.value(true);
 		} else if (id == "false") {
-			value = false;
+			p_sink.value(false);
 		} else if (id == "null") {
-			value = Variant();
+			p_sink.value(Variant());
 		} else {
 			r_err_str = "Expected 'true','false' or 'null', got '" + id + "'.";
 			return ERR_PARSE_ERROR;
 		}
 	} else if (token.type == TK_NUMBER) {
-		value = token.value;
+		p_sink.value(token.value);
 	} else if (token.type == TK_STRING) {
-		value = token.value;
+		p_sink.value(token.value);
 	} else {
 		r_err_str = "Expected value, got " + String(tk_name[token.type]) + ".";
 		return ERR_PARSE_ERROR;
@@ -407,7 +661,8 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 	return OK;
 }
 
-Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename T, typename S>
+Error JSON::_parse_array(S &p_sink, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	Token token;
 	bool need_comma = false;
 
@@ -431,13 +686,11 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 			}
 		}
 
-		Variant v;
-		err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str);
+		err = _parse_value(p_sink, token, p_str, index, p_len, line, p_depth, r_err_str);
 		if (err) {
 			return err;
 		}
 
-		array.push_back(v);
 		need_comma = true;
 	}
 
@@ -445,9 +698,9 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename T, typename S>
+Error JSON::_parse_object(S &p_sink, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	bool at_key = true;
-	String key;
 	Token token;
 	bool need_comma = false;
 
@@ -477,7 +730,7 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 				return ERR_PARSE_ERROR;
 			}
 
-			key = token.value;
+			String key = token.value;
 			err = _get_token(p_str, index, p_len, token, line, r_err_str);
 			if (err != OK) {
 				return err;
@@ -486,6 +739,7 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 				r_err_str = "Expected ':'";
 				return ERR_PARSE_ERROR;
 			}
+			p_sink.key(key);
 			at_key = false;
 		} else {
 			Error err = _get_token(p_str, index, p_len, token, line, r_err_str);
@@ -493,12 +747,10 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 				return err;
 			}
 
-			Variant v;
-			err = _parse_value(v, token, p_str, index, p_len, line, p_depth, r_err_str);
+			err = _parse_value(p_sink, token, p_str, index, p_len, line, p_depth, r_err_str);
 			if (err) {
 				return err;
 			}
-			object[key] = v;
 			need_comma = true;
 			at_key = true;
 		}
@@ -513,20 +765,18 @@ void JSON::set_data(const Variant &p_data) {
 	text.clear();
 }
 
-Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
-	const char32_t *str = p_json.ptr();
+template <typename T, typename S>
+Error JSON::_parse_text(T &str, int len, S &p_sink, String &r_err_str, int &r_err_line) {
 	int idx = 0;
-	int len = p_json.length();
 	Token token;
 	r_err_line = 0;
-	String aux_key;
 
 	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
 	if (err) {
 		return err;
 	}
 
-	err = _parse_value(r_ret, token, str, idx, len, r_err_line, 0, r_err_str);
+	err = _parse_value(p_sink, token, str, idx, len, r_err_line, 0, r_err_str);
 
 	// Check if EOF is reached
 	// or it's a type of the next token.
@@ -535,8 +785,6 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 
 		if (err || token.type != TK_EOF) {
 			r_err_str = "Expected 'EOF'";
-			// Reset return value to empty `Variant`
-			r_ret = Variant();
 			return ERR_PARSE_ERROR;
 		}
 	}
@@ -544,6 +792,24 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 	return err;
 }
 
+template <typename T>
+Error JSON::_parse_data(T &p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONVariantSink sink;
+	Error err = _parse_text(p_str, p_len, sink, r_err_str, r_err_line);
+	if (sink.complete) {
+		// Reset return value to empty `Variant` if something follows the value.
+		r_ret = err == OK ? sink.result : Variant();
+	}
+	return err;
+}
+
+Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONStringSource source;
+	source.str = p_json.ptr();
+	source.len = p_json.length();
+	return _parse_data(source, source.len, r_ret, r_err_str, r_err_line);
+}
+
 Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	Error err = _parse_string(p_json_string, data, err_str, err_line);
 	if (err == Error::OK) {
@@ -555,6 +821,99 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+Error JSON::parse_utf8(const Vector<uint8_t> &p_json_utf8, bool p_keep_text) {
+	JSONUTF8Source source;
+	source.str = p_json_utf8.ptr();
+	source.len = p_json_utf8.size();
+	if (source.len > 0 && source.str[source.len - 1] == 0) {
+		source.len--;
+	}
+	if (source.len >= 3 && source.str[0] == 0xEF && source.str[1] == 0xBB && source.str[2] == 0xBF) {
+		// Skip BOM.
+		source.str += 3;
+		source.len -= 3;
+	}
+
+	Error err = _parse_data(source, source.len, data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	if (p_keep_text) {
+		text = String::utf8((const char *)source.str, source.len);
+	}
+	return err;
+}
+
+Error JSON::parse_file(const Ref<FileAccess> &p_file, bool p_keep_text) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	if (p_keep_text) {
+		// The whole text is kept anyway, so read it at once.
+		Vector<uint8_t> json_utf8;
+		json_utf8.resize(p_file->get_length() - p_file->get_position());
+		json_utf8.resize(p_file->get_buffer(json_utf8.ptrw(), json_utf8.size()));
+		return parse_utf8(json_utf8, true);
+	}
+
+	JSONFileSource source({ p_file }, p_file->get_length() - p_file->get_position());
+	Error err = _parse_data(source, source.len, data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_stream(const Ref<StreamPeer> &p_stream, int p_length) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_length < 0, ERR_INVALID_PARAMETER);
+
+	JSONStreamSource source({ p_stream, p_length }, p_length);
+	Error err = _parse_data(source, source.len, data, err_str, err_line);
+	source.reader.skip_rest();
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_events(const String &p_json_string, EventSink *p_sink) {
+	ERR_FAIL_NULL_V(p_sink, ERR_INVALID_PARAMETER);
+
+	JSONStringSource source;
+	source.str = p_json_string.ptr();
+	source.len = p_json_string.length();
+	Error err = _parse_text(source, source.len, *p_sink, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_file_events(const Ref<FileAccess> &p_file, EventSink *p_sink) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_sink, ERR_INVALID_PARAMETER);
+
+	JSONFileSource source({ p_file }, p_file->get_length() - p_file->get_position());
+	Error err = _parse_text(source, source.len, *p_sink, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_stream_events(const Ref<StreamPeer> &p_stream, int p_length, EventSink *p_sink) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_length < 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_sink, ERR_INVALID_PARAMETER);
+
+	JSONStreamSource source({ p_stream, p_length }, p_length);
+	Error err = _parse_text(source, source.len, *p_sink, err_str, err_line);
+	source.reader.skip_rest();
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
@@ -563,7 +922,18 @@ String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort
 	Ref<JSON> jason;
 	jason.instantiate();
 	HashSet<const void *> markers;
-	return jason->_stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	StringifyOutput out;
+	jason->_stringify(out, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	return out.text;
+}
+
+void JSON::stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	ERR_FAIL_COND(p_file.is_null());
+	HashSet<const void *> markers;
+	StringifyOutput out;
+	out.file = p_file;
+	_stringify(out, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	out.flush();
 }
 
 Variant JSON::parse_string(const String &p_json_string) {
@@ -605,7 +975,14 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	if (file.is_null()) {
+		if (r_error) {
+			*r_error = ERR_FILE_CANT_OPEN;
+		}
+		return Ref<Resource>();
+	}
+	Error err = json->parse_file(file, Engine::get_singleton()->is_editor_hint());
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
@@ -648,14 +1025,16 @@ Error ResourceFormatSaverJSON::save(const Ref<Resource> &p_resource, const Strin
 	Ref<JSON> json = p_resource;
 	ERR_FAIL_COND_V(json.is_null(), ERR_INVALID_PARAMETER);
 
-	String source = json->get_parsed_text().is_empty() ? JSON::stringify(json->get_data(), "\t", false, true) : json->get_parsed_text();
-
 	Error err;
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
 
 	ERR_FAIL_COND_V_MSG(err, err, "Cannot save json '" + p_path + "'.");
 
-	file->store_string(source);
+	if (json->get_parsed_text().is_empty()) {
+		JSON::stringify_to_file(file, json->get_data(), "\t", false, true);
+	} else {
+		file->store_string(json->get_parsed_text());
+	}
 	if (file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
 		return ERR_CANT_CREATE;
 	}
@@ -31,14 +31,32 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/io/stream_peer.h"
 #include "core/variant/variant.h"
 
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+public:
+	// Receives the contents of a JSON text as they are parsed, so large texts can be processed
+	// without building a Variant holding all of them.
+	class EventSink {
+	public:
+		virtual void begin_object() {}
+		virtual void key(const String &p_key) {}
+		virtual void end_object() {}
+		virtual void begin_array() {}
+		virtual void end_array() {}
+		virtual void value(const Variant &p_value) {} // String, float, bool or null.
+
+		virtual ~EventSink() {}
+	};
+
+private:
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -72,12 +90,35 @@ class JSON : public Resource {
 
 	static const char *tk_name[];
 
-	static String _make_indent(const String &p_indent, int p_size);
-	static String _stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
-	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
-	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
-	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
-	static Error _parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
+	// Output of _stringify, built in place instead of concatenating the result of every value.
+	// When a file is set, it's written out in chunks as it grows.
+	struct StringifyOutput {
+		static const int FLUSH_SIZE = 65536;
+
+		String text;
+		Ref<FileAccess> file;
+
+		void append(const String &p_string);
+		void flush();
+	};
+
+	static void _append_indent(StringifyOutput &r_out, const String &p_indent, int p_size);
+	static void _stringify(StringifyOutput &r_out, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
+
+	// The parser reads characters from a source (UTF-32 String, UTF-8 buffer, file or stream, see json.cpp)
+	// and reports what it finds to a sink (an EventSink, or one building a Variant).
+	template <typename T>
+	static Error _get_token(T &p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
+	template <typename T, typename S>
+	static Error _parse_value(S &p_sink, Token &token, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
+	template <typename T, typename S>
+	static Error _parse_array(S &p_sink, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
+	template <typename T, typename S>
+	static Error _parse_object(S &p_sink, T &p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
+	template <typename T, typename S>
+	static Error _parse_text(T &p_str, int p_len, S &p_sink, String &r_err_str, int &r_err_line);
+	template <typename T>
+	static Error _parse_data(T &p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
 	static Error _parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
 
 protected:
@@ -85,9 +126,18 @@ protected:
 
 public:
 	Error parse(const String &p_json_string, bool p_keep_text = false);
+	Error parse_utf8(const Vector<uint8_t> &p_json_utf8, bool p_keep_text = false); // Parses UTF-8 text as is, without decoding it to a String first.
+	Error parse_file(const Ref<FileAccess> &p_file, bool p_keep_text = false); // Parses UTF-8 text from the current position to the end, reading it in chunks.
+	Error parse_stream(const Ref<StreamPeer> &p_stream, int p_length); // Parses the next p_length bytes of UTF-8 text, reading them in chunks.
 	String get_parsed_text() const;
 
+	// Report the parsed contents to a sink instead of setting the data.
+	Error parse_events(const String &p_json_string, EventSink *p_sink);
+	Error parse_file_events(const Ref<FileAccess> &p_file, EventSink *p_sink);
+	Error parse_stream_events(const Ref<StreamPeer> &p_stream, int p_length, EventSink *p_sink);
+
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	static void stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
 	inline Variant get_data() const { return data; }
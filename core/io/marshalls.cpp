@@ -790,10 +790,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -820,9 +817,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(int32_t)); // Same layout as the encoded data, no need to decode one by one.
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -844,9 +845,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(int64_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -868,9 +873,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(float));
+#endif
 			}
 			r_variant = data;
 
@@ -892,9 +901,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			if (count) {
 				data.resize(count);
 				double *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(double));
+#endif
 			}
 			r_variant = data;
 
@@ -910,19 +923,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<String> strings;
 			buf += 4;
 			len -= 4;
+			ERR_FAIL_COND_V(count < 0 || count > len / 4, ERR_INVALID_DATA); // Each string takes at least 4 bytes.
 
 			if (r_len) {
 				(*r_len) += 4; // Size of count number.
 			}
 
+			strings.resize(count);
+			String *w = strings.ptrw();
 			for (int32_t i = 0; i < count; i++) {
-				String str;
-				Error err = _decode_string(buf, len, r_len, str);
+				Error err = _decode_string(buf, len, r_len, w[i]);
 				if (err) {
 					return err;
 				}
-
-				strings.push_back(str);
 			}
 
 			r_variant = strings;
@@ -1071,6 +1084,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					// Colors should always be in single-precision.
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -1078,6 +1092,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#else
+				static_assert(sizeof(Color) == 4 * 4);
+				memcpy(w, buf, count * sizeof(Color));
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1822,6 +1840,123 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+// Returns nullptr instead of growing the buffer past p_max_size.
+static _FORCE_INLINE_ uint8_t *_encode_reserve(LocalVector<uint8_t> &r_buffer, uint64_t p_size, uint32_t p_max_size) {
+	uint32_t pos = r_buffer.size();
+	if (unlikely(pos + p_size > p_max_size)) {
+		return nullptr;
+	}
+	r_buffer.resize(pos + p_size);
+	return r_buffer.ptr() + pos;
+}
+
+static Error _encode_string_append(const CharString &p_utf8, uint32_t p_length, LocalVector<uint8_t> &r_buffer, uint32_t p_max_size) {
+	uint32_t pad = (4 - p_length % 4) % 4;
+	uint8_t *buf = _encode_reserve(r_buffer, 4 + uint64_t(p_length) + pad, p_max_size);
+	if (!buf) {
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	encode_uint32(p_length, buf);
+	memcpy(buf + 4, p_utf8.get_data(), MIN(p_length, uint32_t(p_utf8.length() + 1)));
+	memset(buf + 4 + p_length, 0, pad);
+	return OK;
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, uint32_t p_max_size, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	// Strings and containers are written directly, everything else has a cheap size pass,
+	// so it's left to the two pass encoder above.
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			uint8_t *buf = _encode_reserve(r_buffer, 4, p_max_size);
+			if (!buf) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(p_variant.get_type(), buf);
+			CharString utf8 = String(p_variant).utf8();
+			Error err = _encode_string_append(utf8, utf8.length(), r_buffer, p_max_size);
+			if (err != OK) {
+				return err;
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			Vector<String> data = p_variant;
+			uint8_t *buf = _encode_reserve(r_buffer, 8, p_max_size);
+			if (!buf) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(p_variant.get_type(), buf);
+			encode_uint32(data.size(), buf + 4);
+
+			for (const String &E : data) {
+				CharString utf8 = E.utf8();
+				Error err = _encode_string_append(utf8, utf8.length() + 1, r_buffer, p_max_size); // Including the null terminator.
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+			uint8_t *buf = _encode_reserve(r_buffer, 8, p_max_size);
+			if (!buf) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(p_variant.get_type(), buf);
+			encode_uint32(uint32_t(d.size()), buf + 4);
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			for (const Variant &E : keys) {
+				Error err = encode_variant(E, r_buffer, p_full_objects, p_max_size, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+				Variant *v = d.getptr(E);
+				ERR_FAIL_NULL_V(v, ERR_BUG);
+				err = encode_variant(*v, r_buffer, p_full_objects, p_max_size, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array v = p_variant;
+			uint8_t *buf = _encode_reserve(r_buffer, 8, p_max_size);
+			if (!buf) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(p_variant.get_type(), buf);
+			encode_uint32(uint32_t(v.size()), buf + 4);
+
+			for (int i = 0; i < v.size(); i++) {
+				Error err = encode_variant(v.get(i), r_buffer, p_full_objects, p_max_size, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		default: {
+			int len;
+			Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+			// The size is known before anything is written, so oversized packed arrays are rejected without being copied.
+			uint8_t *buf = _encode_reserve(r_buffer, len, p_max_size);
+			if (!buf) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			err = encode_variant(p_variant, buf, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+		}
+	}
+
+	return OK;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
@@ -53,7 +53,7 @@ class PacketPeer : public RefCounted {
 	mutable Error last_get_error = OK;
 
 	int encode_buffer_max_size = 8 * 1024 * 1024;
-	Vector<uint8_t> encode_buffer;
+	LocalVector<uint8_t> encode_buffer;
 
 public:
 	virtual int get_available_packet_count() const = 0;
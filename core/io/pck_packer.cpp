@@ -32,11 +32,18 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
-static int _get_pad(int p_alignment, int p_n) {
+// Amount of file data read (and encrypted) on worker threads before it's written out.
+// Unencrypted files larger than this are streamed from disk instead.
+static const uint64_t PCK_BATCH_MAX = 64 * 1024 * 1024;
+static const uint64_t PCK_READ_BUFFER_SIZE = 65536;
+
+static int _get_pad(int p_alignment, uint64_t p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
 	if (rest > 0) {
@@ -50,6 +57,11 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_compression_dictionary_size", "size"), &PCKPacker::set_compression_dictionary_size);
+	ClassDB::bind_method(D_METHOD("get_compression_dictionary_size"), &PCKPacker::get_compression_dictionary_size);
 }
 
 Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -89,7 +101,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(PACK_FORMAT_VERSION_UNCOMPRESSED); // Raised in flush() if files end up compressed.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -101,7 +113,6 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
 
 	return OK;
 }
@@ -119,51 +130,114 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	// symbols in them still match to the MD5 hash for the saved path.
 	pf.path = p_file.simplify_path();
 	pf.src_path = p_src;
-	pf.ofs = ofs;
 	pf.size = f->get_length();
+	pf.encrypted = p_encrypt;
+	pf.compressed = compression_enabled && pf.size <= UINT32_MAX; // Limit of the compressed format.
 
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_src);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
-		}
+	// Hashing and data offsets are resolved in flush().
+	files.push_back(pf);
+
+	return OK;
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_compression_dictionary_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	compression_dictionary_size = p_size;
+}
+
+int PCKPacker::get_compression_dictionary_size() const {
+	return compression_dictionary_size;
+}
+
+void PCKPacker::_hash_file(uint32_t p_index, File *p_files) {
+	File &pf = p_files[p_index];
+
+	Ref<FileAccess> f = FileAccess::open(pf.src_path, FileAccess::READ);
+	if (f.is_null()) {
+		pf.error = ERR_FILE_CANT_OPEN;
+		return;
 	}
-	pf.encrypted = p_encrypt;
 
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
+	LocalVector<uint8_t> buf;
+	buf.resize(MIN(pf.size, PCK_READ_BUFFER_SIZE));
+
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+	CryptoCore::SHA256Context sha256_ctx;
+	sha256_ctx.start();
+	uint64_t to_read = pf.size;
+	while (to_read > 0) {
+		uint64_t read = f->get_buffer(buf.ptr(), MIN(to_read, PCK_READ_BUFFER_SIZE));
+		if (read == 0) {
+			pf.error = ERR_FILE_CORRUPT;
+			return;
+		}
+		if (to_read == pf.size && pf.compressed && compression_dictionary_size > 0 && pf.size <= PACK_DICTIONARY_SAMPLE_FILE_MAX) {
+			pf.sample.resize(MIN(read, PACK_DICTIONARY_SAMPLE_SIZE));
+			memcpy(pf.sample.ptrw(), buf.ptr(), pf.sample.size());
 		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
+		ctx.update(buf.ptr(), read);
+		sha256_ctx.update(buf.ptr(), read);
+		to_read -= read;
 	}
 
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
+	pf.md5.resize(16);
+	ctx.finish(pf.md5.ptrw());
+	pf.sha256.resize(32);
+	sha256_ctx.finish(pf.sha256.ptrw());
+}
 
-	files.push_back(pf);
+void PCKPacker::_prepare_data(uint32_t p_index, StoredData *p_stored) {
+	StoredData &sd = p_stored[p_index];
+	if (sd.streamed) {
+		return;
+	}
 
-	return OK;
-}
+	const File &pf = files[sd.file];
+	Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+	if (src.is_null()) {
+		sd.error = ERR_FILE_CANT_OPEN;
+		return;
+	}
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+	Vector<uint8_t> data;
+	data.resize(pf.size);
+	if (src->get_buffer(data.ptrw(), pf.size) != pf.size) {
+		sd.error = ERR_FILE_CORRUPT;
+		return;
+	}
 
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
+	if (pf.compressed) {
+		Vector<uint8_t> compressed;
+		sd.error = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSION_BLOCK_SIZE, zstd_dictionary, compressed);
+		if (sd.error != OK) {
+			return;
+		}
+		// Files that don't get smaller are stored as they are.
+		if (compressed.size() < data.size()) {
+			data = compressed;
+			sd.compressed = true;
+		}
+	}
 
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
+	if (!pf.encrypted) {
+		sd.data = data;
+		return;
 	}
 
-	// write the index
-	file->store_32(files.size());
+	sd.data.resize(FileAccessEncrypted::get_encrypted_size(data.size()));
+	sd.error = FileAccessEncrypted::encrypt_buffer(data.ptr(), data.size(), key, sd.iv, sd.data.ptrw());
+}
 
+Error PCKPacker::_write_index() {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -195,6 +269,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -203,6 +280,70 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	// Hash every file on worker threads.
+	if (!files.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_hash_file, files.ptrw(), files.size(), -1, true, SNAME("PCKPackerHash"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// Files with identical contents share a single stored copy.
+	HashMap<String, int> stored_by_content;
+	Vector<int> stored_files;
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < files.size(); i++) {
+		File &pf = files.write[i];
+		ERR_FAIL_COND_V_MSG(pf.error != OK, pf.error, "Can't read file: " + pf.src_path + ".");
+
+		String content_key = String::hex_encode_buffer(pf.sha256.ptr(), 32) + ":" + itos(pf.size) + (pf.encrypted ? ":e" : "") + (pf.compressed ? ":c" : "");
+		HashMap<String, int>::Iterator E = stored_by_content.find(content_key);
+		if (E) {
+			pf.data_file = E->value;
+			continue;
+		}
+
+		pf.data_file = i;
+		stored_by_content.insert(content_key, i);
+		stored_files.push_back(i);
+		if (!pf.sample.is_empty()) {
+			samples.push_back(pf.sample);
+		}
+	}
+
+	// Small compressed files share a dictionary built from their contents.
+	dictionary.clear();
+	if (zstd_dictionary) {
+		memdelete(zstd_dictionary);
+		zstd_dictionary = nullptr;
+	}
+	if (samples.size() > 1) {
+		dictionary = Compression::build_zstd_dictionary(samples, compression_dictionary_size);
+	}
+	if (!dictionary.is_empty()) {
+		zstd_dictionary = memnew(Compression::ZstdDictionary(dictionary, true, false));
+	}
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+
+	file->store_64(0); // dictionary offset
+	file->store_32(dictionary.size()); // dictionary size
+	for (int i = 0; i < 13; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	// Offsets and compression flags are only known once the data is stored, so it's rewritten then.
+	file->store_32(files.size());
+	int64_t index_ofs = file->get_position();
+	Error err = _write_index();
+	ERR_FAIL_COND_V(err != OK, err);
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(0);
@@ -213,49 +354,113 @@ Error PCKPacker::flush(bool p_verbose) {
 	file->store_64(file_base); // update files base
 	file->seek(file_base);
 
-	const uint32_t buf_max = 65536;
-	uint8_t *buf = memnew_arr(uint8_t, buf_max);
-
-	int count = 0;
-	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
+	if (!dictionary.is_empty()) {
+		file->store_buffer(dictionary); // At offset 0 of the file data.
+		int pad = _get_pad(alignment, file->get_position());
+		for (int i = 0; i < pad; i++) {
+			file->store_8(0);
+		}
+	}
 
-		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
-			fae.instantiate();
-			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+	// Read, compress and encrypt the stored data on worker threads in batches, then write it out in order.
+	LocalVector<uint8_t> buf;
+	LocalVector<StoredData> batch;
+	int stored_count = 0;
+	while (stored_count < stored_files.size()) {
+		batch.clear();
+		uint64_t batch_size = 0;
+		while (stored_count < stored_files.size()) {
+			const File &pf = files[stored_files[stored_count]];
+			if (!batch.is_empty() && batch_size + pf.size > PCK_BATCH_MAX) {
+				break;
+			}
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-			ftmp = fae;
+			StoredData sd;
+			sd.file = stored_files[stored_count];
+			sd.streamed = !pf.encrypted && !pf.compressed && pf.size > PCK_BATCH_MAX;
+			if (pf.encrypted) {
+				// Generated here rather than on the workers, so the output only depends on the random seed.
+				for (int i = 0; i < 16; i++) {
+					sd.iv[i] = Math::rand() % 256;
+				}
+			}
+			batch.push_back(sd);
+			batch_size += pf.size;
+			stored_count++;
 		}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
-		}
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_prepare_data, batch.ptr(), batch.size(), -1, true, SNAME("PCKPackerData"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < batch.size(); i++) {
+			const StoredData &sd = batch[i];
+			File &pf = files.write[sd.file];
+			ERR_FAIL_COND_V_MSG(sd.error != OK, sd.error, "Can't read file: " + pf.src_path + ".");
+
+			pf.ofs = file->get_position() - file_base;
+			pf.compressed = sd.compressed;
+
+			if (sd.streamed) {
+				Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+				ERR_FAIL_COND_V_MSG(src.is_null(), ERR_FILE_CANT_OPEN, "Can't read file: " + pf.src_path + ".");
+
+				buf.resize(PCK_READ_BUFFER_SIZE);
+				uint64_t to_write = pf.size;
+				while (to_write > 0) {
+					uint64_t read = src->get_buffer(buf.ptr(), MIN(to_write, PCK_READ_BUFFER_SIZE));
+					ERR_FAIL_COND_V_MSG(read == 0, ERR_FILE_CORRUPT, "Can't read file: " + pf.src_path + ".");
+					file->store_buffer(buf.ptr(), read);
+					to_write -= read;
+				}
+			} else {
+				file->store_buffer(sd.data.ptr(), sd.data.size());
+			}
 
-		if (fae.is_valid()) {
-			ftmp.unref();
-			fae.unref();
-		}
+			int pad = _get_pad(alignment, file->get_position());
+			for (int j = 0; j < pad; j++) {
+				file->store_8(0);
+			}
 
-		int pad = _get_pad(alignment, file->get_position());
-		for (int j = 0; j < pad; j++) {
-			file->store_8(0);
+			if (p_verbose) {
+				int count = stored_count - batch.size() + i + 1;
+				print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, stored_files.size(), float(count) / stored_files.size() * 100, pf.src_path, pf.path));
+			}
 		}
+	}
 
-		count += 1;
-		const int file_num = files.size();
-		if (p_verbose && (file_num > 0)) {
-			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, file_num, float(count) / file_num * 100, files[i].src_path, files[i].path));
+	for (int i = 0; i < files.size(); i++) {
+		File &pf = files.write[i];
+		if (pf.data_file != i) {
+			pf.ofs = files[pf.data_file].ofs;
+			pf.compressed = files[pf.data_file].compressed;
 		}
 	}
 
+	// Only packs holding compressed files need the newer format version.
+	bool uses_compression = !dictionary.is_empty();
+	for (int i = 0; i < files.size() && !uses_compression; i++) {
+		uses_compression = files[i].compressed;
+	}
+	if (uses_compression) {
+		file->seek(4); // Right after the magic.
+		file->store_32(PACK_FORMAT_VERSION);
+	}
+
+	file->seek(index_ofs);
+	err = _write_index();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	if (p_verbose && stored_files.size() < files.size()) {
+		print_line(vformat("PCKPacker flush: %d files share the data of identical files.", files.size() - stored_files.size()));
+	}
+
 	file.unref();
-	memdelete_arr(buf);
 
 	return OK;
 }
+
+PCKPacker::~PCKPacker() {
+	if (zstd_dictionary) {
+		memdelete(zstd_dictionary);
+	}
+}
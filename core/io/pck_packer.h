@@ -31,6 +31,7 @@
 #ifndef PCK_PACKER_H
 #define PCK_PACKER_H
 
+#include "core/io/compression.h"
 #include "core/object/ref_counted.h"
 
 class FileAccess;
@@ -40,11 +41,15 @@ class PCKPacker : public RefCounted {
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	bool compression_enabled = false;
+	int compression_dictionary_size = 0;
+	Vector<uint8_t> dictionary;
+	Compression::ZstdDictionary *zstd_dictionary = nullptr; // Digested once for all the compressed files.
+
 	static void _bind_methods();
 
 	struct File {
@@ -53,16 +58,40 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
+		Vector<uint8_t> sha256; // Identifies identical contents, MD5 collisions are too easy to craft.
+		Vector<uint8_t> sample; // Leading bytes, to build the compression dictionary from.
+		int data_file = -1; // Index of the file whose stored data this entry shares.
+		Error error = OK;
 	};
 	Vector<File> files;
 
+	struct StoredData {
+		int file = -1;
+		bool streamed = false;
+		uint8_t iv[16] = {};
+		Vector<uint8_t> data;
+		bool compressed = false;
+		Error error = OK;
+	};
+
+	void _hash_file(uint32_t p_index, File *p_files);
+	void _prepare_data(uint32_t p_index, StoredData *p_stored);
+	Error _write_index();
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+	void set_compression_dictionary_size(int p_size);
+	int get_compression_dictionary_size() const;
+
 	PCKPacker() {}
+	~PCKPacker();
 };
 
 #endif // PCK_PACKER_H
@@ -56,32 +56,35 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 		p_take_over = false; // Can't take over an empty path
 	}
 
-	ResourceCache::lock.lock();
-
 	if (!path_cache.is_empty()) {
-		ResourceCache::resources.erase(path_cache);
+		ResourceCache::_remove(path_cache, this);
 	}
 
 	path_cache = "";
 
-	Ref<Resource> existing = ResourceCache::get_ref(p_path);
+	if (!p_path.is_empty()) {
+		ResourceCache::Shard &shard = ResourceCache::_get_shard(p_path);
+		shard.lock.write_lock();
 
-	if (existing.is_valid()) {
-		if (p_take_over) {
-			existing->path_cache = String();
-			ResourceCache::resources.erase(p_path);
-		} else {
-			ResourceCache::lock.unlock();
-			ERR_FAIL_MSG("Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
+		Resource **existing = shard.resources.getptr(p_path);
+		if (existing && (*existing)->get_reference_count() == 0) {
+			// This resource is in the process of being deleted, ignore its existence.
+			// Its destructor may be running on another thread, so its path is left alone. It won't remove the entry once it's no longer its own.
+			existing = nullptr;
 		}
-	}
 
-	path_cache = p_path;
+		if (existing && !p_take_over) {
+			shard.lock.write_unlock();
+			ERR_FAIL_MSG("Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
+		}
+		if (existing) {
+			(*existing)->path_cache = String();
+		}
 
-	if (!path_cache.is_empty()) {
-		ResourceCache::resources[path_cache] = this;
+		path_cache = p_path;
+		shard.resources[path_cache] = this;
+		shard.lock.write_unlock();
 	}
-	ResourceCache::lock.unlock();
 
 	_resource_path_changed();
 }
@@ -467,7 +470,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		return;
 	}
 
-	ResourceCache::lock.lock();
+	ResourceCache::remapped_list_lock.lock();
 
 	if (p_remapped) {
 		ResourceLoader::remapped_list.add(&remapped_list);
@@ -475,7 +478,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		ResourceLoader::remapped_list.remove(&remapped_list);
 	}
 
-	ResourceCache::lock.unlock();
+	ResourceCache::remapped_list_lock.unlock();
 }
 
 #ifdef TOOLS_ENABLED
@@ -540,109 +543,131 @@ Resource::Resource() :
 
 Resource::~Resource() {
 	if (!path_cache.is_empty()) {
-		ResourceCache::lock.lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.unlock();
+		ResourceCache::_remove(path_cache, this);
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
+ResourceCache::Shard ResourceCache::shards[ResourceCache::SHARD_COUNT];
 #ifdef TOOLS_ENABLED
 HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
 
-Mutex ResourceCache::lock;
+Mutex ResourceCache::remapped_list_lock;
 #ifdef TOOLS_ENABLED
 RWLock ResourceCache::path_cache_lock;
 #endif
 
 void ResourceCache::clear() {
-	if (!resources.is_empty()) {
+	int count = get_cached_resource_count();
+	if (count > 0) {
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			ERR_PRINT(vformat("%d resources still in use at exit.", resources.size()));
-			for (const KeyValue<String, Resource *> &E : resources) {
-				print_line(vformat("Resource still in use: %s (%s)", E.key, E.value->get_class()));
+			ERR_PRINT(vformat("%d resources still in use at exit.", count));
+			for (Shard &shard : shards) {
+				for (const KeyValue<String, Resource *> &E : shard.resources) {
+					print_line(vformat("Resource still in use: %s (%s)", E.key, E.value->get_class()));
+				}
 			}
 		} else {
-			ERR_PRINT(vformat("%d resources still in use at exit (run with --verbose for details).", resources.size()));
+			ERR_PRINT(vformat("%d resources still in use at exit (run with --verbose for details).", count));
 		}
 	}
 
-	resources.clear();
+	for (Shard &shard : shards) {
+		shard.resources.clear();
+	}
 }
 
-bool ResourceCache::has(const String &p_path) {
-	lock.lock();
-
-	Resource **res = resources.getptr(p_path);
+void ResourceCache::_remove(const String &p_path, const Resource *p_resource) {
+	Shard &shard = _get_shard(p_path);
+	shard.lock.write_lock();
+	// The entry may already have been dropped while the resource was dying, and the path given to another resource since.
+	Resource **res = shard.resources.getptr(p_path);
+	if (res && *res == p_resource) {
+		shard.resources.erase(p_path);
+	}
+	shard.lock.write_unlock();
+}
 
+void ResourceCache::_erase_if_dying(Shard &p_shard, const String &p_path) {
+	// The resource can't be freed before removing itself from the shard, so if it's still there it's safe to access.
+	// Its path is left alone, as its destructor may be reading it on another thread.
+	p_shard.lock.write_lock();
+	Resource **res = p_shard.resources.getptr(p_path);
 	if (res && (*res)->get_reference_count() == 0) {
-		// This resource is in the process of being deleted, ignore its existence.
-		(*res)->path_cache = String();
-		resources.erase(p_path);
-		res = nullptr;
+		p_shard.resources.erase(p_path);
 	}
+	p_shard.lock.write_unlock();
+}
+
+bool ResourceCache::has(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
 
-	lock.unlock();
+	shard.lock.read_lock();
+	Resource **res = shard.resources.getptr(p_path);
+	bool dying = res && (*res)->get_reference_count() == 0;
+	shard.lock.read_unlock();
 
-	if (!res) {
+	if (dying) {
+		// This resource is in the process of being deleted, ignore its existence.
+		_erase_if_dying(shard, p_path);
 		return false;
 	}
 
-	return true;
+	return res != nullptr;
 }
 
 Ref<Resource> ResourceCache::get_ref(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
 	Ref<Resource> ref;
-	lock.lock();
-
-	Resource **res = resources.getptr(p_path);
 
+	shard.lock.read_lock();
+	Resource **res = shard.resources.getptr(p_path);
 	if (res) {
 		ref = Ref<Resource>(*res);
 	}
+	shard.lock.read_unlock();
 
 	if (res && !ref.is_valid()) {
-		// This resource is in the process of being deleted, ignore its existence
-		(*res)->path_cache = String();
-		resources.erase(p_path);
-		res = nullptr;
+		// This resource is in the process of being deleted, ignore its existence.
+		_erase_if_dying(shard, p_path);
 	}
 
-	lock.unlock();
-
 	return ref;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
-	lock.lock();
+	for (Shard &shard : shards) {
+		shard.lock.write_lock();
 
-	LocalVector<String> to_remove;
+		LocalVector<String> to_remove;
 
-	for (KeyValue<String, Resource *> &E : resources) {
-		Ref<Resource> ref = Ref<Resource>(E.value);
+		for (KeyValue<String, Resource *> &E : shard.resources) {
+			Ref<Resource> ref = Ref<Resource>(E.value);
 
-		if (!ref.is_valid()) {
-			// This resource is in the process of being deleted, ignore its existence
-			E.value->path_cache = String();
-			to_remove.push_back(E.key);
-			continue;
+			if (!ref.is_valid()) {
+				// This resource is in the process of being deleted, ignore its existence.
+				to_remove.push_back(E.key);
+				continue;
+			}
+
+			p_resources->push_back(ref);
 		}
 
-		p_resources->push_back(ref);
-	}
+		for (const String &E : to_remove) {
+			shard.resources.erase(E);
+		}
 
-	for (const String &E : to_remove) {
-		resources.erase(E);
+		shard.lock.write_unlock();
 	}
-
-	lock.unlock();
 }
 
 int ResourceCache::get_cached_resource_count() {
-	lock.lock();
-	int rc = resources.size();
-	lock.unlock();
+	int rc = 0;
+	for (Shard &shard : shards) {
+		shard.lock.read_lock();
+		rc += shard.resources.size();
+		shard.lock.read_unlock();
+	}
 
 	return rc;
 }
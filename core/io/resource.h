@@ -154,9 +154,26 @@ public:
 
 class ResourceCache {
 	friend class Resource;
-	friend class ResourceLoader; //need the lock
-	static Mutex lock;
-	static HashMap<String, Resource *> resources;
+	friend class ResourceLoader; // Needs remapped_list_lock.
+
+	// The cache is split in shards by path hash, each with its own lock,
+	// so threads loading or freeing different resources rarely contend.
+	enum {
+		SHARD_COUNT = 32,
+	};
+
+	struct Shard {
+		RWLock lock;
+		HashMap<String, Resource *> resources;
+	};
+
+	static Shard shards[SHARD_COUNT];
+	_FORCE_INLINE_ static Shard &_get_shard(const String &p_path) { return shards[p_path.hash() & (SHARD_COUNT - 1)]; }
+
+	static void _remove(const String &p_path, const Resource *p_resource);
+	static void _erase_if_dying(Shard &p_shard, const String &p_path);
+
+	static Mutex remapped_list_lock;
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
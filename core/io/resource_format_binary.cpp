@@ -665,11 +665,21 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+String ResourceLoaderBinary::_resolve_prefetch_path(const String &p_path) {
+	return ResourceLoader::import_remap(ResourceLoader::path_remap(p_path));
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
 	}
 
+	// Prefetching only pays off when the dependencies are loaded in parallel. In a serial load,
+	// each file is read right when it's needed anyway.
+	const ResourceLoader::LoadThreadMode dependency_thread_mode = ResourceLoader::_get_dependency_thread_mode(use_sub_threads);
+	const bool prefetch_dependencies = dependency_thread_mode == ResourceLoader::LOAD_THREAD_DISTRIBUTE;
+	Vector<String> prefetch_paths;
+
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -683,7 +693,21 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, ResourceFormatLoader::CACHE_MODE_REUSE);
+
+		if (prefetch_dependencies && !ResourceCache::has(path)) {
+			prefetch_paths.push_back(path);
+		}
+	}
+
+	// Have the I/O thread bring the dependencies in while their loads are being set up,
+	// so the threads loading them don't each block on the disk in turn.
+	// Finding the imported files reads their .import files, so that's left to the I/O thread too.
+	FileAccess::prefetch_async(prefetch_paths, _resolve_prefetch_path);
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
+
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, dependency_thread_mode, ResourceFormatLoader::CACHE_MODE_REUSE);
 		if (!external_resources[i].load_token.is_valid()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
 				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
@@ -92,6 +92,8 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	static String _resolve_prefetch_path(const String &p_path);
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -147,6 +147,10 @@ public:
 	virtual Error import_group_file(const String &p_group_file, const HashMap<String, HashMap<StringName, Variant>> &p_source_file_options, const HashMap<String, String> &p_base_paths) { return ERR_UNAVAILABLE; }
 	virtual bool are_import_settings_valid(const String &p_path) const { return true; }
 	virtual String get_import_settings_string() const { return String(); }
+
+	// Whether import results only depend on the source file contents, options and import settings,
+	// so they can be reused from the editor's shared import cache.
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const { return false; }
 };
 
 VARIANT_ENUM_CAST(ResourceImporter::ImportOrder);
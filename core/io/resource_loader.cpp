@@ -449,6 +449,13 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
 	String local_path = _validate_local_path(p_path);
 
+	// Remapping may need to read files, so do it before taking the lock, unless it's likely not needed.
+	bool xl_remapped = false;
+	String remapped_path;
+	if (p_cache_mode != ResourceFormatLoader::CACHE_MODE_REUSE || !ResourceCache::has(local_path)) {
+		remapped_path = _path_remap(local_path, &xl_remapped);
+	}
+
 	Ref<LoadToken> load_token;
 	bool must_not_register = false;
 	ThreadLoadTask unregistered_load_task; // Once set, must be valid up to the call to do the load.
@@ -477,7 +484,11 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		{
 			ThreadLoadTask load_task;
 
-			load_task.remapped_path = _path_remap(local_path, &load_task.xl_remapped);
+			if (remapped_path.is_empty()) {
+				remapped_path = _path_remap(local_path, &xl_remapped);
+			}
+			load_task.remapped_path = remapped_path;
+			load_task.xl_remapped = xl_remapped;
 			load_task.load_token = load_token.ptr();
 			load_task.local_path = local_path;
 			load_task.type_hint = p_type_hint;
@@ -1003,7 +1014,7 @@ String ResourceLoader::path_remap(const String &p_path) {
 }
 
 void ResourceLoader::reload_translation_remaps() {
-	ResourceCache::lock.lock();
+	ResourceCache::remapped_list_lock.lock();
 
 	List<Resource *> to_reload;
 	SelfList<Resource> *E = remapped_list.first();
@@ -1013,7 +1024,7 @@ void ResourceLoader::reload_translation_remaps() {
 		E = E->next();
 	}
 
-	ResourceCache::lock.unlock();
+	ResourceCache::remapped_list_lock.unlock();
 
 	//now just make sure to not delete any of these resources while changing locale..
 	while (to_reload.front()) {
@@ -1196,6 +1207,7 @@ DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
 
 bool ResourceLoader::create_missing_resources_if_class_unavailable = false;
 bool ResourceLoader::abort_on_missing_resource = true;
+bool ResourceLoader::parallel_dependency_loading = false;
 bool ResourceLoader::timestamp_on_load = false;
 
 thread_local int ResourceLoader::load_nesting = 0;
@@ -130,6 +130,8 @@ public:
 
 	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
+	// Thread mode format loaders should start the loads of their dependencies with.
+	_FORCE_INLINE_ static LoadThreadMode _get_dependency_thread_mode(bool p_use_sub_threads) { return (p_use_sub_threads || parallel_dependency_loading) ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_FROM_CURRENT; }
 
 private:
 	static Ref<Resource> _load_complete_inner(LoadToken &p_load_token, Error *r_error, MutexLock<SafeBinaryMutex<BINARY_MUTEX_TAG>> &p_thread_load_lock);
@@ -144,6 +146,7 @@ private:
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
 	static bool create_missing_resources_if_class_unavailable;
+	static bool parallel_dependency_loading;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
 
@@ -248,6 +251,9 @@ public:
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
 
+	static void set_parallel_dependency_loading(bool p_enable) { parallel_dependency_loading = p_enable; }
+	static bool is_parallel_dependency_loading_enabled() { return parallel_dependency_loading; }
+
 	static String path_remap(const String &p_path);
 	static String import_remap(const String &p_path);
 
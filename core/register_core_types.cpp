@@ -310,6 +310,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/resource_loading/parallel_dependency_loading", true);
 }
 
 void register_core_singletons() {
@@ -36,12 +36,7 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_refill_and_get_char() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
@@ -156,6 +151,98 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+char32_t VariantParser::_get_nonblank_char(Stream *p_stream, int &line) {
+	char32_t c;
+	if (p_stream->saved) {
+		c = p_stream->saved;
+		p_stream->saved = 0;
+	} else {
+		c = p_stream->get_char();
+	}
+
+	while (c != 0 && c <= 32) {
+		if (c == '\n') {
+			line++;
+		}
+		c = p_stream->get_char();
+	}
+	return c;
+}
+
+double VariantParser::_read_number(Stream *p_stream, char32_t p_first, bool &r_is_float, int64_t &r_int) {
+	StringBuffer<> num;
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	char32_t c = p_first;
+	if (c == '-') {
+		num += '-';
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+	r_is_float = false;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					r_is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					r_is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+
+	if (r_is_float) {
+		r_int = 0;
+		return num.as_double();
+	}
+	r_int = num.as_int();
+	return r_int;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -415,77 +502,16 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
 
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					bool is_float;
+					int64_t int_value;
+					double float_value = _read_number(p_stream, cchar, is_float, int_value);
 
 					r_token.type = TK_NUMBER;
 
 					if (is_float) {
-						r_token.value = num.as_double();
+						r_token.value = float_value;
 					} else {
-						r_token.value = num.as_int();
+						r_token.value = int_value;
 					}
 					return OK;
 				} else if (is_ascii_char(cchar) || is_underscore(cchar)) {
@@ -558,16 +584,38 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 	bool first = true;
 	while (true) {
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
+			// Separators and plain numbers are read straight from the stream, which is
+			// most of what large packed arrays are made of. Anything else goes through get_token().
+			char32_t c = _get_nonblank_char(p_stream, line);
+			if (c == ',') {
 				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			} else if (c == ')') {
 				break;
 			} else {
-				r_err_str = "Expected ',' or ')' in constructor";
-				return ERR_PARSE_ERROR;
+				p_stream->saved = c;
+				get_token(p_stream, token, line, r_err_str);
+				if (token.type == TK_COMMA) {
+					//do none
+				} else if (token.type == TK_PARENTHESIS_CLOSE) {
+					break;
+				} else {
+					r_err_str = "Expected ',' or ')' in constructor";
+					return ERR_PARSE_ERROR;
+				}
 			}
 		}
+
+		char32_t c = _get_nonblank_char(p_stream, line);
+		if (c == '-' || is_digit(c)) {
+			bool is_float;
+			int64_t int_value;
+			double float_value = _read_number(p_stream, c, is_float, int_value);
+			r_construct.push_back(is_float ? T(float_value) : T(int_value));
+			first = false;
+			continue;
+		}
+
+		p_stream->saved = c;
 		get_token(p_stream, token, line, r_err_str);
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
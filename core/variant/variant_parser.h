@@ -50,10 +50,18 @@ public:
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
 		virtual bool _is_eof() const = 0;
 
+		char32_t _refill_and_get_char();
+
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		// Only refilling the buffer goes through a virtual call.
+		_FORCE_INLINE_ char32_t get_char() {
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _refill_and_get_char();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -139,6 +147,8 @@ public:
 private:
 	static const char *tk_name[TK_MAX];
 
+	static char32_t _get_nonblank_char(Stream *p_stream, int &line);
+	static double _read_number(Stream *p_stream, char32_t p_first, bool &r_is_float, int64_t &r_int);
 	template <class T>
 	static Error _parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str);
 	static Error _parse_enginecfg(Stream *p_stream, Vector<String> &strings, int &line, String &r_err_str);
@@ -5048,7 +5048,7 @@ void RenderingDeviceDriverD3D12::command_render_draw_indexed_indirect(CommandBuf
 	BufferInfo *indirect_buf_info = (BufferInfo *)p_indirect_buffer.id;
 	_resource_transition_batch(indirect_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transitions_flush(cmd_buf_info->cmd_list.Get());
-	cmd_buf_info->cmd_list->ExecuteIndirect(indirect_cmd_signatures.draw_indexed.Get(), p_draw_count, indirect_buf_info->resource, p_offset, nullptr, 0);
+	cmd_buf_info->cmd_list->ExecuteIndirect(_get_draw_cmd_signature(true, p_draw_count, p_stride), p_draw_count, indirect_buf_info->resource, p_offset, nullptr, 0);
 }
 
 void RenderingDeviceDriverD3D12::command_render_draw_indexed_indirect_count(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, BufferID p_count_buffer, uint64_t p_count_buffer_offset, uint32_t p_max_draw_count, uint32_t p_stride) {
@@ -5059,7 +5059,7 @@ void RenderingDeviceDriverD3D12::command_render_draw_indexed_indirect_count(Comm
 	_resource_transition_batch(indirect_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transition_batch(count_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transitions_flush(cmd_buf_info->cmd_list.Get());
-	cmd_buf_info->cmd_list->ExecuteIndirect(indirect_cmd_signatures.draw_indexed.Get(), p_max_draw_count, indirect_buf_info->resource, p_offset, count_buf_info->resource, p_count_buffer_offset);
+	cmd_buf_info->cmd_list->ExecuteIndirect(_get_draw_cmd_signature(true, p_max_draw_count, p_stride), p_max_draw_count, indirect_buf_info->resource, p_offset, count_buf_info->resource, p_count_buffer_offset);
 }
 
 void RenderingDeviceDriverD3D12::command_render_draw_indirect(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
@@ -5068,7 +5068,7 @@ void RenderingDeviceDriverD3D12::command_render_draw_indirect(CommandBufferID p_
 	BufferInfo *indirect_buf_info = (BufferInfo *)p_indirect_buffer.id;
 	_resource_transition_batch(indirect_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transitions_flush(cmd_buf_info->cmd_list.Get());
-	cmd_buf_info->cmd_list->ExecuteIndirect(indirect_cmd_signatures.draw.Get(), p_draw_count, indirect_buf_info->resource, p_offset, nullptr, 0);
+	cmd_buf_info->cmd_list->ExecuteIndirect(_get_draw_cmd_signature(false, p_draw_count, p_stride), p_draw_count, indirect_buf_info->resource, p_offset, nullptr, 0);
 }
 
 void RenderingDeviceDriverD3D12::command_render_draw_indirect_count(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, BufferID p_count_buffer, uint64_t p_count_buffer_offset, uint32_t p_max_draw_count, uint32_t p_stride) {
@@ -5079,7 +5079,7 @@ void RenderingDeviceDriverD3D12::command_render_draw_indirect_count(CommandBuffe
 	_resource_transition_batch(indirect_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transition_batch(count_buf_info, 0, 1, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
 	_resource_transitions_flush(cmd_buf_info->cmd_list.Get());
-	cmd_buf_info->cmd_list->ExecuteIndirect(indirect_cmd_signatures.draw.Get(), p_max_draw_count, indirect_buf_info->resource, p_offset, count_buf_info->resource, p_count_buffer_offset);
+	cmd_buf_info->cmd_list->ExecuteIndirect(_get_draw_cmd_signature(false, p_max_draw_count, p_stride), p_max_draw_count, indirect_buf_info->resource, p_offset, count_buf_info->resource, p_count_buffer_offset);
 }
 
 void RenderingDeviceDriverD3D12::command_render_bind_vertex_buffers(CommandBufferID p_cmd_buffer, uint32_t p_binding_count, const BufferID *p_buffers, const uint64_t *p_offsets) {
@@ -5785,6 +5785,7 @@ uint64_t RenderingDeviceDriverD3D12::limit_get(Limit p_limit) {
 	uint64_t safe_unbounded = ((uint64_t)1 << 30);
 	switch (p_limit) {
 		case LIMIT_MAX_BOUND_UNIFORM_SETS:
+		case LIMIT_MAX_DRAW_INDIRECT_COUNT:
 			return safe_unbounded;
 		case LIMIT_MAX_TEXTURES_PER_SHADER_STAGE:
 			return device_limits.max_srvs_per_shader_stage;
@@ -5858,6 +5859,8 @@ bool RenderingDeviceDriverD3D12::has_feature(Features p_feature) {
 			return vrs_capabilities.ss_image_supported;
 		case SUPPORTS_FRAGMENT_SHADER_WITH_ONLY_SIDE_EFFECTS:
 			return true;
+		case SUPPORTS_MULTI_DRAW_INDIRECT:
+			return true;
 		default:
 			return false;
 	}
@@ -6198,6 +6201,27 @@ static Error create_command_signature(ID3D12Device *device, D3D12_INDIRECT_ARGUM
 	return OK;
 };
 
+ID3D12CommandSignature *RenderingDeviceDriverD3D12::_get_draw_cmd_signature(bool p_indexed, uint32_t p_draw_count, uint32_t p_stride) {
+	const uint32_t tight_stride = p_indexed ? sizeof(D3D12_DRAW_INDEXED_ARGUMENTS) : sizeof(D3D12_DRAW_ARGUMENTS);
+	if (p_draw_count <= 1 || p_stride == 0 || p_stride == tight_stride) {
+		// A single command never reads past its own arguments, so any stride will do.
+		return p_indexed ? indirect_cmd_signatures.draw_indexed.Get() : indirect_cmd_signatures.draw.Get();
+	}
+
+	const D3D12_INDIRECT_ARGUMENT_TYPE type = p_indexed ? D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED : D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+	const uint64_t key = (uint64_t(type) << 32) | p_stride;
+
+	MutexLock lock(strided_cmd_signatures_mutex);
+	ComPtr<ID3D12CommandSignature> *cmd_sig = strided_cmd_signatures.getptr(key);
+	if (cmd_sig == nullptr) {
+		ComPtr<ID3D12CommandSignature> new_cmd_sig;
+		Error err = create_command_signature(device.Get(), type, p_stride, &new_cmd_sig);
+		ERR_FAIL_COND_V(err != OK, nullptr);
+		cmd_sig = &strided_cmd_signatures.insert(key, new_cmd_sig)->value;
+	}
+	return cmd_sig->Get();
+}
+
 Error RenderingDeviceDriverD3D12::_initialize_frames(uint32_t p_frame_count) {
 	Error err;
 	D3D12MA::ALLOCATION_DESC allocation_desc = {};
@@ -173,6 +173,11 @@ class RenderingDeviceDriverD3D12 : public RenderingDeviceDriver {
 		ComPtr<ID3D12CommandSignature> draw_indexed;
 		ComPtr<ID3D12CommandSignature> dispatch;
 	} indirect_cmd_signatures;
+	// The stride is part of a command signature, so draws whose commands aren't tightly packed get their own.
+	Mutex strided_cmd_signatures_mutex;
+	HashMap<uint64_t, ComPtr<ID3D12CommandSignature>> strided_cmd_signatures; // Key is argument type and stride.
+
+	ID3D12CommandSignature *_get_draw_cmd_signature(bool p_indexed, uint32_t p_draw_count, uint32_t p_stride);
 
 	static void STDMETHODCALLTYPE _debug_message_func(D3D12_MESSAGE_CATEGORY p_category, D3D12_MESSAGE_SEVERITY p_severity, D3D12_MESSAGE_ID p_id, LPCSTR p_description, void *p_context);
 	void _set_object_name(ID3D12Object *p_object, String p_object_name);
@@ -408,6 +408,18 @@ String Utilities::get_video_adapter_api_version() const {
 	return String::utf8((const char *)glGetString(GL_VERSION));
 }
 
+void Utilities::pipeline_variants_capture_start() {
+	WARN_PRINT_ONCE("Capturing pipeline variants is only supported by the Forward+ and Mobile renderers.");
+}
+
+Error Utilities::pipeline_variants_capture_stop(const String &p_path) {
+	return ERR_UNAVAILABLE;
+}
+
+bool Utilities::is_capturing_pipeline_variants() const {
+	return false;
+}
+
 Size2i Utilities::get_maximum_viewport_size() const {
 	Config *config = Config::get_singleton();
 	if (!config) {
@@ -206,6 +206,10 @@ public:
 	virtual RenderingDevice::DeviceType get_video_adapter_type() const override;
 	virtual String get_video_adapter_api_version() const override;
 
+	virtual void pipeline_variants_capture_start() override;
+	virtual Error pipeline_variants_capture_stop(const String &p_path) override;
+	virtual bool is_capturing_pipeline_variants() const override;
+
 	virtual Size2i get_maximum_viewport_size() const override;
 };
 
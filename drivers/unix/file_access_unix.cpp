@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapping) {
+		munmap(mapping, mapping_size);
+		mapping = nullptr;
+		mapping_size = 0;
+	}
+	mapping_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +290,44 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_range(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (flags != READ) {
+		return nullptr; // Only read-only files are mapped, so the mapping can't get out of sync with writes.
+	}
+
+	if (!mapping && !mapping_failed) {
+		// The whole file is mapped on first use, the OS pages it in on demand.
+		struct stat st = {};
+		if (fstat(fileno(f), &st) == 0 && st.st_size > 0) {
+			void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+			if (addr != MAP_FAILED) {
+				mapping = (uint8_t *)addr;
+				mapping_size = st.st_size;
+			}
+		}
+		mapping_failed = mapping == nullptr;
+	}
+
+	if (!mapping || p_offset > mapping_size || p_length > mapping_size - p_offset) {
+		return nullptr;
+	}
+
+	return mapping + p_offset;
+}
+
+bool FileAccessUnix::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, false, "File must be opened before use.");
+
+#ifdef POSIX_FADV_WILLNEED
+	// Let the kernel read ahead in the background instead of copying the data here.
+	return posix_fadvise(fileno(f), p_offset, p_length, POSIX_FADV_WILLNEED) == 0;
+#else
+	return false;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
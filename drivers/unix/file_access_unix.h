@@ -49,6 +49,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable uint8_t *mapping = nullptr;
+	mutable uint64_t mapping_size = 0;
+	mutable bool mapping_failed = false;
+
 	void _close();
 
 public:
@@ -72,6 +76,8 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_offset, uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -4862,6 +4862,8 @@ uint64_t RenderingDeviceDriverVulkan::limit_get(Limit p_limit) {
 			return vrs_capabilities.texel_size.x;
 		case LIMIT_VRS_TEXEL_HEIGHT:
 			return vrs_capabilities.texel_size.y;
+		case LIMIT_MAX_DRAW_INDIRECT_COUNT:
+			return limits.maxDrawIndirectCount;
 		default:
 			ERR_FAIL_V(0);
 	}
@@ -4888,6 +4890,8 @@ bool RenderingDeviceDriverVulkan::has_feature(Features p_feature) {
 			return vrs_capabilities.attachment_vrs_supported && physical_device_features.shaderStorageImageExtendedFormats;
 		case SUPPORTS_FRAGMENT_SHADER_WITH_ONLY_SIDE_EFFECTS:
 			return true;
+		case SUPPORTS_MULTI_DRAW_INDIRECT:
+			return physical_device_features.multiDrawIndirect;
 		default:
 			return false;
 	}
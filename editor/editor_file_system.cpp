@@ -44,6 +44,7 @@
 #include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
 #include "editor/editor_settings.h"
+#include "editor/import/editor_import_cache.h"
 #include "scene/resources/packed_scene.h"
 
 EditorFileSystem *EditorFileSystem::singleton = nullptr;
@@ -2129,7 +2130,23 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err;
+
+	// Imports that only depend on the source contents and options can be reused from the shared import cache.
+	String cache_key;
+	if (importer->can_use_import_cache(params) && EditorImportCache::is_enabled()) {
+		cache_key = EditorImportCache::get_key(p_file, importer, opts, params);
+	}
+
+	if (!cache_key.is_empty() && EditorImportCache::restore(cache_key, base_path, &import_variants, &meta)) {
+		err = OK;
+	} else {
+		import_variants.clear();
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+		if (err == OK && !cache_key.is_empty() && gen_files.is_empty()) {
+			EditorImportCache::store(cache_key, importer, base_path, import_variants, meta);
+		}
+	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, ERR_FILE_UNRECOGNIZED, "Error importing '" + p_file + "'.");
 
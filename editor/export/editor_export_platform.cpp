@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/zip_io.h"
@@ -60,6 +61,7 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+#define PCK_PENDING_MAX (64 * 1024 * 1024) // Bytes of file data waiting to be written.
 
 bool EditorExportPlatform::fill_log_messages(RichTextLabel *p_log, Error p_err) {
 	bool has_messages = false;
@@ -219,14 +221,116 @@ void EditorExportPlatform::gen_debug_flags(Vector<String> &r_flags, int p_flags)
 	}
 }
 
+void EditorExportPlatform::_prepare_pack_file(void *p_userdata) {
+	PendingPackFile *pf = (PendingPackFile *)p_userdata;
+
+	// Store MD5 of original file.
+	pf->sd.md5.resize(16);
+	CryptoCore::md5(pf->data.ptr(), pf->data.size(), pf->sd.md5.ptrw());
+	CryptoCore::sha256(pf->data.ptr(), pf->data.size(), pf->sha256);
+
+	if (pf->compress) {
+		Vector<uint8_t> compressed;
+		pf->error = FileAccessCompressed::compress_buffer(pf->data.ptr(), pf->data.size(), PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSION_BLOCK_SIZE, pf->dictionary, compressed);
+		if (pf->error != OK) {
+			return;
+		}
+		// Files that don't get smaller are stored as they are.
+		if (compressed.size() < pf->data.size()) {
+			pf->data = compressed;
+			pf->sd.compressed = true;
+		}
+	}
+
+	if (pf->sd.encrypted) {
+		Vector<uint8_t> encrypted;
+		encrypted.resize(FileAccessEncrypted::get_encrypted_size(pf->data.size()));
+		pf->error = FileAccessEncrypted::encrypt_buffer(pf->data.ptr(), pf->data.size(), pf->key, pf->iv, encrypted.ptrw());
+		pf->data = encrypted;
+	}
+}
+
+Error EditorExportPlatform::_store_pending_pack_files(PackData *p_pd, bool p_all) {
+	Error err = OK;
+	// After an error, the remaining files are still waited for, but not stored.
+	while (!p_pd->pending.is_empty() && (p_all || err != OK || p_pd->pending_size > PCK_PENDING_MAX)) {
+		PendingPackFile *pf = p_pd->pending.front()->get();
+		p_pd->pending.pop_front();
+		p_pd->pending_size -= pf->sd.size;
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pf->task);
+
+		if (err == OK && pf->error != OK) {
+			ERR_PRINT("Can't compress or encrypt file: " + String::utf8(pf->sd.path_utf8.get_data()) + ".");
+			err = ERR_SKIP;
+		}
+		if (err != OK) {
+			memdelete(pf);
+			continue;
+		}
+
+		// Files with identical contents share a single stored copy.
+		String content_key = String::hex_encode_buffer(pf->sha256, 32) + ":" + itos(pf->sd.size) + (pf->sd.encrypted ? ":e" : "") + (pf->sd.compressed ? ":c" : "");
+		HashMap<String, uint64_t>::Iterator E = p_pd->stored_by_content.find(content_key);
+		if (E) {
+			pf->sd.ofs = E->value;
+		} else {
+			pf->sd.ofs = p_pd->f->get_position();
+			p_pd->stored_by_content.insert(content_key, pf->sd.ofs);
+
+			// Store file content.
+			p_pd->f->store_buffer(pf->data.ptr(), pf->data.size());
+
+			int pad = _get_pad(PCK_PADDING, p_pd->f->get_position());
+			for (int i = 0; i < pad; i++) {
+				p_pd->f->store_8(0);
+			}
+		}
+
+		p_pd->file_ofs.push_back(pf->sd);
+		memdelete(pf);
+	}
+	return err;
+}
+
+Error EditorExportPlatform::_store_deferred_pack_files(PackData *p_pd) {
+	if (p_pd->deferred.is_empty()) {
+		return OK;
+	}
+
+	if (p_pd->samples.size() > 1) {
+		p_pd->dictionary = Compression::build_zstd_dictionary(p_pd->samples, p_pd->dictionary_size);
+	}
+	if (!p_pd->dictionary.is_empty()) {
+		// Stored with the file data, its offset is written in the header.
+		p_pd->dictionary_ofs = p_pd->f->get_position();
+		p_pd->f->store_buffer(p_pd->dictionary);
+		int pad = _get_pad(PCK_PADDING, p_pd->f->get_position());
+		for (int i = 0; i < pad; i++) {
+			p_pd->f->store_8(0);
+		}
+		p_pd->zstd_dictionary = memnew(Compression::ZstdDictionary(p_pd->dictionary, true, false));
+	}
+
+	while (!p_pd->deferred.is_empty()) {
+		PendingPackFile *pf = p_pd->deferred.front()->get();
+		p_pd->deferred.pop_front();
+		pf->dictionary = p_pd->zstd_dictionary;
+		pf->task = WorkerThreadPool::get_singleton()->add_native_task(&EditorExportPlatform::_prepare_pack_file, pf, false, SNAME("ExportPackFile"));
+		p_pd->pending.push_back(pf);
+		p_pd->pending_size += pf->sd.size;
+	}
+
+	return _store_pending_pack_files(p_pd, true);
+}
+
 Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key) {
 	ERR_FAIL_COND_V_MSG(p_total < 1, ERR_PARAMETER_RANGE_ERROR, "Must select at least one file to export.");
 
 	PackData *pd = (PackData *)p_userdata;
 
-	SavedData sd;
+	PendingPackFile *pf = memnew(PendingPackFile);
+	SavedData &sd = pf->sd;
 	sd.path_utf8 = p_path.utf8();
-	sd.ofs = pd->f->get_position();
 	sd.size = p_data.size();
 	sd.encrypted = false;
 
@@ -244,43 +348,31 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
-	Ref<FileAccessEncrypted> fae;
-	Ref<FileAccess> ftmp = pd->f;
-
+	pf->data = p_data;
+	pf->compress = pd->compress && sd.size <= UINT32_MAX; // Limit of the compressed format.
 	if (sd.encrypted) {
-		fae.instantiate();
-		ERR_FAIL_COND_V(fae.is_null(), ERR_SKIP);
-
-		Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_SKIP);
-		ftmp = fae;
-	}
-
-	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
-
-	if (fae.is_valid()) {
-		ftmp.unref();
-		fae.unref();
+		pf->key = p_key;
+		// Generated here rather than on the workers, so the output only depends on the random seed.
+		for (int i = 0; i < 16; i++) {
+			pf->iv[i] = Math::rand() % 256;
+		}
 	}
 
-	int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
-	}
+	if (pf->compress && pd->dictionary_size > 0 && sd.size <= PACK_DICTIONARY_SAMPLE_FILE_MAX) {
+		pd->samples.push_back(p_data.slice(0, MIN(sd.size, (uint64_t)PACK_DICTIONARY_SAMPLE_SIZE)));
+		pd->deferred.push_back(pf);
+	} else {
+		// Hash, compress and encrypt on a worker thread, the data is written in order once it's ready.
+		pf->task = WorkerThreadPool::get_singleton()->add_native_task(&EditorExportPlatform::_prepare_pack_file, pf, false, SNAME("ExportPackFile"));
+		pd->pending.push_back(pf);
+		pd->pending_size += sd.size;
 
-	// Store MD5 of original file.
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(p_data.ptr(), p_data.size(), hash);
-		sd.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			sd.md5.write[i] = hash[i];
+		Error err = _store_pending_pack_files(pd, false);
+		if (err != OK) {
+			return err;
 		}
 	}
 
-	pd->file_ofs.push_back(sd);
-
 	// TRANSLATORS: This is an editor progress label describing the storing of a file.
 	if (pd->ep->step(vformat(TTR("Storing File: %s"), p_path), 2 + p_file * 100 / p_total, false)) {
 		return ERR_SKIP;
@@ -1549,8 +1641,18 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/export/pck_compression");
+	pd.dictionary_size = GLOBAL_GET("editor/export/pck_compression_dictionary_size");
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
+	// Also waits for the files still being prepared when the export failed.
+	Error store_err = _store_pending_pack_files(&pd, true);
+	if (err == OK) {
+		err = store_err;
+	}
+	if (err == OK) {
+		err = _store_deferred_pack_files(&pd);
+	}
 
 	// Close temp file.
 	pd.f.unref();
@@ -1599,8 +1701,14 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	// Only packs holding compressed files need the newer format version.
+	bool uses_compression = !pd.dictionary.is_empty();
+	for (int i = 0; i < pd.file_ofs.size() && !uses_compression; i++) {
+		uses_compression = pd.file_ofs[i].compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(uses_compression ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_UNCOMPRESSED);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1616,7 +1724,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	uint64_t file_base_ofs = f->get_position();
 	f->store_64(0); // files base
 
-	for (int i = 0; i < 16; i++) {
+	f->store_64(pd.dictionary_ofs); // dictionary offset
+	f->store_32(pd.dictionary.size()); // dictionary size
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->store_32(0);
 	}
@@ -1687,6 +1797,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -34,8 +34,10 @@
 class EditorFileSystemDirectory;
 struct EditorProgress;
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/zip_io.h"
+#include "core/object/worker_thread_pool.h"
 #include "editor_export_preset.h"
 #include "editor_export_shared_object.h"
 #include "scene/gui/rich_text_label.h"
@@ -74,6 +76,7 @@ private:
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -82,11 +85,45 @@ private:
 		}
 	};
 
+	// A file being hashed, compressed and encrypted on a worker thread, before it's written to the pack in order.
+	struct PendingPackFile {
+		SavedData sd;
+		Vector<uint8_t> data;
+		bool compress = false;
+		const Compression::ZstdDictionary *dictionary = nullptr;
+		Vector<uint8_t> key;
+		uint8_t iv[16] = {};
+		uint8_t sha256[32] = {};
+		Error error = OK;
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	struct PackData {
 		Ref<FileAccess> f;
 		Vector<SavedData> file_ofs;
+		HashMap<String, uint64_t> stored_by_content; // SHA-256, size and encryption -> offset of the stored data.
+		List<PendingPackFile *> pending;
+		uint64_t pending_size = 0;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+
+		bool compress = false;
+		int dictionary_size = 0;
+		// Small files are compressed last, with a dictionary built from their leading bytes.
+		List<PendingPackFile *> deferred;
+		Vector<Vector<uint8_t>> samples;
+		Vector<uint8_t> dictionary;
+		uint64_t dictionary_ofs = 0;
+		Compression::ZstdDictionary *zstd_dictionary = nullptr;
+
+		~PackData() {
+			for (PendingPackFile *pf : deferred) {
+				memdelete(pf);
+			}
+			if (zstd_dictionary) {
+				memdelete(zstd_dictionary);
+			}
+		}
 	};
 
 	struct ZipData {
@@ -100,6 +137,9 @@ private:
 	void _export_find_customized_resources(const Ref<EditorExportPreset> &p_preset, EditorFileSystemDirectory *p_dir, EditorExportPreset::FileExportMode p_mode, HashSet<String> &p_paths);
 	void _export_find_dependencies(const String &p_path, HashSet<String> &p_paths);
 
+	static void _prepare_pack_file(void *p_userdata);
+	static Error _store_pending_pack_files(PackData *p_pd, bool p_all);
+	static Error _store_deferred_pack_files(PackData *p_pd);
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
 
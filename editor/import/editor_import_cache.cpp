@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  editor_import_cache.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_cache.h"
+
+#include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/variant/variant_parser.h"
+#include "core/version.h"
+#include "editor/editor_settings.h"
+
+String EditorImportCache::_get_entry_dir(const String &p_key) {
+	String cache_path = EDITOR_GET("filesystem/import/shared_cache_path");
+	return cache_path.path_join(p_key.substr(0, 2)).path_join(p_key);
+}
+
+void EditorImportCache::_remove_dir(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		da->change_dir("..");
+		da->remove(p_dir);
+	}
+}
+
+bool EditorImportCache::is_enabled() {
+	return EditorSettings::get_singleton() && !String(EDITOR_GET("filesystem/import/shared_cache_path")).is_empty();
+}
+
+String EditorImportCache::get_key(const String &p_source_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) {
+	String source_md5 = FileAccess::get_md5(p_source_file);
+	if (source_md5.is_empty()) {
+		return String();
+	}
+
+	String key = source_md5 + "\n";
+	key += p_importer->get_importer_name() + ":" + itos(p_importer->get_format_version()) + "\n";
+	key += String(VERSION_FULL_BUILD) + ":" + String(VERSION_HASH) + "\n";
+	key += p_importer->get_import_settings_string() + "\n";
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		String value;
+		VariantWriter::write_to_string(p_params[E.option.name], value);
+		key += String(E.option.name) + "=" + value + "\n";
+	}
+
+	return key.sha256_text();
+}
+
+bool EditorImportCache::restore(const String &p_key, const String &p_base_path, List<String> *r_variants, Variant *r_metadata) {
+	String entry_dir = _get_entry_dir(p_key);
+
+	Ref<ConfigFile> manifest;
+	manifest.instantiate();
+	if (manifest->load(entry_dir.path_join("manifest.cfg")) != OK) {
+		return false;
+	}
+
+	// The cache may live on a shared or network drive, so every file is checked against the
+	// checksum taken when it was stored. Damaged entries are removed so the next import replaces them.
+	Vector<String> suffixes = manifest->get_value("import", "files", Vector<String>());
+	Vector<String> checksums = manifest->get_value("import", "md5", Vector<String>());
+	if (checksums.size() != suffixes.size()) {
+		WARN_PRINT("Import cache entry '" + entry_dir + "' is damaged, removing it.");
+		_remove_dir(entry_dir);
+		return false;
+	}
+	for (int i = 0; i < suffixes.size(); i++) {
+		const String path = p_base_path + suffixes[i];
+		if (DirAccess::copy_absolute(entry_dir.path_join("data" + suffixes[i]), path) != OK) {
+			return false;
+		}
+		if (FileAccess::get_md5(path) != checksums[i]) {
+			WARN_PRINT("Import cache entry '" + entry_dir + "' is damaged, removing it.");
+			_remove_dir(entry_dir);
+			return false;
+		}
+	}
+
+	Vector<String> variants = manifest->get_value("import", "variants", Vector<String>());
+	for (const String &variant : variants) {
+		r_variants->push_back(variant);
+	}
+	*r_metadata = manifest->get_value("import", "metadata", Variant());
+
+	return true;
+}
+
+void EditorImportCache::store(const String &p_key, const Ref<ResourceImporter> &p_importer, const String &p_base_path, const List<String> &p_variants, const Variant &p_metadata) {
+	String entry_dir = _get_entry_dir(p_key);
+	if (DirAccess::exists(entry_dir)) {
+		return; // Stored by another import of the same contents.
+	}
+
+	List<String> files;
+	String extension = p_importer->get_save_extension();
+	if (!extension.is_empty()) {
+		if (p_variants.size()) {
+			for (const String &E : p_variants) {
+				files.push_back(p_base_path + "." + E + "." + extension);
+			}
+		} else {
+			files.push_back(p_base_path + "." + extension);
+		}
+	}
+
+	// Filled in a directory of its own and moved in place once complete, so concurrent imports
+	// (from other editors sharing the cache) never see a partial entry.
+	String tmp_dir = entry_dir + vformat(".tmp-%d-%d", OS::get_singleton()->get_process_id(), (uint64_t)Thread::get_caller_id());
+	Error err = DirAccess::make_dir_recursive_absolute(tmp_dir);
+	ERR_FAIL_COND_MSG(err != OK, "Can't create import cache directory '" + tmp_dir + "'.");
+
+	Vector<String> suffixes;
+	Vector<String> checksums;
+	for (const String &E : files) {
+		String suffix = E.trim_prefix(p_base_path);
+		err = DirAccess::copy_absolute(E, tmp_dir.path_join("data" + suffix));
+		if (err != OK) {
+			break;
+		}
+		suffixes.push_back(suffix);
+		checksums.push_back(FileAccess::get_md5(E));
+	}
+
+	if (err == OK) {
+		Ref<ConfigFile> manifest;
+		manifest.instantiate();
+		manifest->set_value("import", "files", suffixes);
+		manifest->set_value("import", "md5", checksums);
+		Vector<String> variants;
+		for (const String &E : p_variants) {
+			variants.push_back(E);
+		}
+		manifest->set_value("import", "variants", variants);
+		manifest->set_value("import", "metadata", p_metadata);
+		err = manifest->save(tmp_dir.path_join("manifest.cfg"));
+	}
+
+	if (err == OK && DirAccess::rename_absolute(tmp_dir, entry_dir) == OK) {
+		return;
+	}
+
+	// Failed, or another editor stored the same entry first.
+	_remove_dir(tmp_dir);
+}
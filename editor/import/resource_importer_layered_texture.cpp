@@ -430,6 +430,8 @@ String ResourceImporterLayeredTexture::get_import_settings_string() const {
 		index++;
 	}
 
+	s += ResourceImporterTexture::get_lossless_settings_string();
+
 	return s;
 }
 
@@ -116,6 +116,7 @@ public:
 
 	virtual bool are_import_settings_valid(const String &p_path) const override;
 	virtual String get_import_settings_string() const override;
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const override { return true; }
 
 	void set_mode(Mode p_mode) { mode = p_mode; }
 
@@ -724,6 +724,34 @@ const char *ResourceImporterTexture::compression_formats[] = {
 	"etc2_astc",
 	nullptr
 };
+
+bool ResourceImporterTexture::can_use_import_cache(const HashMap<StringName, Variant> &p_options) const {
+	// Editor images depend on the editor scale and theme.
+	bool use_editor_scale = p_options.has("editor/scale_with_editor_scale") && p_options["editor/scale_with_editor_scale"];
+	bool convert_editor_colors = p_options.has("editor/convert_colors_with_editor_theme") && p_options["editor/convert_colors_with_editor_theme"];
+	return !use_editor_scale && !convert_editor_colors;
+}
+
+String ResourceImporterTexture::get_lossless_settings_string() {
+	// Project settings that change how lossless (and WebP) textures are saved. They're only listed while
+	// they differ from their defaults, so projects that never changed them keep their import settings hash.
+	static const char *lossless_settings[] = {
+		"rendering/textures/lossless_compression/force_png",
+		"rendering/textures/webp_compression/compression_method",
+		"rendering/textures/webp_compression/lossless_compression_factor",
+		nullptr
+	};
+
+	String s;
+	for (int i = 0; lossless_settings[i]; i++) {
+		Variant value = GLOBAL_GET(lossless_settings[i]);
+		if (value != ProjectSettings::get_singleton()->property_get_revert(lossless_settings[i])) {
+			s += ":" + String(lossless_settings[i]) + "=" + value.stringify();
+		}
+	}
+	return s;
+}
+
 String ResourceImporterTexture::get_import_settings_string() const {
 	String s;
 
@@ -737,6 +765,8 @@ String ResourceImporterTexture::get_import_settings_string() const {
 		index++;
 	}
 
+	s += get_lossless_settings_string();
+
 	return s;
 }
 
@@ -80,6 +80,7 @@ protected:
 
 public:
 	static void save_to_ctex_format(Ref<FileAccess> f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality);
+	static String get_lossless_settings_string();
 
 	static ResourceImporterTexture *get_singleton() { return singleton; }
 	virtual String get_importer_name() const override;
@@ -106,6 +107,7 @@ public:
 
 	virtual bool are_import_settings_valid(const String &p_path) const override;
 	virtual String get_import_settings_string() const override;
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const override;
 
 	ResourceImporterTexture(bool p_singleton = false);
 	~ResourceImporterTexture();
@@ -275,6 +275,8 @@ void register_editor_types() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/import/atlas_max_width", PROPERTY_HINT_RANGE, "128,8192,1,or_greater"), 2048);
 
 	GLOBAL_DEF("editor/export/convert_text_resources_to_binary", true);
+	GLOBAL_DEF("editor/export/pck_compression", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/export/pck_compression_dictionary_size", PROPERTY_HINT_RANGE, "0,1048576,1,or_greater,suffix:B"), 0);
 
 	GLOBAL_DEF("editor/version_control/plugin_name", "");
 	GLOBAL_DEF("editor/version_control/autoload_on_startup", false);
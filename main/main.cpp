@@ -1724,6 +1724,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
 			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
 		}
+		ResourceLoader::set_parallel_dependency_loading(GLOBAL_GET("threading/resource_loading/parallel_dependency_loading"));
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
 #endif
@@ -4099,6 +4100,7 @@ void Main::cleanup(bool p_force) {
 	}
 
 	ResourceLoader::clear_thread_load_tasks();
+	FileAccess::finish_async_reads();
 
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
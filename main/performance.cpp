@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
+#include "scene/animation/animation_mixer.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -84,6 +85,13 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(ANIMATION_MIXERS_PROCESSED);
+	BIND_ENUM_CONSTANT(ANIMATION_MIXERS_SKIPPED);
+	BIND_ENUM_CONSTANT(ANIMATION_POSE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(ANIMATION_POSE_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILATIONS_QUEUED);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILATION_TIME);
+	BIND_ENUM_CONSTANT(RENDER_CANVAS_TEXTURE_ATLAS_BINDS_SAVED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -132,6 +140,13 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"animation/mixers_processed",
+		"animation/mixers_skipped",
+		"animation/pose_cache_hits",
+		"animation/pose_cache_misses",
+		"raster/shader_compilations_queued",
+		"raster/shader_compilation_time",
+		"raster/canvas_texture_atlas_binds_saved",
 
 	};
 
@@ -206,6 +221,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case ANIMATION_MIXERS_PROCESSED:
+			return AnimationMixer::get_lod_processed_count();
+		case ANIMATION_MIXERS_SKIPPED:
+			return AnimationMixer::get_lod_skipped_count();
+		case ANIMATION_POSE_CACHE_HITS:
+			return AnimationMixer::get_pose_cache_hit_count();
+		case ANIMATION_POSE_CACHE_MISSES:
+			return AnimationMixer::get_pose_cache_miss_count();
+		case RENDER_SHADER_COMPILATIONS_QUEUED:
+			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_SHADER_COMPILATIONS_QUEUED);
+		case RENDER_SHADER_COMPILATION_TIME:
+			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_SHADER_COMPILATION_TIME) / 1000000.0;
+		case RENDER_CANVAS_TEXTURE_ATLAS_BINDS_SAVED:
+			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_CANVAS_TEXTURE_ATLAS_BINDS_SAVED);
 
 		default: {
 		}
@@ -251,6 +280,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
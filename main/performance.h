@@ -100,6 +100,13 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		ANIMATION_MIXERS_PROCESSED,
+		ANIMATION_MIXERS_SKIPPED,
+		ANIMATION_POSE_CACHE_HITS,
+		ANIMATION_POSE_CACHE_MISSES,
+		RENDER_SHADER_COMPILATIONS_QUEUED,
+		RENDER_SHADER_COMPILATION_TIME,
+		RENDER_CANVAS_TEXTURE_ATLAS_BINDS_SAVED,
 		MONITOR_MAX
 	};
 
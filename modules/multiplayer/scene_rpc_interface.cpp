@@ -397,9 +397,10 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 		ofs += 2;
 	}
 
-	int len;
-	Error err = MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, nullptr, len, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
+	arg_cache.clear(); // Keeps the capacity between calls.
+	Error err = MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, arg_cache, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
 	ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC arguments. THIS IS LIKELY A BUG IN THE ENGINE!");
+	int len = arg_cache.size();
 	if (byte_only_or_no_args) {
 		MAKE_ROOM(ofs + len);
 	} else {
@@ -408,7 +409,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 		ofs += 1;
 	}
 	if (len) {
-		MultiplayerAPI::encode_and_compress_variants(p_arg, p_argcount, &packet_cache.write[ofs], len, &byte_only_or_no_args, multiplayer->is_object_decoding_allowed());
+		memcpy(&packet_cache.write[ofs], arg_cache.ptr(), len);
 		ofs += len;
 	}
 
@@ -83,6 +83,7 @@ private:
 	SceneReplicationInterface *multiplayer_replicator = nullptr;
 
 	Vector<uint8_t> packet_cache;
+	LocalVector<uint8_t> arg_cache;
 
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
@@ -30,6 +30,7 @@
 
 #include "skeleton_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/type_info.h"
 #include "scene/3d/physics_body_3d.h"
 #include "scene/resources/surface_tool.h"
@@ -65,6 +66,9 @@ SkinReference::~SkinReference() {
 
 ///////////////////////////////////////
 
+bool Skeleton3D::threaded_update = false;
+LocalVector<ObjectID> Skeleton3D::threaded_update_queue;
+
 bool Skeleton3D::_set(const StringName &p_path, const Variant &p_value) {
 	String path = p_path;
 
@@ -233,9 +237,144 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
+	// Lay out the bones depth-first, so the descendants of each bone are contiguous.
+	process_order.resize(len);
+	process_order_parents.resize(len);
+	process_order_ends.resize(len);
+	bone_slots.resize(len);
+	for (int i = 0; i < len; i++) {
+		bone_slots[i] = -1;
+	}
+
+	LocalVector<int> stack;
+	int slot = 0;
+	for (int i = 0; i < len; i++) {
+		// Parentless bones first, then any bone left unreachable by a broken hierarchy.
+		int root = i < parentless_bones.size() ? parentless_bones[i] : -1;
+		if (root < 0) {
+			for (int j = 0; j < len; j++) {
+				if (bone_slots[j] < 0) {
+					root = j;
+					break;
+				}
+			}
+			if (root < 0) {
+				break;
+			}
+		}
+
+		stack.push_back(root);
+		while (stack.size()) {
+			int bone = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+
+			bone_slots[bone] = slot;
+			process_order[slot] = bone;
+			int parent = bonesptr[bone].parent;
+			process_order_parents[slot] = (bone != root && parent >= 0) ? bone_slots[parent] : -1;
+			slot++;
+
+			const Vector<int> &children = bonesptr[bone].child_bones;
+			for (int j = children.size() - 1; j >= 0; j--) {
+				if (bone_slots[children[j]] < 0) {
+					stack.push_back(children[j]);
+				}
+			}
+		}
+	}
+
+	// Descendants end where the next bone that isn't a descendant starts.
+	for (int i = len - 1; i >= 0; i--) {
+		process_order_ends[i] = i + 1;
+	}
+	for (int i = len - 1; i >= 0; i--) {
+		int parent = process_order_parents[i];
+		if (parent >= 0) {
+			process_order_ends[parent] = MAX(process_order_ends[parent], process_order_ends[i]);
+		}
+	}
+
+	local_poses.resize(len);
+	local_rests.resize(len);
+	global_pose_override_amounts.resize(len);
+	global_pose_overrides.resize(len);
+	global_poses.resize(len);
+	global_poses_no_override.resize(len);
+	global_rests.resize(len);
+
+	// Slots moved, so everything has to be propagated again.
+	rest_dirty = true;
+	threaded_update_ready = false;
+
 	process_order_dirty = false;
 }
 
+void Skeleton3D::_update_skins() {
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
+
+	for (SkinReference *E : skin_bindings) {
+		const Skin *skin = E->skin.operator->();
+		RID skeleton = E->skeleton;
+		uint32_t bind_count = skin->get_bind_count();
+
+		if (E->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
+			E->bind_count = bind_count;
+			E->skin_bone_indices.resize(bind_count);
+			E->skin_bone_indices_ptrs = E->skin_bone_indices.ptrw();
+		}
+
+		if (E->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					// Bind name used, use this.
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
+						}
+					}
+
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->skin_bone_indices_ptrs[i] = 0;
+				}
+			}
+
+			E->skeleton_version = version;
+		}
+
+		// Upload all the bones of the skin at once.
+		E->bone_transforms.resize(bind_count);
+		Transform3D *transforms = E->bone_transforms.ptrw();
+		const Transform3D *poses = global_poses.ptr();
+		const int *slots = bone_slots.ptr();
+		for (uint32_t i = 0; i < bind_count; i++) {
+			uint32_t bone_index = E->skin_bone_indices_ptrs[i];
+			ERR_CONTINUE(bone_index >= (uint32_t)len);
+			transforms[i] = poses[slots[bone_index]] * skin->get_bind_pose(i);
+		}
+		RS::get_singleton()->skeleton_set_bone_transforms(skeleton, E->bone_transforms);
+	}
+}
+
 void Skeleton3D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE: {
@@ -244,70 +383,18 @@ void Skeleton3D::_notification(int p_what) {
 			}
 		} break;
 		case NOTIFICATION_UPDATE_SKELETON: {
-			RenderingServer *rs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-
-			int len = bones.size();
 			dirty = false;
 
-			// Update bone transforms.
-			force_update_all_bone_transforms();
-
-			// Update skins.
-			for (SkinReference *E : skin_bindings) {
-				const Skin *skin = E->skin.operator->();
-				RID skeleton = E->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
-					E->bind_count = bind_count;
-					E->skin_bone_indices.resize(bind_count);
-					E->skin_bone_indices_ptrs = E->skin_bone_indices.ptrw();
-				}
-
-				if (E->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							// Bind name used, use this.
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->skin_bone_indices_ptrs[i] = 0;
-						}
-					}
+			// Update bone transforms, unless a threaded update already did.
+			if (threaded_update_ready) {
+				threaded_update_ready = false;
+				_emit_bone_pose_changed(0, process_order.size());
+			} else {
+				force_update_all_bone_transforms();
+			}
 
-					E->skeleton_version = version;
-				}
+			_update_skins();
 
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
-				}
-			}
 			emit_signal(SceneStringNames::get_singleton()->pose_updated);
 		} break;
 
@@ -363,7 +450,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	if (dirty) {
 		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
 	}
-	return bones[p_bone].pose_global;
+	return global_poses[bone_slots[p_bone]];
 }
 
 Transform3D Skeleton3D::get_bone_global_pose_no_override(int p_bone) const {
@@ -372,7 +459,7 @@ Transform3D Skeleton3D::get_bone_global_pose_no_override(int p_bone) const {
 	if (dirty) {
 		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
 	}
-	return bones[p_bone].pose_global_no_override;
+	return global_poses_no_override[bone_slots[p_bone]];
 }
 
 void Skeleton3D::set_motion_scale(float p_motion_scale) {
@@ -530,7 +617,7 @@ Transform3D Skeleton3D::get_bone_global_rest(int p_bone) const {
 	if (rest_dirty) {
 		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
 	}
-	return bones[p_bone].global_rest;
+	return global_rests[bone_slots[p_bone]];
 }
 
 void Skeleton3D::set_bone_enabled(int p_bone, bool p_enabled) {
@@ -639,12 +726,25 @@ Transform3D Skeleton3D::get_bone_pose(int p_bone) const {
 }
 
 void Skeleton3D::_make_dirty() {
+	threaded_update_ready = false;
 	if (dirty) {
 		return;
 	}
 
 	if (is_inside_tree()) {
-		notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON);
+		if (threaded_update && Thread::is_main_thread()) {
+			// A synchronous update (e.g. from get_bone_global_pose()) clears the dirty flag but leaves the skeleton
+			// queued, so it must not be pushed again or two workers would update it at the same time.
+			if (!threaded_update_queued) {
+				if (threaded_update_queue.is_empty()) {
+					callable_mp_static(&Skeleton3D::flush_threaded_updates).call_deferred();
+				}
+				threaded_update_queue.push_back(get_instance_id());
+				threaded_update_queued = true;
+			}
+		} else {
+			notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON);
+		}
 	}
 	dirty = true;
 }
@@ -914,10 +1014,8 @@ void Skeleton3D::force_update_all_dirty_bones() {
 
 void Skeleton3D::force_update_all_bone_transforms() {
 	_update_process_order();
-
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_global_poses(0, process_order.size());
+	_emit_bone_pose_changed(0, process_order.size());
 	rest_dirty = false;
 }
 
@@ -925,56 +1023,141 @@ void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
-	Bone *bonesptr = bones.ptrw();
-	List<int> bones_to_process = List<int>();
-	bones_to_process.push_back(p_bone_idx);
-
-	while (bones_to_process.size() > 0) {
-		int current_bone_idx = bones_to_process[0];
-		bones_to_process.erase(current_bone_idx);
-
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
+	_update_process_order();
+	const int slot = bone_slots[p_bone_idx];
+	_update_global_poses(slot, process_order_ends[slot]);
+	_emit_bone_pose_changed(slot, process_order_ends[slot]);
+}
 
-		if (bone_enabled) {
+void Skeleton3D::_update_global_poses(uint32_t p_begin, uint32_t p_end) {
+	Bone *bonesptr = bones.ptrw();
+	const int *order = process_order.ptr();
+	const int *parents = process_order_parents.ptr();
+	Transform3D *locals = local_poses.ptr();
+	Transform3D *local_rest_ptr = local_rests.ptr();
+	real_t *override_amounts = global_pose_override_amounts.ptr();
+	Transform3D *overrides = global_pose_overrides.ptr();
+	Transform3D *globals = global_poses.ptr();
+	Transform3D *globals_no_override = global_poses_no_override.ptr();
+	Transform3D *rests = global_rests.ptr();
+	const bool update_rests = rest_dirty;
+
+	// Gather the local transforms, so the propagation below only walks flat arrays.
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		Bone &b = bonesptr[order[i]];
+		if (b.enabled && !show_rest_only) {
 			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
-
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * pose;
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
-			} else {
-				b.pose_global = pose;
-				b.pose_global_no_override = pose;
-			}
+			locals[i] = b.pose_cache;
 		} else {
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
-			} else {
-				b.pose_global = b.rest;
-				b.pose_global_no_override = b.rest;
-			}
+			locals[i] = b.rest;
 		}
-		if (rest_dirty) {
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
+		if (update_rests) {
+			local_rest_ptr[i] = b.rest;
 		}
 
+		override_amounts[i] = b.global_pose_override_amount;
 		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			overrides[i] = b.global_pose_override;
 		}
-
 		if (b.global_pose_override_reset) {
 			b.global_pose_override_amount = 0.0;
 		}
+	}
 
-		// Add the bone's children to the list of bones to be processed.
-		int child_bone_size = b.child_bones.size();
-		for (int i = 0; i < child_bone_size; i++) {
-			bones_to_process.push_back(b.child_bones[i]);
+	// Parents always come before their children, so a single linear pass is enough.
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		const int parent = parents[i];
+		if (parent >= 0) {
+			globals[i] = globals[parent] * locals[i];
+			globals_no_override[i] = globals_no_override[parent] * locals[i];
+		} else {
+			globals[i] = locals[i];
+			globals_no_override[i] = locals[i];
 		}
+		if (override_amounts[i] >= CMP_EPSILON) {
+			globals[i] = globals[i].interpolate_with(overrides[i], override_amounts[i]);
+		}
+	}
 
-		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, current_bone_idx);
+	if (update_rests) {
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			const int parent = parents[i];
+			rests[i] = parent >= 0 ? rests[parent] * local_rest_ptr[i] : local_rest_ptr[i];
+		}
+	}
+}
+
+void Skeleton3D::_emit_bone_pose_changed(uint32_t p_begin, uint32_t p_end) {
+	// Slots are laid out depth-first, but signals keep going out breadth-first per root, as they always did.
+	LocalVector<uint32_t> queue;
+	for (uint32_t root = p_begin; root < p_end; root = process_order_ends[root]) {
+		queue.clear();
+		queue.push_back(root);
+		for (uint32_t i = 0; i < queue.size(); i++) {
+			uint32_t slot = queue[i];
+			emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, process_order[slot]);
+			// Direct children follow their parent, each one after the subtree of the previous.
+			for (uint32_t child = slot + 1; child < (uint32_t)process_order_ends[slot]; child = process_order_ends[child]) {
+				queue.push_back(child);
+			}
+		}
+	}
+}
+
+void Skeleton3D::set_threaded_update_enabled(bool p_enabled) {
+	threaded_update = p_enabled;
+}
+
+bool Skeleton3D::is_threaded_update_enabled() {
+	return threaded_update;
+}
+
+uint32_t Skeleton3D::get_threaded_update_queue_size() {
+	return threaded_update_queue.size();
+}
+
+void Skeleton3D::_threaded_update_global_poses(void *p_userdata, uint32_t p_index) {
+	Skeleton3D *skeleton = ((Skeleton3D **)p_userdata)[p_index];
+	skeleton->_update_process_order();
+	skeleton->_update_global_poses(0, skeleton->process_order.size());
+	skeleton->rest_dirty = false;
+	skeleton->threaded_update_ready = true;
+}
+
+void Skeleton3D::flush_threaded_updates() {
+	if (threaded_update_queue.is_empty()) {
+		return;
+	}
+
+	LocalVector<ObjectID> queue;
+	SWAP(queue, threaded_update_queue);
+
+	LocalVector<ObjectID> ids;
+	LocalVector<Skeleton3D *> skeletons;
+	for (const ObjectID &id : queue) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		if (!skeleton || !skeleton->threaded_update_queued) {
+			continue;
+		}
+		skeleton->threaded_update_queued = false;
+		if (skeleton->dirty && skeleton->is_inside_tree()) {
+			ids.push_back(id);
+			skeletons.push_back(skeleton);
+		}
+	}
+
+	// Skeletons are independent from each other, so their global poses can be propagated in parallel.
+	if (skeletons.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Skeleton3D::_threaded_update_global_poses, skeletons.ptr(), skeletons.size(), -1, true, SNAME("Skeleton3DUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// Skins and signals are updated on the main thread. Signal callbacks may free or modify skeletons, so look them up again.
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(ids[i]));
+		if (skeleton && skeleton->dirty) {
+			skeleton->notification(NOTIFICATION_UPDATE_SKELETON);
+		}
 	}
 }
 
@@ -31,6 +31,7 @@
 #ifndef SKELETON_3D_H
 #define SKELETON_3D_H
 
+#include "core/templates/local_vector.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/skin.h"
 
@@ -50,6 +51,7 @@ class SkinReference : public RefCounted {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs = nullptr;
+	Vector<Transform3D> bone_transforms;
 
 protected:
 	static void _bind_methods();
@@ -76,7 +78,6 @@ private:
 		int parent;
 
 		Transform3D rest;
-		Transform3D global_rest;
 
 		_FORCE_INLINE_ void update_pose_cache() {
 			if (pose_cache_dirty) {
@@ -91,9 +92,6 @@ private:
 		Quaternion pose_rotation;
 		Vector3 pose_scale = Vector3(1, 1, 1);
 
-		Transform3D pose_global;
-		Transform3D pose_global_no_override;
-
 		real_t global_pose_override_amount = 0.0;
 		bool global_pose_override_reset = false;
 		Transform3D global_pose_override;
@@ -127,10 +125,35 @@ private:
 	Vector<int> parentless_bones;
 	HashMap<String, int> name_to_bone_index;
 
+	// Global pose data is kept as flat arrays in process order, which is a
+	// depth-first traversal of the hierarchy: every bone comes after its
+	// parent and the descendants of a bone occupy a contiguous range of slots.
+	LocalVector<int> process_order; // Bone index of each slot.
+	LocalVector<int> process_order_parents; // Slot of the parent of each slot, -1 if parentless.
+	LocalVector<int> process_order_ends; // One past the last descendant slot of each slot.
+	LocalVector<int> bone_slots; // Slot of each bone index.
+	LocalVector<Transform3D> local_poses;
+	LocalVector<Transform3D> local_rests;
+	LocalVector<real_t> global_pose_override_amounts;
+	LocalVector<Transform3D> global_pose_overrides;
+	LocalVector<Transform3D> global_poses;
+	LocalVector<Transform3D> global_poses_no_override;
+	LocalVector<Transform3D> global_rests;
+
+	void _update_global_poses(uint32_t p_begin, uint32_t p_end);
+	void _emit_bone_pose_changed(uint32_t p_begin, uint32_t p_end);
+	void _update_skins();
+
 	void _make_dirty();
 	bool dirty = false;
 	bool rest_dirty = false;
 
+	static bool threaded_update;
+	static LocalVector<ObjectID> threaded_update_queue;
+	bool threaded_update_ready = false;
+	bool threaded_update_queued = false;
+	static void _threaded_update_global_poses(void *p_userdata, uint32_t p_index);
+
 	bool show_rest_only = false;
 	float motion_scale = 1.0;
 
@@ -215,6 +238,11 @@ public:
 	void force_update_all_bone_transforms();
 	void force_update_bone_children_transforms(int bone_idx);
 
+	static void set_threaded_update_enabled(bool p_enabled);
+	static bool is_threaded_update_enabled();
+	static void flush_threaded_updates();
+	static uint32_t get_threaded_update_queue_size();
+
 	// Physical bone API
 
 	void set_animate_physical_bones(bool p_enabled);
@@ -32,10 +32,13 @@
 #include "animation_mixer.compat.inc"
 
 #include "core/config/engine.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/main/viewport.h"
 #include "scene/resources/animation.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
@@ -120,6 +123,13 @@ void AnimationMixer::_validate_property(PropertyInfo &p_property) const {
 		p_property.usage |= PROPERTY_USAGE_READ_ONLY;
 	}
 #endif // TOOLS_ENABLED
+	if (p_property.name == "lod_priority" && lod_mode != ANIMATION_LOD_MODE_PRIORITY) {
+		p_property.usage = PROPERTY_USAGE_NO_EDITOR;
+	} else if (p_property.name.begins_with("lod_distance_") && lod_mode != ANIMATION_LOD_MODE_CAMERA_DISTANCE) {
+		p_property.usage = PROPERTY_USAGE_NO_EDITOR;
+	} else if (p_property.name != "lod_mode" && p_property.name.begins_with("lod_") && lod_mode == ANIMATION_LOD_MODE_DISABLED) {
+		p_property.usage = PROPERTY_USAGE_NO_EDITOR;
+	}
 }
 
 /* -------------------------------------------- */
@@ -927,6 +937,7 @@ bool AnimationMixer::_update_caches() {
 /* -------------------------------------------- */
 
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
+	_finish_threaded_blend(); // A blend queued for the worker threads must not be interleaved with this one.
 	_blend_init();
 	if (_blend_pre_process(p_delta, track_count, track_map)) {
 		_blend_capture(p_delta);
@@ -940,7 +951,7 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 
 Variant AnimationMixer::post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx) {
 	Variant res;
-	if (GDVIRTUAL_CALL(_post_process_key_value, p_anim, p_track, p_value, p_object_id, p_object_sub_idx, res)) {
+	if (!threaded_blend_sampling && GDVIRTUAL_CALL(_post_process_key_value, p_anim, p_track, p_value, p_object_id, p_object_sub_idx, res)) {
 		return res;
 	}
 	return _post_process_key_value(p_anim, p_track, p_value, p_object_id, p_object_sub_idx);
@@ -1092,7 +1103,7 @@ void AnimationMixer::_blend_calc_total_weight() {
 	}
 }
 
-void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
+void AnimationMixer::_blend_process(double p_delta, bool p_update_only, BlendProcessStage p_stage) {
 	// Apply value/transform/blend/bezier blends to track caches and execute method/audio/animation tracks.
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
@@ -1110,6 +1121,17 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifndef _3D_DISABLED
 		bool calc_root = !seeked || is_external_seeking;
 #endif // _3D_DISABLED
+		// Decode all compressed tracks at once, instead of one by one in the track loop.
+		// With the pose cache, mixers playing the same animation at about the same time share their samples.
+		const Animation::SampledPose *pose = nullptr;
+		if (p_stage != BLEND_PROCESS_STAGE_DISPATCH) {
+			if (pose_cache_enabled) {
+				pose = _sample_cached_pose(a, time);
+			} else if (a->is_compressed()) {
+				a->sample_compressed_tracks(time, sampled_pose);
+				pose = &sampled_pose;
+			}
+		}
 
 		for (int i = 0; i < a->get_track_count(); i++) {
 			if (!a->track_is_enabled(i)) {
@@ -1121,6 +1143,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			}
 			TrackCache *track = track_cache[thash];
 			ERR_CONTINUE(!track_map.has(track->path));
+			if (lod_masking && lod_masked_tracks.has(track->path)) {
+				continue;
+			}
 			int blend_idx = track_map[track->path];
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights.size() ? track_weights[blend_idx] * weight : weight;
@@ -1133,6 +1158,12 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				blend = blend / track->total_weight;
 			}
 			Animation::TrackType ttype = a->track_get_type(i);
+			if (p_stage != BLEND_PROCESS_STAGE_ALL) {
+				bool is_sampled = track->type == Animation::TYPE_POSITION_3D || track->type == Animation::TYPE_BLEND_SHAPE || (track->type == Animation::TYPE_VALUE && static_cast<TrackCacheValue *>(track)->is_continuous);
+				if (is_sampled != (p_stage == BLEND_PROCESS_STAGE_SAMPLE)) {
+					continue;
+				}
+			}
 			track->root_motion = root_motion_track == a->track_get_path(i);
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
@@ -1214,9 +1245,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
-						if (err != OK) {
-							continue;
+						if (pose && pose->valid[i]) {
+							loc = Vector3(pose->x[i], pose->y[i], pose->z[i]);
+						} else {
+							Error err = a->try_position_track_interpolate(i, time, &loc);
+							if (err != OK) {
+								continue;
+							}
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
 						t->loc += (loc - t->init_loc) * blend;
@@ -1301,9 +1336,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
-						if (err != OK) {
-							continue;
+						if (pose && pose->valid[i]) {
+							rot = Quaternion(pose->x[i], pose->y[i], pose->z[i], pose->w[i]);
+						} else {
+							Error err = a->try_rotation_track_interpolate(i, time, &rot);
+							if (err != OK) {
+								continue;
+							}
 						}
 						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
 						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
@@ -1389,9 +1428,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
-						if (err != OK) {
-							continue;
+						if (pose && pose->valid[i]) {
+							scale = Vector3(pose->x[i], pose->y[i], pose->z[i]);
+						} else {
+							Error err = a->try_scale_track_interpolate(i, time, &scale);
+							if (err != OK) {
+								continue;
+							}
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
 						t->scale += (scale - t->init_scale) * blend;
@@ -1405,10 +1448,14 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
-					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-					if (err != OK) {
-						continue;
+					if (pose && pose->valid[i]) {
+						value = pose->x[i];
+					} else {
+						Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+						if (err != OK) {
+							continue;
+						}
 					}
 					value = post_process_key_value(a, i, value, t->object_id, t->shape_index);
 					t->value += (value - t->init_value) * blend;
@@ -1673,6 +1720,9 @@ void AnimationMixer::_blend_apply() {
 		if (!deterministic && Math::is_zero_approx(track->total_weight)) {
 			continue;
 		}
+		if (lod_masking && lod_masked_tracks.has(track->path)) {
+			continue;
+		}
 		switch (track->type) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -1685,45 +1735,36 @@ void AnimationMixer::_blend_apply() {
 					root_motion_position_accumulator = t->loc;
 					root_motion_rotation_accumulator = t->rot;
 					root_motion_scale_accumulator = t->scale;
-				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
-					Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
-					if (!t_skeleton) {
-						return;
-					}
-					if (t->loc_used) {
-						t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
-					}
-					if (t->rot_used) {
-						t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
-					}
-					if (t->scale_used) {
-						t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
+				} else {
+					if (lod_step < 1.0 && t->lod_valid) {
+						t->lod_loc = t->lod_loc.lerp(t->loc, lod_step);
+						t->lod_rot = t->lod_rot.slerp(t->rot, lod_step);
+						t->lod_scale = t->lod_scale.lerp(t->scale, lod_step);
+					} else {
+						t->lod_loc = t->loc;
+						t->lod_rot = t->rot;
+						t->lod_scale = t->scale;
+						t->lod_valid = true;
 					}
-
-				} else if (!t->skeleton_id.is_valid()) {
-					Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(t->object_id));
-					if (!t_node_3d) {
+					if (!_apply_transform_track(t)) {
 						return;
 					}
-					if (t->loc_used) {
-						t_node_3d->set_position(t->loc);
-					}
-					if (t->rot_used) {
-						t_node_3d->set_rotation(t->rot.get_euler());
-					}
-					if (t->scale_used) {
-						t_node_3d->set_scale(t->scale);
-					}
 				}
 #endif // _3D_DISABLED
 			} break;
 			case Animation::TYPE_BLEND_SHAPE: {
 #ifndef _3D_DISABLED
 				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				if (lod_step < 1.0 && t->lod_valid) {
+					t->lod_value = Math::lerp(t->lod_value, t->value, (float)lod_step);
+				} else {
+					t->lod_value = t->value;
+					t->lod_valid = true;
+				}
 
 				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
 				if (t_mesh_3d) {
-					t_mesh_3d->set_blend_shape_value(t->shape_index, t->value);
+					t_mesh_3d->set_blend_shape_value(t->shape_index, t->lod_value);
 				}
 #endif // _3D_DISABLED
 			} break;
@@ -1815,7 +1856,44 @@ void AnimationMixer::_blend_apply() {
 			} // The rest don't matter.
 		}
 	}
+	lod_step = 1.0;
+}
+
+#ifndef _3D_DISABLED
+bool AnimationMixer::_apply_transform_track(TrackCacheTransform *p_track) {
+	if (p_track->skeleton_id.is_valid() && p_track->bone_idx >= 0) {
+		Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(p_track->skeleton_id));
+		if (!t_skeleton) {
+			return false;
+		}
+		if (p_track->loc_used) {
+			t_skeleton->set_bone_pose_position(p_track->bone_idx, p_track->lod_loc);
+		}
+		if (p_track->rot_used) {
+			t_skeleton->set_bone_pose_rotation(p_track->bone_idx, p_track->lod_rot);
+		}
+		if (p_track->scale_used) {
+			t_skeleton->set_bone_pose_scale(p_track->bone_idx, p_track->lod_scale);
+		}
+
+	} else if (!p_track->skeleton_id.is_valid()) {
+		Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(p_track->object_id));
+		if (!t_node_3d) {
+			return false;
+		}
+		if (p_track->loc_used) {
+			t_node_3d->set_position(p_track->lod_loc);
+		}
+		if (p_track->rot_used) {
+			t_node_3d->set_rotation(p_track->lod_rot.get_euler());
+		}
+		if (p_track->scale_used) {
+			t_node_3d->set_scale(p_track->lod_scale);
+		}
+	}
+	return true;
 }
+#endif // _3D_DISABLED
 
 void AnimationMixer::_call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred) {
 	// Separate function to use alloca() more efficiently
@@ -1864,6 +1942,438 @@ void AnimationMixer::clear_caches() {
 	_clear_caches();
 }
 
+/* -------------------------------------------- */
+/* -- Level of detail ------------------------- */
+/* -------------------------------------------- */
+
+SafeNumeric<uint64_t> AnimationMixer::lod_stats_frame;
+SafeNumeric<uint32_t> AnimationMixer::lod_stats_processed[2];
+SafeNumeric<uint32_t> AnimationMixer::lod_stats_skipped[2];
+BinaryMutex AnimationMixer::lod_stats_mutex;
+
+void AnimationMixer::set_lod_mode(AnimationLODMode p_mode) {
+	lod_mode = p_mode;
+	lod_update_interval = 1;
+	lod_frames_left = 0;
+	lod_delta_accumulator = 0.0;
+	lod_step = 1.0;
+	lod_masking = false;
+	notify_property_list_changed();
+}
+
+AnimationMixer::AnimationLODMode AnimationMixer::get_lod_mode() const {
+	return lod_mode;
+}
+
+void AnimationMixer::set_lod_priority(real_t p_priority) {
+	lod_priority = CLAMP(p_priority, 0.0, 1.0);
+}
+
+real_t AnimationMixer::get_lod_priority() const {
+	return lod_priority;
+}
+
+void AnimationMixer::set_lod_distance_begin(real_t p_distance) {
+	lod_distance_begin = MAX(0.0, p_distance);
+}
+
+real_t AnimationMixer::get_lod_distance_begin() const {
+	return lod_distance_begin;
+}
+
+void AnimationMixer::set_lod_distance_end(real_t p_distance) {
+	lod_distance_end = MAX(0.0, p_distance);
+}
+
+real_t AnimationMixer::get_lod_distance_end() const {
+	return lod_distance_end;
+}
+
+void AnimationMixer::set_lod_max_update_interval(int p_interval) {
+	ERR_FAIL_COND(p_interval < 1);
+	lod_max_update_interval = p_interval;
+}
+
+int AnimationMixer::get_lod_max_update_interval() const {
+	return lod_max_update_interval;
+}
+
+void AnimationMixer::set_lod_interpolate(bool p_interpolate) {
+	lod_interpolate = p_interpolate;
+}
+
+bool AnimationMixer::is_lod_interpolate() const {
+	return lod_interpolate;
+}
+
+void AnimationMixer::set_lod_masked_tracks(const TypedArray<NodePath> &p_tracks) {
+	lod_masked_tracks.clear();
+	for (int i = 0; i < p_tracks.size(); i++) {
+		lod_masked_tracks.insert(p_tracks[i]);
+	}
+}
+
+TypedArray<NodePath> AnimationMixer::get_lod_masked_tracks() const {
+	TypedArray<NodePath> ret;
+	for (const NodePath &E : lod_masked_tracks) {
+		ret.push_back(E);
+	}
+	return ret;
+}
+
+int AnimationMixer::get_lod_update_interval() const {
+	return lod_update_interval;
+}
+
+uint32_t AnimationMixer::get_lod_processed_count() {
+	return _lod_stats_get(lod_stats_processed);
+}
+
+uint32_t AnimationMixer::get_lod_skipped_count() {
+	return _lod_stats_get(lod_stats_skipped);
+}
+
+uint32_t AnimationMixer::_lod_stats_get(SafeNumeric<uint32_t> *p_stats) {
+	// The counters only roll over when a mixer is processed, so frames in which none was
+	// must not report the counts of an older frame.
+	MutexLock lock(lod_stats_mutex);
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	uint64_t last_frame = lod_stats_frame.get();
+	if (last_frame == frame) {
+		return p_stats[1].get();
+	} else if (last_frame + 1 == frame) {
+		return p_stats[0].get();
+	}
+	return 0;
+}
+
+void AnimationMixer::_lod_stats_count(bool p_skipped) {
+	// Mixers may be processed from several threads at once, so the counters are atomic
+	// and only the (once per frame) rollover takes the lock.
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	if (frame != lod_stats_frame.get()) {
+		MutexLock lock(lod_stats_mutex);
+		uint64_t last_frame = lod_stats_frame.get();
+		if (frame != last_frame) {
+			// Keep the counts of the last complete frame around for the monitors.
+			lod_stats_processed[1].set(frame == last_frame + 1 ? lod_stats_processed[0].get() : 0);
+			lod_stats_skipped[1].set(frame == last_frame + 1 ? lod_stats_skipped[0].get() : 0);
+			lod_stats_processed[0].set(0);
+			lod_stats_skipped[0].set(0);
+			lod_stats_frame.set(frame);
+		}
+	}
+	if (p_skipped) {
+		lod_stats_skipped[0].increment();
+	} else {
+		lod_stats_processed[0].increment();
+	}
+}
+
+real_t AnimationMixer::_get_lod_factor() const {
+	switch (lod_mode) {
+		case ANIMATION_LOD_MODE_CAMERA_DISTANCE: {
+#ifndef _3D_DISABLED
+			const Node3D *root_3d = Object::cast_to<Node3D>(get_node_or_null(root_node));
+			const Camera3D *camera = get_viewport() ? get_viewport()->get_camera_3d() : nullptr;
+			if (!root_3d || !camera) {
+				return 0.0;
+			}
+			real_t distance = camera->get_global_position().distance_to(root_3d->get_global_position());
+			if (lod_distance_end <= lod_distance_begin) {
+				return distance >= lod_distance_end ? 1.0 : 0.0;
+			}
+			return CLAMP((distance - lod_distance_begin) / (lod_distance_end - lod_distance_begin), 0.0, 1.0);
+#else
+			return 0.0;
+#endif // _3D_DISABLED
+		} break;
+		case ANIMATION_LOD_MODE_PRIORITY: {
+			return 1.0 - lod_priority;
+		} break;
+		default: {
+		} break;
+	}
+	return 0.0;
+}
+
+bool AnimationMixer::_lod_skip_frame(double p_delta, double &r_delta) {
+	if (lod_mode == ANIMATION_LOD_MODE_DISABLED) {
+		r_delta = p_delta;
+		_lod_stats_count(false);
+		return false;
+	}
+
+	lod_delta_accumulator += p_delta;
+	if (lod_frames_left > 1) {
+		lod_frames_left--;
+		if (lod_interpolate) {
+			// Keep moving towards the last blended values, so they are reached right before the next update.
+			lod_step = 1.0 / lod_frames_left;
+			_lod_apply_interpolated();
+		}
+		_lod_stats_count(true);
+		return true;
+	}
+
+	real_t factor = _get_lod_factor();
+	lod_update_interval = 1 + (int)Math::round(factor * (lod_max_update_interval - 1));
+	lod_masking = factor >= 1.0 && !lod_masked_tracks.is_empty();
+	lod_frames_left = lod_update_interval;
+	lod_step = lod_interpolate ? 1.0 / lod_update_interval : 1.0;
+
+	r_delta = lod_delta_accumulator;
+	lod_delta_accumulator = 0.0;
+	_lod_stats_count(false);
+	return false;
+}
+
+void AnimationMixer::_lod_apply_interpolated() {
+	if (!cache_valid) {
+		return;
+	}
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		TrackCache *track = K.value;
+		if (!deterministic && Math::is_zero_approx(track->total_weight)) {
+			continue;
+		}
+		if (lod_masking && lod_masked_tracks.has(track->path)) {
+			continue;
+		}
+		switch (track->type) {
+			case Animation::TYPE_POSITION_3D: {
+#ifndef _3D_DISABLED
+				TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+				if (t->root_motion || !t->lod_valid) {
+					continue;
+				}
+				t->lod_loc = t->lod_loc.lerp(t->loc, lod_step);
+				t->lod_rot = t->lod_rot.slerp(t->rot, lod_step);
+				t->lod_scale = t->lod_scale.lerp(t->scale, lod_step);
+				if (!_apply_transform_track(t)) {
+					return;
+				}
+#endif // _3D_DISABLED
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+#ifndef _3D_DISABLED
+				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
+				if (!t->lod_valid) {
+					continue;
+				}
+				t->lod_value = Math::lerp(t->lod_value, t->value, (float)lod_step);
+				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
+				if (t_mesh_3d) {
+					t_mesh_3d->set_blend_shape_value(t->shape_index, t->lod_value);
+				}
+#endif // _3D_DISABLED
+			} break;
+			default: {
+			} break;
+		}
+	}
+	lod_step = 1.0;
+}
+
+/* -------------------------------------------- */
+/* -- Pose cache ------------------------------ */
+/* -------------------------------------------- */
+
+bool AnimationMixer::pose_cache_enabled = false;
+double AnimationMixer::pose_cache_step = 1.0 / 60.0;
+BinaryMutex AnimationMixer::pose_cache_mutex;
+HashMap<AnimationMixer::PoseCacheKey, Animation::SampledPose, AnimationMixer::PoseCacheKey> AnimationMixer::pose_cache;
+uint64_t AnimationMixer::pose_cache_frame = 0;
+uint32_t AnimationMixer::pose_cache_hits[2] = { 0, 0 };
+uint32_t AnimationMixer::pose_cache_misses[2] = { 0, 0 };
+
+void AnimationMixer::set_pose_cache_enabled(bool p_enabled) {
+	pose_cache_enabled = p_enabled;
+}
+
+bool AnimationMixer::is_pose_cache_enabled() {
+	return pose_cache_enabled;
+}
+
+void AnimationMixer::set_pose_cache_fps(int p_fps) {
+	ERR_FAIL_COND(p_fps <= 0);
+	pose_cache_step = 1.0 / p_fps;
+}
+
+int AnimationMixer::get_pose_cache_fps() {
+	return (int)Math::round(1.0 / pose_cache_step);
+}
+
+uint32_t AnimationMixer::get_pose_cache_hit_count() {
+	return pose_cache_hits[1];
+}
+
+uint32_t AnimationMixer::get_pose_cache_miss_count() {
+	return pose_cache_misses[1];
+}
+
+void AnimationMixer::_pose_cache_check_frame() {
+	// Must be called with pose_cache_mutex locked.
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	if (frame == pose_cache_frame) {
+		return;
+	}
+	// Keep the counts of the last complete frame around for the monitors.
+	pose_cache_hits[1] = frame == pose_cache_frame + 1 ? pose_cache_hits[0] : 0;
+	pose_cache_misses[1] = frame == pose_cache_frame + 1 ? pose_cache_misses[0] : 0;
+	pose_cache_hits[0] = 0;
+	pose_cache_misses[0] = 0;
+	pose_cache_frame = frame;
+	// Animations may have been edited since, so poses are only shared within a frame.
+	pose_cache.clear();
+}
+
+const Animation::SampledPose *AnimationMixer::_sample_cached_pose(const Ref<Animation> &p_animation, double p_time) {
+	PoseCacheKey key;
+	key.animation = p_animation->get_instance_id();
+	key.time_bucket = (int64_t)Math::round(p_time / pose_cache_step);
+
+	{
+		MutexLock lock(pose_cache_mutex);
+		_pose_cache_check_frame();
+		const Animation::SampledPose *cached = pose_cache.getptr(key);
+		if (cached) {
+			// Entries are never moved nor removed until the next frame, so the pointer stays valid.
+			pose_cache_hits[0]++;
+			return cached;
+		}
+		pose_cache_misses[0]++;
+	}
+
+	// Sample outside of the lock, as other mixers may be sampling in parallel.
+	p_animation->sample_tracks(key.time_bucket * pose_cache_step, sampled_pose);
+
+	MutexLock lock(pose_cache_mutex);
+	if (!pose_cache.has(key)) {
+		Animation::SampledPose &cached = pose_cache[key];
+		cached.x = sampled_pose.x;
+		cached.y = sampled_pose.y;
+		cached.z = sampled_pose.z;
+		cached.w = sampled_pose.w;
+		cached.valid = sampled_pose.valid;
+	}
+	return &sampled_pose;
+}
+
+/* -------------------------------------------- */
+/* -- Threaded blending ----------------------- */
+/* -------------------------------------------- */
+
+bool AnimationMixer::threaded_blending = false;
+BinaryMutex AnimationMixer::threaded_blend_mutex;
+LocalVector<ObjectID> AnimationMixer::threaded_blend_queue[2];
+
+void AnimationMixer::set_threaded_blending_enabled(bool p_enabled) {
+	threaded_blending = p_enabled;
+}
+
+bool AnimationMixer::is_threaded_blending_enabled() {
+	return threaded_blending;
+}
+
+bool AnimationMixer::_can_blend_threaded() const {
+	if (!threaded_blending || !Thread::is_main_thread()) {
+		return false; // Mixers in sub-thread process groups keep their own thread.
+	}
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif // TOOLS_ENABLED
+	// A scripted post process can't be called from the worker threads.
+	return !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value);
+}
+
+void AnimationMixer::_process_animation_threaded(double p_delta, bool p_physics) {
+	_finish_threaded_blend();
+	_blend_init();
+	if (!_blend_pre_process(p_delta, track_count, track_map)) {
+		clear_animation_instances();
+		return;
+	}
+	_blend_capture(p_delta);
+	_blend_calc_total_weight();
+
+	// Sampling, applying and post process are done by flush_threaded_blending() once all mixers have been processed.
+	threaded_blend_delta = p_delta;
+	threaded_blend_pending = true;
+
+	MutexLock lock(threaded_blend_mutex);
+	threaded_blend_queue[p_physics ? 1 : 0].push_back(get_instance_id());
+}
+
+void AnimationMixer::_finish_threaded_blend(bool p_sampled) {
+	if (!threaded_blend_pending) {
+		return;
+	}
+	threaded_blend_pending = false;
+
+	if (!p_sampled) {
+		_blend_process(threaded_blend_delta, false, BLEND_PROCESS_STAGE_SAMPLE);
+	}
+	_blend_process(threaded_blend_delta, false, BLEND_PROCESS_STAGE_DISPATCH);
+	_blend_apply();
+	_blend_post_process();
+	clear_animation_instances();
+}
+
+void AnimationMixer::_threaded_blend_sample(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_process(mixer->threaded_blend_delta, false, BLEND_PROCESS_STAGE_SAMPLE);
+}
+
+void AnimationMixer::flush_threaded_blending(bool p_physics) {
+	LocalVector<ObjectID> queue;
+	{
+		MutexLock lock(threaded_blend_mutex);
+		SWAP(queue, threaded_blend_queue[p_physics ? 1 : 0]);
+	}
+	if (queue.is_empty()) {
+		return;
+	}
+
+	LocalVector<ObjectID> ids;
+	LocalVector<AnimationMixer *> mixers;
+	ids.reserve(queue.size());
+	mixers.reserve(queue.size());
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer && mixer->threaded_blend_pending && !mixer->threaded_blend_sampling) {
+			mixer->threaded_blend_sampling = true;
+			ids.push_back(id);
+			mixers.push_back(mixer);
+		}
+	}
+	if (mixers.is_empty()) {
+		return;
+	}
+
+	// Sample and blend every mixer into its own track caches in parallel.
+	if (mixers.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_threaded_blend_sample, mixers.ptr(), mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_threaded_blend_sample(mixers.ptr(), 0);
+	}
+	for (AnimationMixer *mixer : mixers) {
+		mixer->threaded_blend_sampling = false;
+	}
+
+	// Everything touching other objects is done serially, in the order the mixers were processed.
+	for (const ObjectID &id : ids) {
+		// A previous mixer may have freed this one in its post process, so look it up again.
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer) {
+			mixer->_finish_threaded_blend(true);
+		}
+	}
+}
+
 /* -------------------------------------------- */
 /* -- Root motion ----------------------------- */
 /* -------------------------------------------- */
@@ -2130,18 +2640,29 @@ void AnimationMixer::_notification(int p_what) {
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+			double delta = 0.0;
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE && !_lod_skip_frame(get_process_delta_time(), delta)) {
+				if (_can_blend_threaded()) {
+					_process_animation_threaded(delta, false);
+				} else {
+					_process_animation(delta);
+				}
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+			double delta = 0.0;
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS && !_lod_skip_frame(get_physics_process_delta_time(), delta)) {
+				if (_can_blend_threaded()) {
+					_process_animation_threaded(delta, true);
+				} else {
+					_process_animation(delta);
+				}
 			}
 		} break;
 
 		case NOTIFICATION_EXIT_TREE: {
+			_finish_threaded_blend();
 			_clear_caches();
 		} break;
 	}
@@ -2240,6 +2761,32 @@ void AnimationMixer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_process", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_callback_mode_process", "get_callback_mode_process");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_method", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_callback_mode_method", "get_callback_mode_method");
 
+	/* ---- Level of detail ---- */
+	ClassDB::bind_method(D_METHOD("set_lod_mode", "mode"), &AnimationMixer::set_lod_mode);
+	ClassDB::bind_method(D_METHOD("get_lod_mode"), &AnimationMixer::get_lod_mode);
+	ClassDB::bind_method(D_METHOD("set_lod_priority", "priority"), &AnimationMixer::set_lod_priority);
+	ClassDB::bind_method(D_METHOD("get_lod_priority"), &AnimationMixer::get_lod_priority);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_begin", "distance"), &AnimationMixer::set_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_begin"), &AnimationMixer::get_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_end", "distance"), &AnimationMixer::set_lod_distance_end);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_end"), &AnimationMixer::get_lod_distance_end);
+	ClassDB::bind_method(D_METHOD("set_lod_max_update_interval", "interval"), &AnimationMixer::set_lod_max_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_max_update_interval"), &AnimationMixer::get_lod_max_update_interval);
+	ClassDB::bind_method(D_METHOD("set_lod_interpolate", "enabled"), &AnimationMixer::set_lod_interpolate);
+	ClassDB::bind_method(D_METHOD("is_lod_interpolate"), &AnimationMixer::is_lod_interpolate);
+	ClassDB::bind_method(D_METHOD("set_lod_masked_tracks", "tracks"), &AnimationMixer::set_lod_masked_tracks);
+	ClassDB::bind_method(D_METHOD("get_lod_masked_tracks"), &AnimationMixer::get_lod_masked_tracks);
+	ClassDB::bind_method(D_METHOD("get_lod_update_interval"), &AnimationMixer::get_lod_update_interval);
+
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_mode", PROPERTY_HINT_ENUM, "Disabled,Camera Distance,Priority"), "set_lod_mode", "get_lod_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_priority", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_lod_priority", "get_lod_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_begin", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_begin", "get_lod_distance_begin");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_end", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_end", "get_lod_distance_end");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_update_interval", PROPERTY_HINT_RANGE, "1,60,1,or_greater"), "set_lod_max_update_interval", "get_lod_max_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_interpolate"), "set_lod_interpolate", "is_lod_interpolate");
+	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "lod_masked_tracks", PROPERTY_HINT_ARRAY_TYPE, "NodePath"), "set_lod_masked_tracks", "get_lod_masked_tracks");
+
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_PROCESS_MANUAL);
@@ -2247,6 +2794,10 @@ void AnimationMixer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_METHOD_DEFERRED);
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_METHOD_IMMEDIATE);
 
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_MODE_DISABLED);
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_MODE_CAMERA_DISTANCE);
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_MODE_PRIORITY);
+
 	ADD_SIGNAL(MethodInfo(SNAME("animation_list_changed")));
 	ADD_SIGNAL(MethodInfo(SNAME("animation_libraries_updated")));
 	ADD_SIGNAL(MethodInfo(SNAME("animation_finished"), PropertyInfo(Variant::STRING_NAME, "anim_name")));
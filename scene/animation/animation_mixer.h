@@ -31,6 +31,8 @@
 #ifndef ANIMATION_MIXER_H
 #define ANIMATION_MIXER_H
 
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -61,6 +63,12 @@ public:
 		ANIMATION_CALLBACK_MODE_METHOD_IMMEDIATE,
 	};
 
+	enum AnimationLODMode {
+		ANIMATION_LOD_MODE_DISABLED,
+		ANIMATION_LOD_MODE_CAMERA_DISTANCE,
+		ANIMATION_LOD_MODE_PRIORITY,
+	};
+
 	/* ---- Data ---- */
 	struct AnimationLibraryData {
 		StringName name;
@@ -166,6 +174,11 @@ protected:
 		Vector3 loc;
 		Quaternion rot;
 		Vector3 scale;
+		// Last applied values, used to interpolate between LOD updates.
+		bool lod_valid = false;
+		Vector3 lod_loc;
+		Quaternion lod_rot;
+		Vector3 lod_scale;
 
 		TrackCacheTransform(const TrackCacheTransform &p_other) :
 				TrackCache(p_other),
@@ -200,6 +213,8 @@ protected:
 		float init_value = 0;
 		float value = 0;
 		int shape_index = -1;
+		bool lod_valid = false;
+		float lod_value = 0;
 
 		TrackCacheBlendShape(const TrackCacheBlendShape &p_other) :
 				TrackCache(p_other),
@@ -302,6 +317,7 @@ protected:
 	HashMap<NodePath, int> track_map;
 	int track_count = 0;
 	bool deterministic = false;
+	Animation::SampledPose sampled_pose;
 
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
@@ -328,6 +344,12 @@ protected:
 	virtual void _rename_animation(const StringName &p_from_name, const StringName &p_to_name);
 
 	/* ---- Blending processor ---- */
+	enum BlendProcessStage {
+		BLEND_PROCESS_STAGE_ALL,
+		BLEND_PROCESS_STAGE_SAMPLE, // Only tracks which blend into the track caches, safe to run on worker threads.
+		BLEND_PROCESS_STAGE_DISPATCH, // Only tracks which affect other objects (discrete values, methods, audio and animations).
+	};
+
 	virtual void _process_animation(double p_delta, bool p_update_only = false);
 	virtual Variant _post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx = -1);
 	Variant post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx = -1);
@@ -337,11 +359,78 @@ protected:
 	virtual bool _blend_pre_process(double p_delta, int p_track_count, const HashMap<NodePath, int> &p_track_map);
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For undeterministic blending.
-	void _blend_process(double p_delta, bool p_update_only = false);
+	void _blend_process(double p_delta, bool p_update_only = false, BlendProcessStage p_stage = BLEND_PROCESS_STAGE_ALL);
 	void _blend_apply();
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
 
+	/* ---- Level of detail ---- */
+	AnimationLODMode lod_mode = ANIMATION_LOD_MODE_DISABLED;
+	real_t lod_priority = 1.0;
+	real_t lod_distance_begin = 10.0;
+	real_t lod_distance_end = 50.0;
+	int lod_max_update_interval = 4;
+	bool lod_interpolate = true;
+	HashSet<NodePath> lod_masked_tracks;
+
+	int lod_update_interval = 1;
+	int lod_frames_left = 0;
+	double lod_delta_accumulator = 0.0;
+	real_t lod_step = 1.0; // Fraction of the way to the blended values applied by the next _blend_apply().
+	bool lod_masking = false; // Whether lod_masked_tracks are currently skipped.
+
+	static SafeNumeric<uint64_t> lod_stats_frame;
+	static SafeNumeric<uint32_t> lod_stats_processed[2]; // Current and last frame.
+	static SafeNumeric<uint32_t> lod_stats_skipped[2];
+	static BinaryMutex lod_stats_mutex;
+
+	real_t _get_lod_factor() const;
+	bool _lod_skip_frame(double p_delta, double &r_delta);
+	void _lod_apply_interpolated();
+#ifndef _3D_DISABLED
+	bool _apply_transform_track(TrackCacheTransform *p_track);
+#endif // _3D_DISABLED
+	static void _lod_stats_count(bool p_skipped);
+	static uint32_t _lod_stats_get(SafeNumeric<uint32_t> *p_stats);
+
+	/* ---- Pose cache ---- */
+	struct PoseCacheKey {
+		ObjectID animation;
+		int64_t time_bucket = 0;
+
+		static uint32_t hash(const PoseCacheKey &p_key) {
+			return hash_fmix32(hash_murmur3_one_64(p_key.time_bucket, hash_murmur3_one_64(uint64_t(p_key.animation))));
+		}
+		bool operator==(const PoseCacheKey &p_key) const {
+			return animation == p_key.animation && time_bucket == p_key.time_bucket;
+		}
+	};
+
+	static bool pose_cache_enabled;
+	static double pose_cache_step;
+	static BinaryMutex pose_cache_mutex;
+	static HashMap<PoseCacheKey, Animation::SampledPose, PoseCacheKey> pose_cache; // Only valid for the current frame.
+	static uint64_t pose_cache_frame;
+	static uint32_t pose_cache_hits[2]; // Current and last frame.
+	static uint32_t pose_cache_misses[2];
+
+	const Animation::SampledPose *_sample_cached_pose(const Ref<Animation> &p_animation, double p_time);
+	static void _pose_cache_check_frame();
+
+	/* ---- Threaded blending ---- */
+	static bool threaded_blending;
+	static BinaryMutex threaded_blend_mutex;
+	static LocalVector<ObjectID> threaded_blend_queue[2]; // Idle and physics.
+
+	bool threaded_blend_pending = false;
+	bool threaded_blend_sampling = false;
+	double threaded_blend_delta = 0.0;
+
+	bool _can_blend_threaded() const;
+	void _process_animation_threaded(double p_delta, bool p_physics);
+	void _finish_threaded_blend(bool p_sampled = false);
+	static void _threaded_blend_sample(void *p_userdata, uint32_t p_index);
+
 	/* ---- Capture feature ---- */
 	struct CaptureCache {
 		Ref<Animation> animation;
@@ -423,6 +512,46 @@ public:
 	virtual void advance(double p_time);
 	virtual void clear_caches(); ///< must be called by hand if an animation was modified after added
 
+	/* ---- Level of detail ---- */
+	void set_lod_mode(AnimationLODMode p_mode);
+	AnimationLODMode get_lod_mode() const;
+
+	void set_lod_priority(real_t p_priority);
+	real_t get_lod_priority() const;
+
+	void set_lod_distance_begin(real_t p_distance);
+	real_t get_lod_distance_begin() const;
+
+	void set_lod_distance_end(real_t p_distance);
+	real_t get_lod_distance_end() const;
+
+	void set_lod_max_update_interval(int p_interval);
+	int get_lod_max_update_interval() const;
+
+	void set_lod_interpolate(bool p_interpolate);
+	bool is_lod_interpolate() const;
+
+	void set_lod_masked_tracks(const TypedArray<NodePath> &p_tracks);
+	TypedArray<NodePath> get_lod_masked_tracks() const;
+
+	int get_lod_update_interval() const;
+
+	static uint32_t get_lod_processed_count();
+	static uint32_t get_lod_skipped_count();
+
+	/* ---- Pose cache ---- */
+	static void set_pose_cache_enabled(bool p_enabled);
+	static bool is_pose_cache_enabled();
+	static void set_pose_cache_fps(int p_fps);
+	static int get_pose_cache_fps();
+	static uint32_t get_pose_cache_hit_count();
+	static uint32_t get_pose_cache_miss_count();
+
+	/* ---- Threaded blending ---- */
+	static void set_threaded_blending_enabled(bool p_enabled);
+	static bool is_threaded_blending_enabled();
+	static void flush_threaded_blending(bool p_physics);
+
 	/* ---- Capture feature ---- */
 	void capture(const StringName &p_name, double p_duration, Tween::TransitionType p_trans_type = Tween::TRANS_LINEAR, Tween::EaseType p_ease_type = Tween::EASE_IN);
 
@@ -466,5 +595,6 @@ public:
 
 VARIANT_ENUM_CAST(AnimationMixer::AnimationCallbackModeProcess);
 VARIANT_ENUM_CAST(AnimationMixer::AnimationCallbackModeMethod);
+VARIANT_ENUM_CAST(AnimationMixer::AnimationLODMode);
 
 #endif // ANIMATION_MIXER_H
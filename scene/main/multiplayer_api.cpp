@@ -144,6 +144,33 @@ Error MultiplayerAPI::encode_and_compress_variant(const Variant &p_variant, uint
 	return OK;
 }
 
+Error MultiplayerAPI::encode_and_compress_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_allow_object_decoding) {
+	uint32_t ofs = r_buffer.size();
+
+	switch (p_variant.get_type()) {
+		case Variant::BOOL:
+		case Variant::INT: {
+			// At most 9 bytes, so write them in place.
+			int len = 0;
+			encode_and_compress_variant(p_variant, nullptr, len, p_allow_object_decoding);
+			r_buffer.resize(ofs + len);
+			return encode_and_compress_variant(p_variant, r_buffer.ptr() + ofs, len, p_allow_object_decoding);
+		}
+		default: {
+			Error err = encode_variant(p_variant, r_buffer, p_allow_object_decoding);
+			if (err != OK) {
+				r_buffer.resize(ofs);
+				return err;
+			}
+			// The first byte is not used by the marshaling, so store the type
+			// so we know how to decompress and decode this variant.
+			r_buffer[ofs] = p_variant.get_type();
+		}
+	}
+
+	return OK;
+}
+
 Error MultiplayerAPI::decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_object_decoding) {
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
@@ -250,6 +277,39 @@ Error MultiplayerAPI::encode_and_compress_variants(const Variant **p_variants, i
 	return OK;
 }
 
+Error MultiplayerAPI::encode_and_compress_variants(const Variant **p_variants, int p_count, LocalVector<uint8_t> &r_buffer, bool *r_raw, bool p_allow_object_decoding) {
+	if (p_count == 0) {
+		if (r_raw) {
+			*r_raw = true;
+		}
+		return OK;
+	}
+
+	// Try raw encoding optimization.
+	if (r_raw && p_count == 1) {
+		*r_raw = false;
+		const Variant &v = *(p_variants[0]);
+		if (v.get_type() == Variant::PACKED_BYTE_ARRAY) {
+			*r_raw = true;
+			const PackedByteArray pba = v;
+			uint32_t ofs = r_buffer.size();
+			r_buffer.resize(ofs + pba.size());
+			memcpy(r_buffer.ptr() + ofs, pba.ptr(), pba.size());
+			return OK;
+		}
+		return encode_and_compress_variant(v, r_buffer, p_allow_object_decoding);
+	}
+
+	// Regular encoding.
+	for (int i = 0; i < p_count; i++) {
+		Error err = encode_and_compress_variant(*(p_variants[i]), r_buffer, p_allow_object_decoding);
+		if (err != OK) {
+			return err;
+		}
+	}
+	return OK;
+}
+
 Error MultiplayerAPI::decode_and_decompress_variants(Vector<Variant> &r_variants, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw, bool p_allow_object_decoding) {
 	r_len = 0;
 	int argc = r_variants.size();
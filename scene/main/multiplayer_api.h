@@ -32,6 +32,7 @@
 #define MULTIPLAYER_API_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/multiplayer_peer.h"
 
 class MultiplayerAPI : public RefCounted {
@@ -58,6 +59,9 @@ public:
 	static Error encode_and_compress_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len, bool p_allow_object_decoding);
 	static Error decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_object_decoding);
 	static Error encode_and_compress_variants(const Variant **p_variants, int p_count, uint8_t *p_buffer, int &r_len, bool *r_raw = nullptr, bool p_allow_object_decoding = false);
+	// Single pass versions, append to r_buffer.
+	static Error encode_and_compress_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_allow_object_decoding);
+	static Error encode_and_compress_variants(const Variant **p_variants, int p_count, LocalVector<uint8_t> &r_buffer, bool *r_raw = nullptr, bool p_allow_object_decoding = false);
 	static Error decode_and_decompress_variants(Vector<Variant> &r_variants, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw = false, bool p_allow_object_decoding = false);
 
 	virtual Error poll() = 0;
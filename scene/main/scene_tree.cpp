@@ -43,6 +43,7 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "node.h"
+#include "scene/animation/animation_mixer.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/gui/control.h"
@@ -467,6 +468,8 @@ bool SceneTree::physics_process(double p_time) {
 
 	_process(true);
 
+	AnimationMixer::flush_threaded_blending(true);
+
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
 
@@ -507,6 +510,8 @@ bool SceneTree::process(double p_time) {
 
 	_process(false);
 
+	AnimationMixer::flush_threaded_blending(false);
+
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
 	flush_transform_notifications(); //transforms after world update, to avoid unnecessary enter/exit notifications
@@ -472,6 +472,9 @@ void register_scene_types() {
 	GDREGISTER_CLASS(MethodTweener);
 
 	GDREGISTER_ABSTRACT_CLASS(AnimationMixer);
+	AnimationMixer::set_threaded_blending_enabled(GLOBAL_DEF("animation/mixer/use_threaded_blending", false));
+	AnimationMixer::set_pose_cache_enabled(GLOBAL_DEF("animation/mixer/use_pose_cache", false));
+	AnimationMixer::set_pose_cache_fps(GLOBAL_DEF(PropertyInfo(Variant::INT, "animation/mixer/pose_cache_fps", PROPERTY_HINT_RANGE, "1,240,1,suffix:FPS"), 60));
 	GDREGISTER_CLASS(AnimationPlayer);
 	GDREGISTER_CLASS(AnimationTree);
 	GDREGISTER_CLASS(AnimationNode);
@@ -508,6 +511,7 @@ void register_scene_types() {
 	GDREGISTER_CLASS(Skin);
 	GDREGISTER_ABSTRACT_CLASS(SkinReference);
 	GDREGISTER_CLASS(Skeleton3D);
+	Skeleton3D::set_threaded_update_enabled(GLOBAL_DEF("animation/skeleton/use_threaded_update", false));
 	GDREGISTER_CLASS(ImporterMesh);
 	GDREGISTER_CLASS(ImporterMeshInstance3D);
 	GDREGISTER_VIRTUAL_CLASS(VisualInstance3D);
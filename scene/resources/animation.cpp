@@ -2150,6 +2150,10 @@ real_t Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 	ERR_FAIL_V(0);
 }
 
+bool Animation::is_compressed() const {
+	return compression.enabled;
+}
+
 bool Animation::track_is_compressed(int p_track) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
 	Track *t = tracks[p_track];
@@ -5090,17 +5094,204 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 	return true;
 }
 
-template <uint32_t COMPONENTS>
-bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
-	ERR_FAIL_COND_V(!compression.enabled, false);
-	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
+void Animation::sample_compressed_tracks(double p_time, SampledPose &r_pose) const {
+	uint32_t track_count = tracks.size();
+	r_pose.x.resize(track_count);
+	r_pose.y.resize(track_count);
+	r_pose.z.resize(track_count);
+	r_pose.w.resize(track_count);
+	r_pose.valid.resize(track_count);
+	r_pose.next_x.resize(track_count);
+	r_pose.next_y.resize(track_count);
+	r_pose.next_z.resize(track_count);
+	r_pose.next_w.resize(track_count);
+	r_pose.weight.resize(track_count);
+	for (uint32_t i = 0; i < 3; i++) {
+		r_pose.track_list[i].clear();
+	}
+	if (track_count) {
+		memset(r_pose.valid.ptr(), 0, track_count);
+	}
+
+	ERR_FAIL_COND(!compression.enabled);
 	p_time = CLAMP(p_time, 0, length);
-	if (key_index) {
-		*key_index = 0;
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND(page_index == -1); // Should not happen.
+
+	// First pass: decode the keys surrounding p_time for every compressed track, looking up the page only once.
+	for (uint32_t i = 0; i < track_count; i++) {
+		const Track *t = tracks[i];
+		int32_t compressed_track = -1;
+		switch (t->type) {
+			case TYPE_POSITION_3D: {
+				compressed_track = static_cast<const PositionTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_ROTATION_3D: {
+				compressed_track = static_cast<const RotationTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_SCALE_3D: {
+				compressed_track = static_cast<const ScaleTrack *>(t)->compressed_track;
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				compressed_track = static_cast<const BlendShapeTrack *>(t)->compressed_track;
+			} break;
+			default: {
+			} break;
+		}
+		if (compressed_track < 0) {
+			continue;
+		}
+
+		Vector3i current;
+		Vector3i next;
+		double time_current;
+		double time_next;
+		if (t->type == TYPE_BLEND_SHAPE) {
+			_fetch_compressed_in_page<1>(page_index, compressed_track, p_time, current, time_current, next, time_next);
+		} else {
+			_fetch_compressed_in_page<3>(page_index, compressed_track, p_time, current, time_current, next, time_next);
+		}
+
+		float c = 0.0;
+		if (time_current >= p_time || time_current == time_next) {
+			next = current;
+		} else if (p_time >= time_next) {
+			current = next;
+		} else {
+			c = (p_time - time_current) / (time_next - time_current);
+		}
+		r_pose.weight[i] = c;
+		r_pose.valid[i] = 1;
+
+		switch (t->type) {
+			case TYPE_ROTATION_3D: {
+				Quaternion from = _uncompress_quaternion(current);
+				Quaternion to = _uncompress_quaternion(next);
+				if (from.dot(to) < 0.95) {
+					// Too far apart for a normalized lerp, resolve it here and leave nothing to interpolate.
+					from = from.slerp(to, c);
+					r_pose.weight[i] = 0.0;
+				}
+				r_pose.x[i] = from.x;
+				r_pose.y[i] = from.y;
+				r_pose.z[i] = from.z;
+				r_pose.w[i] = from.w;
+				r_pose.next_x[i] = to.x;
+				r_pose.next_y[i] = to.y;
+				r_pose.next_z[i] = to.z;
+				r_pose.next_w[i] = to.w;
+				r_pose.track_list[1].push_back(i);
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				r_pose.x[i] = _uncompress_blend_shape(current);
+				r_pose.next_x[i] = _uncompress_blend_shape(next);
+				r_pose.track_list[2].push_back(i);
+			} break;
+			default: {
+				Vector3 from = _uncompress_pos_scale(compressed_track, current);
+				Vector3 to = _uncompress_pos_scale(compressed_track, next);
+				r_pose.x[i] = from.x;
+				r_pose.y[i] = from.y;
+				r_pose.z[i] = from.z;
+				r_pose.next_x[i] = to.x;
+				r_pose.next_y[i] = to.y;
+				r_pose.next_z[i] = to.z;
+				r_pose.track_list[0].push_back(i);
+			} break;
+		}
 	}
 
-	double frame_to_sec = 1.0 / double(compression.fps);
+	// Second pass: interpolate over the flat arrays, one track type at a time.
+	float *x = r_pose.x.ptr();
+	float *y = r_pose.y.ptr();
+	float *z = r_pose.z.ptr();
+	float *w = r_pose.w.ptr();
+	const float *next_x = r_pose.next_x.ptr();
+	const float *next_y = r_pose.next_y.ptr();
+	const float *next_z = r_pose.next_z.ptr();
+	const float *next_w = r_pose.next_w.ptr();
+	const float *weight = r_pose.weight.ptr();
+
+	for (const uint32_t &i : r_pose.track_list[0]) {
+		x[i] += (next_x[i] - x[i]) * weight[i];
+		y[i] += (next_y[i] - y[i]) * weight[i];
+		z[i] += (next_z[i] - z[i]) * weight[i];
+	}
 
+	for (const uint32_t &i : r_pose.track_list[1]) {
+		// Normalized lerp, keys are close enough for it to match a slerp.
+		float rx = x[i] + (next_x[i] - x[i]) * weight[i];
+		float ry = y[i] + (next_y[i] - y[i]) * weight[i];
+		float rz = z[i] + (next_z[i] - z[i]) * weight[i];
+		float rw = w[i] + (next_w[i] - w[i]) * weight[i];
+		float inv_len = 1.0f / Math::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+		x[i] = rx * inv_len;
+		y[i] = ry * inv_len;
+		z[i] = rz * inv_len;
+		w[i] = rw * inv_len;
+	}
+
+	for (const uint32_t &i : r_pose.track_list[2]) {
+		x[i] += (next_x[i] - x[i]) * weight[i];
+	}
+}
+
+void Animation::sample_tracks(double p_time, SampledPose &r_pose) const {
+	uint32_t track_count = tracks.size();
+	if (compression.enabled) {
+		sample_compressed_tracks(p_time, r_pose);
+	} else {
+		r_pose.x.resize(track_count);
+		r_pose.y.resize(track_count);
+		r_pose.z.resize(track_count);
+		r_pose.w.resize(track_count);
+		r_pose.valid.resize(track_count);
+		if (track_count) {
+			memset(r_pose.valid.ptr(), 0, track_count);
+		}
+	}
+
+	// Interpolate the tracks which aren't compressed one by one.
+	for (uint32_t i = 0; i < track_count; i++) {
+		if (r_pose.valid[i]) {
+			continue;
+		}
+		switch (tracks[i]->type) {
+			case TYPE_POSITION_3D:
+			case TYPE_SCALE_3D: {
+				Vector3 v;
+				Error err = tracks[i]->type == TYPE_POSITION_3D ? try_position_track_interpolate(i, p_time, &v) : try_scale_track_interpolate(i, p_time, &v);
+				if (err == OK) {
+					r_pose.x[i] = v.x;
+					r_pose.y[i] = v.y;
+					r_pose.z[i] = v.z;
+					r_pose.valid[i] = 1;
+				}
+			} break;
+			case TYPE_ROTATION_3D: {
+				Quaternion q;
+				if (try_rotation_track_interpolate(i, p_time, &q) == OK) {
+					r_pose.x[i] = q.x;
+					r_pose.y[i] = q.y;
+					r_pose.z[i] = q.z;
+					r_pose.w[i] = q.w;
+					r_pose.valid[i] = 1;
+				}
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				float v;
+				if (try_blend_shape_track_interpolate(i, p_time, &v) == OK) {
+					r_pose.x[i] = v;
+					r_pose.valid[i] = 1;
+				}
+			} break;
+			default: {
+			} break;
+		}
+	}
+}
+
+int32_t Animation::_find_compressed_page(double p_time) const {
 	int32_t page_index = -1;
 	for (uint32_t i = 0; i < compression.pages.size(); i++) {
 		if (compression.pages[i].time_offset > p_time) {
@@ -5108,11 +5299,32 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		}
 		page_index = i;
 	}
+	return page_index;
+}
+
+template <uint32_t COMPONENTS>
+bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+	ERR_FAIL_COND_V(!compression.enabled, false);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
+	p_time = CLAMP(p_time, 0, length);
 
+	int32_t page_index = _find_compressed_page(p_time);
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
 
-	double page_base_time = compression.pages[page_index].time_offset;
-	const uint8_t *page_data = compression.pages[page_index].data.ptr();
+	_fetch_compressed_in_page<COMPONENTS>(page_index, p_compressed_track, p_time, r_current_value, r_current_time, r_next_value, r_next_time, key_index);
+	return true;
+}
+
+template <uint32_t COMPONENTS>
+void Animation::_fetch_compressed_in_page(uint32_t p_page_index, uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+	if (key_index) {
+		*key_index = 0;
+	}
+
+	double frame_to_sec = 1.0 / double(compression.fps);
+
+	double page_base_time = compression.pages[p_page_index].time_offset;
+	const uint8_t *page_data = compression.pages[p_page_index].data.ptr();
 	// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 	const uint32_t *indices = (const uint32_t *)page_data;
 	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5232,8 +5444,6 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		r_current_value[i] = decode[i];
 		r_next_value[i] = decode_next[i];
 	}
-
-	return true;
 }
 
 template <uint32_t COMPONENTS>
@@ -345,9 +345,12 @@ private:
 	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
 	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const;
 	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
+	int32_t _find_compressed_page(double p_time) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
 	template <uint32_t COMPONENTS>
+	void _fetch_compressed_in_page(uint32_t p_page_index, uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
 	template <uint32_t COMPONENTS>
@@ -381,6 +384,24 @@ protected:
 	static bool inform_variant_array(int &r_min, int &r_max); // Returns true if max and min are swapped.
 
 public:
+	// Structure-of-arrays pose written by sample_tracks() and sample_compressed_tracks(), indexed by track.
+	// Position and scale use XYZ, rotation uses XYZW and blend shapes only use X.
+	struct SampledPose {
+		LocalVector<float> x;
+		LocalVector<float> y;
+		LocalVector<float> z;
+		LocalVector<float> w;
+		LocalVector<uint8_t> valid;
+
+		// Scratch space for the next keys, kept here so the buffers are reused between calls.
+		LocalVector<float> next_x;
+		LocalVector<float> next_y;
+		LocalVector<float> next_z;
+		LocalVector<float> next_w;
+		LocalVector<float> weight;
+		LocalVector<uint32_t> track_list[3]; // Position and scale, rotation, and blend shape tracks.
+	};
+
 	int add_track(TrackType p_type, int p_at_pos = -1);
 	void remove_track(int p_track);
 
@@ -416,6 +437,9 @@ public:
 	double track_get_key_time(int p_track, int p_key_idx) const;
 	real_t track_get_key_transition(int p_track, int p_key_idx) const;
 	bool track_is_compressed(int p_track) const;
+	bool is_compressed() const;
+	void sample_compressed_tracks(double p_time, SampledPose &r_pose) const;
+	void sample_tracks(double p_time, SampledPose &r_pose) const;
 
 	int position_track_insert_key(int p_track, double p_time, const Vector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Vector3 *r_position) const;
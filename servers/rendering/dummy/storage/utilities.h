@@ -119,6 +119,10 @@ public:
 	virtual RenderingDevice::DeviceType get_video_adapter_type() const override { return RenderingDevice::DeviceType::DEVICE_TYPE_OTHER; }
 	virtual String get_video_adapter_api_version() const override { return String(); }
 
+	virtual void pipeline_variants_capture_start() override {}
+	virtual Error pipeline_variants_capture_stop(const String &p_path) override { return ERR_UNAVAILABLE; }
+	virtual bool is_capturing_pipeline_variants() const override { return false; }
+
 	virtual Size2i get_maximum_viewport_size() const override { return Size2i(); };
 };
 
@@ -43,8 +43,17 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask);
+	if (uint32_t(p_child_item_count) >= thread_cull_threshold) {
+		LocalVector<Item *> items;
+		items.resize(p_child_item_count);
+		for (int i = 0; i < p_child_item_count; i++) {
+			items[i] = p_child_items[i].item;
+		}
+		_cull_canvas_items_threaded(items.ptr(), items.size(), p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, p_canvas_cull_mask);
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask);
+		}
 	}
 	if (p_canvas_item) {
 		_cull_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask);
@@ -186,6 +195,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			MutexLock lock(threaded_cull_mutex);
 			RenderingServerDefault::redraw_request();
 		}
 
@@ -214,6 +224,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				MutexLock lock(threaded_cull_mutex);
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -342,6 +353,28 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		if (!culling_threaded && uint32_t(child_item_count) >= thread_cull_threshold) {
+			LocalVector<Item *> items;
+			items.reserve(child_item_count);
+
+			for (int i = 0; i < child_item_count; i++) {
+				if (child_items[i]->behind || use_canvas_group) {
+					items.push_back(child_items[i]);
+				}
+			}
+			_cull_canvas_items_threaded(items.ptr(), items.size(), xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, p_canvas_cull_mask);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+
+			items.clear();
+			for (int i = 0; i < child_item_count; i++) {
+				if (!child_items[i]->behind && !use_canvas_group) {
+					items.push_back(child_items[i]);
+				}
+			}
+			_cull_canvas_items_threaded(items.ptr(), items.size(), xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, p_canvas_cull_mask);
+			return;
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -358,6 +391,70 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_items_threaded(Item **p_items, uint32_t p_item_count, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, uint32_t p_canvas_cull_mask) {
+	uint32_t chunk_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), p_item_count / 64);
+
+	if (culling_threaded || p_item_count < thread_cull_threshold || chunk_count < 2) {
+		for (uint32_t i = 0; i < p_item_count; i++) {
+			_cull_canvas_item(p_items[i], p_parent_xform, p_clip_rect, p_modulate, p_z, r_z_list, r_z_last_list, p_canvas_clip, p_material_owner, true, p_canvas_cull_mask);
+		}
+		return;
+	}
+
+	threaded_cull.items = p_items;
+	threaded_cull.item_count = p_item_count;
+	threaded_cull.chunk_size = (p_item_count + chunk_count - 1) / chunk_count;
+	threaded_cull.parent_xform = p_parent_xform;
+	threaded_cull.clip_rect = p_clip_rect;
+	threaded_cull.modulate = p_modulate;
+	threaded_cull.z = p_z;
+	threaded_cull.canvas_clip = p_canvas_clip;
+	threaded_cull.material_owner = p_material_owner;
+	threaded_cull.canvas_cull_mask = p_canvas_cull_mask;
+	if (threaded_cull.z_lists.size() < chunk_count * z_range * 2) {
+		threaded_cull.z_lists.resize(chunk_count * z_range * 2);
+	}
+
+	// Items culled on a thread don't split their own children any further.
+	culling_threaded = true;
+	RendererCanvasRender::Item::rect_threaded = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_chunk, &threaded_cull, chunk_count, -1, true, SNAME("CullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	RendererCanvasRender::Item::rect_threaded = false;
+	culling_threaded = false;
+
+	// Append the chunks in order, each z layer keeps the order of a single threaded cull.
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		RendererCanvasRender::Item **chunk_z_list = threaded_cull.z_lists.ptr() + i * z_range * 2;
+		RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+
+		for (int j = 0; j < z_range; j++) {
+			if (!chunk_z_list[j]) {
+				continue;
+			}
+			if (r_z_last_list[j]) {
+				r_z_last_list[j]->next = chunk_z_list[j];
+			} else {
+				r_z_list[j] = chunk_z_list[j];
+			}
+			r_z_last_list[j] = chunk_z_last_list[j];
+		}
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_item_chunk(uint32_t p_chunk, ThreadedCull *p_cull) {
+	RendererCanvasRender::Item **chunk_z_list = p_cull->z_lists.ptr() + p_chunk * z_range * 2;
+	RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+	memset(chunk_z_list, 0, z_range * 2 * sizeof(RendererCanvasRender::Item *));
+
+	uint32_t from = p_chunk * p_cull->chunk_size;
+	uint32_t to = MIN(from + p_cull->chunk_size, p_cull->item_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		_cull_canvas_item(p_cull->items[i], p_cull->parent_xform, p_cull->clip_rect, p_cull->modulate, p_cull->z, chunk_z_list, chunk_z_last_list, p_cull->canvas_clip, p_cull->material_owner, true, p_cull->canvas_cull_mask);
+	}
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -2201,6 +2298,8 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	thread_cull_threshold = GLOBAL_GET("rendering/limits/canvas/threaded_cull_minimum_children");
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
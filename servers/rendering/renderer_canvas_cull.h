@@ -31,6 +31,8 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -195,6 +197,31 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Items with many children have them culled in contiguous chunks on the WorkerThreadPool.
+	// Every chunk fills its own z lists, which are appended to the parent lists in chunk order
+	// afterwards, so the draw order is the same as when culling on a single thread.
+	struct ThreadedCull {
+		Item **items = nullptr;
+		uint32_t item_count = 0;
+		uint32_t chunk_size = 0;
+		Transform2D parent_xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+		LocalVector<RendererCanvasRender::Item *> z_lists; // First and last item of each z layer, z_range * 2 per chunk.
+	};
+
+	ThreadedCull threaded_cull;
+	uint32_t thread_cull_threshold = 1024;
+	bool culling_threaded = false;
+	BinaryMutex threaded_cull_mutex; // Protects the visibility notifier list and redraw requests while culling on threads.
+
+	void _cull_canvas_items_threaded(Item **p_items, uint32_t p_item_count, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, uint32_t p_canvas_cull_mask);
+	void _cull_canvas_item_chunk(uint32_t p_chunk, ThreadedCull *p_cull);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
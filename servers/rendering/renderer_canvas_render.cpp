@@ -33,6 +33,28 @@
 
 RendererCanvasRender *RendererCanvasRender::singleton = nullptr;
 
+// Items may be culled from several threads at once, and these storage queries can update caches shared between items.
+static BinaryMutex item_rect_storage_mutex;
+
+bool RendererCanvasRender::Item::rect_threaded = false;
+
+struct ItemRectStorageLock {
+	bool locked = false;
+
+	ItemRectStorageLock() {
+		if (RendererCanvasRender::Item::rect_threaded) {
+			item_rect_storage_mutex.lock();
+			locked = true;
+		}
+	}
+
+	~ItemRectStorageLock() {
+		if (locked) {
+			item_rect_storage_mutex.unlock();
+		}
+	}
+};
+
 const Rect2 &RendererCanvasRender::Item::get_rect() const {
 	if (custom_rect || (!rect_dirty && !update_when_visible && skeleton == RID())) {
 		return rect;
@@ -82,6 +104,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			} break;
 			case Item::Command::TYPE_MESH: {
 				const Item::CommandMesh *mesh = static_cast<const Item::CommandMesh *>(c);
+				ItemRectStorageLock lock;
 				AABB aabb = RSG::mesh_storage->mesh_get_aabb(mesh->mesh, skeleton);
 
 				r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
@@ -89,6 +112,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			} break;
 			case Item::Command::TYPE_MULTIMESH: {
 				const Item::CommandMultiMesh *multimesh = static_cast<const Item::CommandMultiMesh *>(c);
+				ItemRectStorageLock lock;
 				AABB aabb = RSG::mesh_storage->multimesh_get_aabb(multimesh->multimesh);
 
 				r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
@@ -97,6 +121,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			case Item::Command::TYPE_PARTICLES: {
 				const Item::CommandParticles *particles_cmd = static_cast<const Item::CommandParticles *>(c);
 				if (particles_cmd->particles.is_valid()) {
+					ItemRectStorageLock lock;
 					AABB aabb = RSG::particles_storage->particles_get_aabb(particles_cmd->particles);
 					r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
 				}
@@ -353,6 +353,9 @@ public:
 
 		Rect2 global_rect_cache;
 
+		// Set while items are culled from several threads, so get_rect() only serializes storage queries then.
+		static bool rect_threaded;
+
 		const Rect2 &get_rect() const;
 
 		Command *commands = nullptr;
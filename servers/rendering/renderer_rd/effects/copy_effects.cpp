@@ -496,7 +496,7 @@ void CopyEffects::copy_depth_to_rect_and_linearize(RID p_source_rd_texture, RID
 	RD::get_singleton()->compute_list_end();
 }
 
-void CopyEffects::copy_to_atlas_fb(RID p_source_rd_texture, RID p_dest_framebuffer, const Rect2 &p_uv_rect, RD::DrawListID p_draw_list, bool p_flip_y, bool p_panorama) {
+void CopyEffects::copy_to_atlas_fb(RID p_source_rd_texture, RID p_dest_framebuffer, const Rect2 &p_uv_rect, RD::DrawListID p_draw_list, bool p_flip_y, bool p_panorama, const Size2 &p_extrude) {
 	UniformSetCacheRD *uniform_set_cache = UniformSetCacheRD::get_singleton();
 	ERR_FAIL_NULL(uniform_set_cache);
 	MaterialStorage *material_storage = MaterialStorage::get_singleton();
@@ -514,6 +514,13 @@ void CopyEffects::copy_to_atlas_fb(RID p_source_rd_texture, RID p_dest_framebuff
 		copy_to_fb.push_constant.flags |= COPY_TO_FB_FLAG_FLIP_Y;
 	}
 
+	if (p_extrude != Size2()) {
+		// The section also covers this much of the source past each edge, as a fraction of its size.
+		copy_to_fb.push_constant.flags |= COPY_TO_FB_FLAG_EXTRUDE;
+		copy_to_fb.push_constant.pixel_size[0] = p_extrude.x;
+		copy_to_fb.push_constant.pixel_size[1] = p_extrude.y;
+	}
+
 	copy_to_fb.push_constant.luminance_multiplier = 1.0;
 
 	// setup our uniforms
@@ -644,6 +644,8 @@ public:
 
 	virtual void base_uniforms_changed() override;
 
+	virtual void update() override;
+
 	/* SDFGI UPDATE */
 
 	virtual void sdfgi_update(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, const Vector3 &p_world_position) override;
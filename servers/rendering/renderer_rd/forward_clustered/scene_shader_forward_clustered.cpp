@@ -31,6 +31,7 @@
 #include "scene_shader_forward_clustered.h"
 #include "core/config/project_settings.h"
 #include "core/math/math_defs.h"
+#include "core/os/os.h"
 #include "render_forward_clustered.h"
 #include "servers/rendering/renderer_rd/renderer_compositor_rd.h"
 #include "servers/rendering/renderer_rd/storage_rd/material_storage.h"
@@ -40,6 +41,11 @@ using namespace RendererSceneRenderImplementation;
 void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	//compile
 
+	if (compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		// The previous code is still compiling, it's no longer needed.
+		_finish_compilation(false);
+	}
+
 	code = p_code;
 	valid = false;
 	ubo_size = 0;
@@ -51,9 +57,9 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 	ShaderCompiler::GeneratedCode gen_code;
 
-	int blend_mode = BLEND_MODE_MIX;
+	int blend_modei = BLEND_MODE_MIX;
 	int depth_testi = DEPTH_TEST_ENABLED;
-	int alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
+	int alpha_antialiasing_modei = ALPHA_ANTIALIASING_OFF;
 	int cull_modei = CULL_BACK;
 
 	uses_point_size = false;
@@ -67,7 +73,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	uses_normal = false;
 	uses_tangent = false;
 	bool uses_normal_map = false;
-	bool wireframe = false;
+	wireframe = false;
 
 	unshaded = false;
 	uses_vertex = false;
@@ -86,13 +92,13 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
 	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
 
-	actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_mode, BLEND_MODE_ADD);
-	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_mode, BLEND_MODE_MIX);
-	actions.render_mode_values["blend_sub"] = Pair<int *, int>(&blend_mode, BLEND_MODE_SUB);
-	actions.render_mode_values["blend_mul"] = Pair<int *, int>(&blend_mode, BLEND_MODE_MUL);
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_modei, BLEND_MODE_ADD);
+	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_modei, BLEND_MODE_MIX);
+	actions.render_mode_values["blend_sub"] = Pair<int *, int>(&blend_modei, BLEND_MODE_SUB);
+	actions.render_mode_values["blend_mul"] = Pair<int *, int>(&blend_modei, BLEND_MODE_MUL);
 
-	actions.render_mode_values["alpha_to_coverage"] = Pair<int *, int>(&alpha_antialiasing_mode, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE);
-	actions.render_mode_values["alpha_to_coverage_and_one"] = Pair<int *, int>(&alpha_antialiasing_mode, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE_AND_TO_ONE);
+	actions.render_mode_values["alpha_to_coverage"] = Pair<int *, int>(&alpha_antialiasing_modei, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE);
+	actions.render_mode_values["alpha_to_coverage_and_one"] = Pair<int *, int>(&alpha_antialiasing_modei, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE_AND_TO_ONE);
 
 	actions.render_mode_values["depth_draw_never"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_DISABLED);
 	actions.render_mode_values["depth_draw_opaque"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_OPAQUE);
@@ -177,20 +183,75 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	print_line("\n**vertex_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX]);
 	print_line("\n**fragment_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
 #endif
-	shader_singleton->shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX], gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], gen_code.defines);
-	ERR_FAIL_COND(!shader_singleton->shader.version_is_valid(version));
-
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
 
-	//blend modes
+	blend_mode = BlendMode(blend_modei);
+	alpha_antialiasing_mode = AlphaAntiAliasing(alpha_antialiasing_modei);
 
 	// if any form of Alpha Antialiasing is enabled, set the blend mode to alpha to coverage
 	if (alpha_antialiasing_mode != ALPHA_ANTIALIASING_OFF) {
 		blend_mode = BLEND_MODE_ALPHA_TO_COVERAGE;
 	}
 
+	if (shader_singleton->background_compilation) {
+		// Compile the variants on a worker thread. The shader stays invalid until
+		// process_shader_compilations() picks up the result, so materials using it
+		// are drawn with the default material in the meantime.
+		compile_code = gen_code;
+		compile_valid = false;
+		shader_singleton->compiling_shaders.add(&compile_list_element);
+		RendererRD::MaterialStorage::get_singleton()->shader_data_compilation_queued(this);
+		compile_task = WorkerThreadPool::get_singleton()->add_template_task(this, &ShaderData::_compile_task, nullptr, false, SNAME("ShaderCompilation"));
+		return;
+	}
+
+	shader_singleton->shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX], gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], gen_code.defines);
+	ERR_FAIL_COND(!shader_singleton->shader.version_is_valid(version));
+
+	_setup_pipelines();
+
+	valid = true;
+}
+
+void SceneShaderForwardClustered::ShaderData::_compile_task(void *p_userdata) {
+	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	shader_singleton->shader.version_set_code(version, compile_code.code, compile_code.uniforms, compile_code.stage_globals[ShaderCompiler::STAGE_VERTEX], compile_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], compile_code.defines);
+	compile_valid = shader_singleton->shader.version_is_valid(version);
+
+	compile_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+}
+
+void SceneShaderForwardClustered::ShaderData::_finish_compilation(bool p_use_result) {
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(compile_task);
+	compile_task = WorkerThreadPool::INVALID_TASK_ID;
+	compile_code = ShaderCompiler::GeneratedCode();
+	compile_list_element.remove_from_list();
+
+	RendererRD::MaterialStorage *material_storage = RendererRD::MaterialStorage::get_singleton();
+	if (!p_use_result) {
+		material_storage->shader_data_compilation_canceled(this);
+		return;
+	}
+
+	if (compile_valid) {
+		_setup_pipelines();
+		valid = true;
+	} else {
+		ERR_PRINT("Shader compilation failed.");
+	}
+
+	material_storage->shader_data_compilation_finished(this, compile_usec);
+}
+
+void SceneShaderForwardClustered::ShaderData::_setup_pipelines() {
+	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
+
+	//blend modes
+
 	RD::PipelineColorBlendState::Attachment blend_attachment;
 
 	switch (blend_mode) {
@@ -395,7 +456,6 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 		}
 	}
 
-	valid = true;
 }
 
 bool SceneShaderForwardClustered::ShaderData::is_animated() const {
@@ -413,14 +473,23 @@ bool SceneShaderForwardClustered::ShaderData::casts_shadows() const {
 RS::ShaderNativeSourceCode SceneShaderForwardClustered::ShaderData::get_native_source_code() const {
 	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
 
+	if (compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		shader_singleton->wait_for_shader_compilations();
+	}
+
 	return shader_singleton->shader.version_get_native_source_code(version);
 }
 
 SceneShaderForwardClustered::ShaderData::ShaderData() :
-		shader_list_element(this) {
+		shader_list_element(this),
+		compile_list_element(this) {
 }
 
 SceneShaderForwardClustered::ShaderData::~ShaderData() {
+	if (compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		_finish_compilation(false);
+	}
+
 	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
 	ERR_FAIL_NULL(shader_singleton);
 	//pipeline variants will clear themselves if shader is gone
@@ -446,6 +515,11 @@ void SceneShaderForwardClustered::MaterialData::set_next_pass(RID p_pass) {
 bool SceneShaderForwardClustered::MaterialData::update_parameters(const HashMap<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty) {
 	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
 
+	if (shader_data->compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		// The shader is still compiling, the material will be queued for update again once it's done.
+		return false;
+	}
+
 	return update_parameters_uniform_set(p_parameters, p_uniform_dirty, p_textures_dirty, shader_data->uniforms, shader_data->ubo_offsets.ptr(), shader_data->texture_uniforms, shader_data->default_texture_params, shader_data->ubo_size, uniform_set, shader_singleton->shader.version_get_shader(shader_data->version, 0), RenderForwardClustered::MATERIAL_UNIFORM_SET, true, true);
 }
 
@@ -830,6 +904,9 @@ void fragment() {
 		sampler.compare_op = RD::COMPARE_OP_LESS;
 		shadow_sampler = RD::get_singleton()->sampler_create(sampler);
 	}
+
+	// Enabled last, so the built-in shaders above are always valid and can be used as fallback.
+	background_compilation = GLOBAL_GET("rendering/shader_compiler/background_compilation/enabled");
 }
 
 void SceneShaderForwardClustered::set_default_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_constants) {
@@ -848,9 +925,38 @@ void SceneShaderForwardClustered::set_default_specialization_constants(const Vec
 	}
 }
 
+void SceneShaderForwardClustered::enable_shader_group(ShaderGroup p_group) {
+	if (shader.is_group_enabled(p_group)) {
+		return;
+	}
+
+	// Enabling a group recompiles every version, so versions still compiling
+	// in the background need to be done first.
+	wait_for_shader_compilations();
+	shader.enable_group(p_group);
+}
+
 void SceneShaderForwardClustered::enable_advanced_shader_group(bool p_needs_multiview) {
 	if (p_needs_multiview || RendererCompositorRD::get_singleton()->is_xr_enabled()) {
-		shader.enable_group(SHADER_GROUP_ADVANCED_MULTIVIEW);
+		enable_shader_group(SHADER_GROUP_ADVANCED_MULTIVIEW);
+	}
+	enable_shader_group(SHADER_GROUP_ADVANCED);
+}
+
+void SceneShaderForwardClustered::process_shader_compilations() {
+	SelfList<ShaderData> *E = compiling_shaders.first();
+	while (E) {
+		SelfList<ShaderData> *N = E->next();
+		ShaderData *shader_data = E->self();
+		if (WorkerThreadPool::get_singleton()->is_task_completed(shader_data->compile_task)) {
+			shader_data->_finish_compilation(true);
+		}
+		E = N;
+	}
+}
+
+void SceneShaderForwardClustered::wait_for_shader_compilations() {
+	while (compiling_shaders.first()) {
+		compiling_shaders.first()->self()->_finish_compilation(true);
 	}
-	shader.enable_group(SHADER_GROUP_ADVANCED);
 }
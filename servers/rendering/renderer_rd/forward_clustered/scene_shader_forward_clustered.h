@@ -31,6 +31,7 @@
 #ifndef SCENE_SHADER_FORWARD_CLUSTERED_H
 #define SCENE_SHADER_FORWARD_CLUSTERED_H
 
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 #include "servers/rendering/renderer_rd/shaders/forward_clustered/scene_forward_clustered.glsl.gen.h"
 
@@ -184,9 +185,23 @@ public:
 		bool uses_screen_texture_mipmaps = false;
 		Cull cull_mode = CULL_DISABLED;
 
+		BlendMode blend_mode = BLEND_MODE_MIX;
+		AlphaAntiAliasing alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
+		bool wireframe = false;
+
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		// Background compilation state, only valid while compile_task is running.
+		WorkerThreadPool::TaskID compile_task = WorkerThreadPool::INVALID_TASK_ID;
+		ShaderCompiler::GeneratedCode compile_code;
+		bool compile_valid = false;
+		uint64_t compile_usec = 0;
+
+		void _compile_task(void *p_userdata);
+		void _finish_compilation(bool p_use_result);
+		void _setup_pipelines();
+
 		virtual void set_code(const String &p_Code);
 
 		virtual bool is_animated() const;
@@ -194,12 +209,16 @@ public:
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
 
 		SelfList<ShaderData> shader_list_element;
+		SelfList<ShaderData> compile_list_element;
 		ShaderData();
 		virtual ~ShaderData();
 	};
 
 	SelfList<ShaderData>::List shader_list;
 
+	bool background_compilation = false;
+	SelfList<ShaderData>::List compiling_shaders;
+
 	RendererRD::MaterialStorage::ShaderData *_create_shader_func();
 	static RendererRD::MaterialStorage::ShaderData *_create_shader_funcs() {
 		return static_cast<SceneShaderForwardClustered *>(singleton)->_create_shader_func();
@@ -256,7 +275,12 @@ public:
 
 	void init(const String p_defines);
 	void set_default_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_constants);
+	void enable_shader_group(ShaderGroup p_group);
 	void enable_advanced_shader_group(bool p_needs_multiview = false);
+
+	// Must be called from the rendering thread, once per frame before materials are updated.
+	void process_shader_compilations();
+	void wait_for_shader_compilations();
 };
 
 } // namespace RendererSceneRenderImplementation
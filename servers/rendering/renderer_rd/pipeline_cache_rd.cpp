@@ -30,8 +30,18 @@
 
 #include "pipeline_cache_rd.h"
 
+#include "core/io/file_access.h"
 #include "core/os/memory.h"
 
+#define PIPELINE_VARIANTS_MAGIC "GDPV"
+#define PIPELINE_VARIANTS_VERSION 1
+
+Mutex PipelineCacheRD::variants_mutex;
+SafeFlag PipelineCacheRD::capturing_variants;
+HashSet<uint64_t> PipelineCacheRD::captured_variant_hashes;
+PipelineCacheRD::VariantMap PipelineCacheRD::captured_variants;
+PipelineCacheRD::VariantMap PipelineCacheRD::prewarm_variants;
+
 RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
@@ -70,6 +80,146 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 	return pipeline;
 }
 
+uint64_t PipelineCacheRD::_compute_variants_key() const {
+	uint32_t h = hash_murmur3_one_32(render_primitive);
+
+	h = hash_murmur3_one_32(rasterization_state.enable_depth_clamp, h);
+	h = hash_murmur3_one_32(rasterization_state.discard_primitives, h);
+	h = hash_murmur3_one_32(rasterization_state.wireframe, h);
+	h = hash_murmur3_one_32(rasterization_state.cull_mode, h);
+	h = hash_murmur3_one_32(rasterization_state.front_face, h);
+	h = hash_murmur3_one_32(rasterization_state.depth_bias_enabled, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_constant_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_clamp, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_slope_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.line_width, h);
+	h = hash_murmur3_one_32(rasterization_state.patch_control_points, h);
+
+	// The sample count is taken from the framebuffer format of each version.
+	h = hash_murmur3_one_32(multisample_state.enable_sample_shading, h);
+	h = hash_murmur3_one_float(multisample_state.min_sample_shading, h);
+	for (int i = 0; i < multisample_state.sample_mask.size(); i++) {
+		h = hash_murmur3_one_32(multisample_state.sample_mask[i], h);
+	}
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_coverage, h);
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_one, h);
+
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_test, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_write, h);
+	h = hash_murmur3_one_32(depth_stencil_state.depth_compare_operator, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_range, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_min, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_max, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_stencil, h);
+	const RD::PipelineDepthStencilState::StencilOperationState *stencil_ops[2] = { &depth_stencil_state.front_op, &depth_stencil_state.back_op };
+	for (const RD::PipelineDepthStencilState::StencilOperationState *op : stencil_ops) {
+		h = hash_murmur3_one_32(op->fail, h);
+		h = hash_murmur3_one_32(op->pass, h);
+		h = hash_murmur3_one_32(op->depth_fail, h);
+		h = hash_murmur3_one_32(op->compare, h);
+		h = hash_murmur3_one_32(op->compare_mask, h);
+		h = hash_murmur3_one_32(op->write_mask, h);
+		h = hash_murmur3_one_32(op->reference, h);
+	}
+
+	h = hash_murmur3_one_32(blend_state.enable_logic_op, h);
+	h = hash_murmur3_one_32(blend_state.logic_op, h);
+	for (int i = 0; i < blend_state.attachments.size(); i++) {
+		const RD::PipelineColorBlendState::Attachment &attachment = blend_state.attachments[i];
+		h = hash_murmur3_one_32(attachment.enable_blend, h);
+		h = hash_murmur3_one_32(attachment.src_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.color_blend_op, h);
+		h = hash_murmur3_one_32(attachment.src_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.alpha_blend_op, h);
+		h = hash_murmur3_one_32(attachment.write_r | (attachment.write_g << 1) | (attachment.write_b << 2) | (attachment.write_a << 3), h);
+	}
+	h = hash_murmur3_one_float(blend_state.blend_constant.r, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.g, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.b, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.a, h);
+
+	h = hash_murmur3_one_32(dynamic_state_flags, h);
+	for (int i = 0; i < base_specialization_constants.size(); i++) {
+		h = hash_murmur3_one_32(base_specialization_constants[i].constant_id, h);
+		h = hash_murmur3_one_32(base_specialization_constants[i].type, h);
+		h = hash_murmur3_one_32(base_specialization_constants[i].int_value, h);
+	}
+
+	return hash_djb2_one_64(hash_fmix32(h), RD::get_singleton()->shader_get_binary_hash(shader));
+}
+
+void PipelineCacheRD::_capture_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	MutexLock lock(variants_mutex);
+	if (!capturing_variants.is_set()) {
+		return;
+	}
+
+	if (variants_key == 0) {
+		variants_key = _compute_variants_key();
+	}
+
+	// The IDs are stable during a run, so they are enough to tell whether this version was already captured.
+	uint64_t version_hash = hash_djb2_one_64(p_vertex_format_id, variants_key);
+	version_hash = hash_djb2_one_64(p_framebuffer_format_id, version_hash);
+	version_hash = hash_djb2_one_64(p_render_pass | (uint64_t(p_bool_specializations) << 32), version_hash);
+	version_hash = hash_djb2_one_64(p_wireframe, version_hash);
+
+	if (captured_variant_hashes.has(version_hash)) {
+		return;
+	}
+
+	VariantDescription variant;
+	variant.uses_vertex_format = p_vertex_format_id != RD::INVALID_ID;
+	if (variant.uses_vertex_format) {
+		variant.vertex_attributes = RD::get_singleton()->vertex_format_get_attributes(p_vertex_format_id);
+	}
+	ERR_FAIL_COND(!RD::get_singleton()->framebuffer_format_get_description(p_framebuffer_format_id, variant.attachments, variant.passes, variant.view_count));
+	variant.empty_samples = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id);
+	variant.wireframe = p_wireframe;
+	variant.render_pass = p_render_pass;
+	variant.bool_specializations = p_bool_specializations;
+
+	captured_variant_hashes.insert(version_hash);
+	captured_variants[variants_key].push_back(variant);
+}
+
+void PipelineCacheRD::_prewarm() {
+	LocalVector<VariantDescription> variants;
+	{
+		MutexLock lock(variants_mutex);
+		if (prewarm_variants.is_empty()) {
+			return;
+		}
+
+		variants_key = _compute_variants_key();
+		const LocalVector<VariantDescription> *key_variants = prewarm_variants.getptr(variants_key);
+		if (key_variants == nullptr) {
+			return;
+		}
+
+		variants = *key_variants;
+	}
+
+	for (const VariantDescription &variant : variants) {
+		RD::VertexFormatID vertex_format_id = RD::INVALID_ID;
+		if (variant.uses_vertex_format) {
+			vertex_format_id = RD::get_singleton()->vertex_format_create(variant.vertex_attributes);
+		}
+
+		RD::FramebufferFormatID framebuffer_format_id;
+		if (variant.attachments.is_empty()) {
+			framebuffer_format_id = RD::get_singleton()->framebuffer_format_create_empty(variant.empty_samples);
+		} else {
+			framebuffer_format_id = RD::get_singleton()->framebuffer_format_create_multipass(variant.attachments, variant.passes, variant.view_count);
+		}
+
+		// Goes through the same path as a draw would, so versions that already exist aren't generated twice.
+		get_render_pipeline(vertex_format_id, framebuffer_format_id, variant.wireframe, variant.render_pass, variant.bool_specializations);
+	}
+}
+
 void PipelineCacheRD::_clear() {
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
@@ -97,10 +247,14 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+	variants_key = 0;
+	_prewarm();
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
 	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	variants_key = 0;
+	_prewarm();
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
@@ -115,6 +269,206 @@ void PipelineCacheRD::clear() {
 	input_mask = 0;
 }
 
+void PipelineCacheRD::capture_variants_begin() {
+	MutexLock lock(variants_mutex);
+	capturing_variants.set();
+	captured_variant_hashes.clear();
+	captured_variants.clear();
+}
+
+Error PipelineCacheRD::capture_variants_end(const String &p_path) {
+	VariantMap variants;
+	{
+		MutexLock lock(variants_mutex);
+		ERR_FAIL_COND_V_MSG(!capturing_variants.is_set(), ERR_UNCONFIGURED, "Pipeline variants are not being captured.");
+		capturing_variants.clear();
+		variants = captured_variants;
+		captured_variant_hashes.clear();
+		captured_variants.clear();
+	}
+
+	// Shader binaries, and therefore the keys, are specific to the driver.
+	return save_variants(p_path, RD::get_singleton()->get_device_api_name(), variants);
+}
+
+bool PipelineCacheRD::is_capturing_variants() {
+	return capturing_variants.is_set();
+}
+
+Error PipelineCacheRD::load_prewarm_variants(const String &p_path) {
+	String api_name;
+	VariantMap variants;
+	Error err = load_variants(p_path, api_name, variants);
+	if (err != OK) {
+		return err;
+	}
+
+	if (api_name != RD::get_singleton()->get_device_api_name()) {
+		WARN_PRINT(vformat("Pipeline variants file was captured with %s, but %s is being used. Pipelines won't be prewarmed: %s", api_name, RD::get_singleton()->get_device_api_name(), p_path));
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	MutexLock lock(variants_mutex);
+	prewarm_variants = variants;
+	return OK;
+}
+
+static void _store_int32_vector(Ref<FileAccess> p_file, const Vector<int32_t> &p_vector) {
+	p_file->store_32(p_vector.size());
+	for (int i = 0; i < p_vector.size(); i++) {
+		p_file->store_32(p_vector[i]);
+	}
+}
+
+// Reads an element count, and fails if the rest of the file is too short to hold that many elements of at least the given size.
+static bool _get_count(Ref<FileAccess> p_file, uint32_t p_min_element_size, uint32_t &r_count) {
+	r_count = p_file->get_32();
+	if (p_file->eof_reached()) {
+		return false;
+	}
+	uint64_t remaining = p_file->get_length() - p_file->get_position();
+	return uint64_t(r_count) * p_min_element_size <= remaining;
+}
+
+static bool _get_int32_vector(Ref<FileAccess> p_file, Vector<int32_t> &r_vector) {
+	uint32_t count;
+	if (!_get_count(p_file, 4, count)) {
+		return false;
+	}
+	r_vector.resize(count);
+	for (int i = 0; i < r_vector.size(); i++) {
+		r_vector.write[i] = p_file->get_32();
+	}
+	return true;
+}
+
+// Smallest size each element takes in the file, which is when all its own lists are empty.
+#define PIPELINE_VARIANTS_KEY_MIN_SIZE 12
+#define PIPELINE_VARIANTS_VARIANT_MIN_SIZE 29
+#define PIPELINE_VARIANTS_ATTRIBUTE_SIZE 20
+#define PIPELINE_VARIANTS_ATTACHMENT_SIZE 12
+#define PIPELINE_VARIANTS_PASS_MIN_SIZE 24
+
+Error PipelineCacheRD::save_variants(const String &p_path, const String &p_api_name, const VariantMap &p_variants) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Can't open pipeline variants file for writing: " + p_path);
+
+	f->store_buffer((const uint8_t *)PIPELINE_VARIANTS_MAGIC, 4);
+	f->store_32(PIPELINE_VARIANTS_VERSION);
+	f->store_pascal_string(p_api_name);
+	f->store_32(p_variants.size());
+
+	for (const KeyValue<uint64_t, LocalVector<VariantDescription>> &E : p_variants) {
+		f->store_64(E.key);
+		f->store_32(E.value.size());
+		for (const VariantDescription &variant : E.value) {
+			f->store_8(uint8_t(variant.uses_vertex_format) | (uint8_t(variant.wireframe) << 1));
+			f->store_32(variant.render_pass);
+			f->store_32(variant.bool_specializations);
+			f->store_32(variant.view_count);
+			f->store_32(variant.empty_samples);
+
+			f->store_32(variant.vertex_attributes.size());
+			for (const RD::VertexAttribute &attribute : variant.vertex_attributes) {
+				f->store_32(attribute.location);
+				f->store_32(attribute.offset);
+				f->store_32(attribute.format);
+				f->store_32(attribute.stride);
+				f->store_32(attribute.frequency);
+			}
+
+			f->store_32(variant.attachments.size());
+			for (const RD::AttachmentFormat &attachment : variant.attachments) {
+				f->store_32(attachment.format);
+				f->store_32(attachment.samples);
+				f->store_32(attachment.usage_flags);
+			}
+
+			f->store_32(variant.passes.size());
+			for (const RD::FramebufferPass &pass : variant.passes) {
+				_store_int32_vector(f, pass.color_attachments);
+				_store_int32_vector(f, pass.input_attachments);
+				_store_int32_vector(f, pass.resolve_attachments);
+				_store_int32_vector(f, pass.preserve_attachments);
+				f->store_32(pass.depth_attachment);
+				f->store_32(pass.vrs_attachment);
+			}
+		}
+	}
+
+	return OK;
+}
+
+Error PipelineCacheRD::load_variants(const String &p_path, String &r_api_name, VariantMap &r_variants) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Can't open pipeline variants file: " + p_path);
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, PIPELINE_VARIANTS_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED, "Invalid pipeline variants file: " + p_path);
+	uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != PIPELINE_VARIANTS_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Pipeline variants file has version %d, but version %d is expected: %s", version, PIPELINE_VARIANTS_VERSION, p_path));
+	r_api_name = f->get_pascal_string();
+
+	const String truncated_message = "Pipeline variants file is truncated or corrupt: " + p_path;
+	VariantMap variants;
+	uint32_t key_count;
+	ERR_FAIL_COND_V_MSG(!_get_count(f, PIPELINE_VARIANTS_KEY_MIN_SIZE, key_count), ERR_FILE_CORRUPT, truncated_message);
+	for (uint32_t i = 0; i < key_count; i++) {
+		LocalVector<VariantDescription> &key_variants = variants[f->get_64()];
+		uint32_t variant_count;
+		ERR_FAIL_COND_V_MSG(!_get_count(f, PIPELINE_VARIANTS_VARIANT_MIN_SIZE, variant_count), ERR_FILE_CORRUPT, truncated_message);
+		for (uint32_t j = 0; j < variant_count; j++) {
+			VariantDescription variant;
+			uint8_t flags = f->get_8();
+			variant.uses_vertex_format = flags & 1;
+			variant.wireframe = flags & 2;
+			variant.render_pass = f->get_32();
+			variant.bool_specializations = f->get_32();
+			variant.view_count = f->get_32();
+			variant.empty_samples = RD::TextureSamples(f->get_32());
+
+			uint32_t count;
+			ERR_FAIL_COND_V_MSG(!_get_count(f, PIPELINE_VARIANTS_ATTRIBUTE_SIZE, count), ERR_FILE_CORRUPT, truncated_message);
+			variant.vertex_attributes.resize(count);
+			for (RD::VertexAttribute &attribute : variant.vertex_attributes) {
+				attribute.location = f->get_32();
+				attribute.offset = f->get_32();
+				attribute.format = RD::DataFormat(f->get_32());
+				attribute.stride = f->get_32();
+				attribute.frequency = RD::VertexFrequency(f->get_32());
+			}
+
+			ERR_FAIL_COND_V_MSG(!_get_count(f, PIPELINE_VARIANTS_ATTACHMENT_SIZE, count), ERR_FILE_CORRUPT, truncated_message);
+			variant.attachments.resize(count);
+			for (RD::AttachmentFormat &attachment : variant.attachments) {
+				attachment.format = RD::DataFormat(f->get_32());
+				attachment.samples = RD::TextureSamples(f->get_32());
+				attachment.usage_flags = f->get_32();
+			}
+
+			ERR_FAIL_COND_V_MSG(!_get_count(f, PIPELINE_VARIANTS_PASS_MIN_SIZE, count), ERR_FILE_CORRUPT, truncated_message);
+			variant.passes.resize(count);
+			for (RD::FramebufferPass &pass : variant.passes) {
+				ERR_FAIL_COND_V_MSG(!_get_int32_vector(f, pass.color_attachments), ERR_FILE_CORRUPT, truncated_message);
+				ERR_FAIL_COND_V_MSG(!_get_int32_vector(f, pass.input_attachments), ERR_FILE_CORRUPT, truncated_message);
+				ERR_FAIL_COND_V_MSG(!_get_int32_vector(f, pass.resolve_attachments), ERR_FILE_CORRUPT, truncated_message);
+				ERR_FAIL_COND_V_MSG(!_get_int32_vector(f, pass.preserve_attachments), ERR_FILE_CORRUPT, truncated_message);
+				pass.depth_attachment = f->get_32();
+				pass.vrs_attachment = f->get_32();
+			}
+
+			ERR_FAIL_COND_V_MSG(f->eof_reached(), ERR_FILE_CORRUPT, truncated_message);
+			key_variants.push_back(variant);
+		}
+	}
+
+	r_variants = variants;
+	return OK;
+}
+
 PipelineCacheRD::PipelineCacheRD() {
 	version_count = 0;
 	versions = nullptr;
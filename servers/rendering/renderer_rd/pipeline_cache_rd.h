@@ -31,7 +31,12 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/os/mutex.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -60,7 +65,36 @@ class PipelineCacheRD {
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+public:
+	// A version described with formats instead of IDs, so it remains valid across runs.
+	struct VariantDescription {
+		bool uses_vertex_format = false;
+		Vector<RD::VertexAttribute> vertex_attributes;
+		Vector<RD::AttachmentFormat> attachments;
+		Vector<RD::FramebufferPass> passes;
+		uint32_t view_count = 1;
+		RD::TextureSamples empty_samples = RD::TEXTURE_SAMPLES_1;
+		bool wireframe = false;
+		uint32_t render_pass = 0;
+		uint32_t bool_specializations = 0;
+	};
+
+	typedef HashMap<uint64_t, LocalVector<VariantDescription>> VariantMap;
+
+private:
+	static Mutex variants_mutex;
+	static SafeFlag capturing_variants;
+	static HashSet<uint64_t> captured_variant_hashes;
+	static VariantMap captured_variants;
+	static VariantMap prewarm_variants;
+
+	// Identifies this cache across runs by its shader and pipeline state.
+	uint64_t variants_key = 0;
+
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	uint64_t _compute_variants_key() const;
+	void _capture_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _prewarm();
 
 	void _clear();
 
@@ -82,12 +116,19 @@ public:
 		for (uint32_t i = 0; i < version_count; i++) {
 			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
 				result = versions[i].pipeline;
-				spin_lock.unlock();
-				return result;
+				break;
 			}
 		}
-		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		if (result.is_null()) {
+			result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		}
 		spin_lock.unlock();
+
+		// Done outside the spin lock, as capturing takes the variants mutex and queries the device.
+		// Versions used while capturing are recorded too, even if they were generated before capturing started.
+		if (unlikely(capturing_variants.is_set()) && result.is_valid()) {
+			_capture_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		}
 		return result;
 	}
 
@@ -99,6 +140,17 @@ public:
 		return input_mask;
 	}
 	void clear();
+
+	// Records every version used from now on, so the list can be saved and used to prewarm the caches on later runs.
+	static void capture_variants_begin();
+	static Error capture_variants_end(const String &p_path);
+	static bool is_capturing_variants();
+	// Caches set up after loading the list generate the versions it has for them right away, instead of on first use.
+	static Error load_prewarm_variants(const String &p_path);
+
+	static Error save_variants(const String &p_path, const String &p_api_name, const VariantMap &p_variants);
+	static Error load_variants(const String &p_path, String &r_api_name, VariantMap &r_variants);
+
 	PipelineCacheRD();
 	~PipelineCacheRD();
 };
@@ -350,13 +350,21 @@ void RendererCanvasRenderRD::free_polygon(PolygonID p_polygon) {
 
 ////////////////////
 
-void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size, bool p_texture_is_data) {
+void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, TextureBinding &r_binding, PushConstant &push_constant, Size2 &r_texpixel_size, bool p_texture_is_data) {
 	if (p_texture == RID()) {
 		p_texture = default_canvas_texture;
 	}
 
-	if (r_last_texture == p_texture) {
-		return; //nothing to do, its the same
+	r_binding.requested_texture = p_texture;
+
+	if (r_binding.texture == p_texture && r_binding.filter == p_base_filter && r_binding.repeat == p_base_repeat && r_binding.texture_is_data == p_texture_is_data) {
+		//nothing to bind, its the same, but the push constant may come from another item
+		push_constant.flags = (push_constant.flags & ~(FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)) | r_binding.flags;
+		push_constant.specular_shininess = r_binding.specular_shininess;
+		push_constant.color_texture_pixel_size[0] = r_binding.texpixel_size.x;
+		push_constant.color_texture_pixel_size[1] = r_binding.texpixel_size.y;
+		r_texpixel_size = r_binding.texpixel_size;
+		return;
 	}
 
 	RID uniform_set;
@@ -368,7 +376,7 @@ void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RI
 	bool success = RendererRD::TextureStorage::get_singleton()->canvas_texture_get_uniform_set(p_texture, p_base_filter, p_base_repeat, shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, bool(push_constant.flags & FLAGS_CONVERT_ATTRIBUTES_TO_LINEAR), uniform_set, size, specular_shininess, use_normal, use_specular, p_texture_is_data);
 	//something odd happened
 	if (!success) {
-		_bind_canvas_texture(p_draw_list, default_canvas_texture, p_base_filter, p_base_repeat, r_last_texture, push_constant, r_texpixel_size);
+		_bind_canvas_texture(p_draw_list, default_canvas_texture, p_base_filter, p_base_repeat, r_binding, push_constant, r_texpixel_size);
 		return;
 	}
 
@@ -397,7 +405,13 @@ void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RI
 	push_constant.color_texture_pixel_size[0] = r_texpixel_size.x;
 	push_constant.color_texture_pixel_size[1] = r_texpixel_size.y;
 
-	r_last_texture = p_texture;
+	r_binding.texture = p_texture;
+	r_binding.filter = p_base_filter;
+	r_binding.repeat = p_base_repeat;
+	r_binding.texture_is_data = p_texture_is_data;
+	r_binding.flags = push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED);
+	r_binding.specular_shininess = push_constant.specular_shininess;
+	r_binding.texpixel_size = r_texpixel_size;
 }
 
 _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primitive, uint32_t p_indices) {
@@ -406,7 +420,7 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
 
-void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used, RenderingMethod::RenderInfo *r_render_info) {
+void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, TextureBinding &r_texture_binding, bool &r_sdf_used, RenderingMethod::RenderInfo *r_render_info) {
 	//create an empty push constant
 	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
@@ -481,7 +495,6 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 	bool reclip = false;
 
-	RID last_texture;
 	Size2 texpixel_size;
 
 	bool skipping = false;
@@ -515,13 +528,44 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 				//bind textures
 
-				_bind_canvas_texture(p_draw_list, rect->texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size, bool(rect->flags & CANVAS_RECT_MSDF));
+				RID atlas_texture;
+				Rect2 atlas_uv_rect;
+				Size2i atlas_texture_size;
+				bool atlas_bind_saved = false;
+
+				if (rect->texture.is_valid() && texture_storage->canvas_texture_atlas_is_enabled() && pipeline_variants == &shader.pipeline_variants && !(rect->flags & (CANVAS_RECT_TILE | CANVAS_RECT_MSDF | CANVAS_RECT_LCD)) && current_repeat == RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED && (current_filter == RS::CANVAS_ITEM_TEXTURE_FILTER_NEAREST || current_filter == RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR)) {
+					// Only with the default shader, custom shaders may read TEXTURE_PIXEL_SIZE or sample outside of the rect.
+					if (texture_storage->canvas_texture_atlas_get_texture(rect->texture, atlas_texture, atlas_uv_rect, atlas_texture_size)) {
+						// Only counted when the page is already bound for a different texture, drawing the same texture again wouldn't rebind without the atlas either.
+						atlas_bind_saved = r_texture_binding.texture == atlas_texture && r_texture_binding.requested_texture != rect->texture && r_texture_binding.filter == current_filter && r_texture_binding.repeat == current_repeat && !r_texture_binding.texture_is_data;
+					} else {
+						atlas_texture = RID();
+					}
+				}
 
 				Rect2 src_rect;
 				Rect2 dst_rect;
 
+				if (atlas_texture.is_valid()) {
+					_bind_canvas_texture(p_draw_list, atlas_texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
+					r_texture_binding.requested_texture = rect->texture;
+					if (atlas_bind_saved) {
+						texture_storage->canvas_texture_atlas_add_bind_saved();
+					}
+
+					Size2 original_texpixel_size = Size2(1.0 / atlas_texture_size.width, 1.0 / atlas_texture_size.height);
+					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * original_texpixel_size, rect->source.size * original_texpixel_size) : Rect2(0, 0, 1, 1);
+					src_rect.position = atlas_uv_rect.position + src_rect.position * atlas_uv_rect.size;
+					src_rect.size *= atlas_uv_rect.size;
+				} else {
+					_bind_canvas_texture(p_draw_list, rect->texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size, bool(rect->flags & CANVAS_RECT_MSDF));
+
+					if (rect->texture != RID()) {
+						src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+					}
+				}
+
 				if (rect->texture != RID()) {
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
 					dst_rect = Rect2(rect->rect.position, rect->rect.size);
 
 					if (dst_rect.size.width < 0) {
@@ -619,7 +663,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 				//bind textures
 
-				_bind_canvas_texture(p_draw_list, np->texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size);
+				_bind_canvas_texture(p_draw_list, np->texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
 
 				Rect2 src_rect;
 				Rect2 dst_rect(np->rect.position.x, np->rect.position.y, np->rect.size.x, np->rect.size.y);
@@ -706,7 +750,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 				//bind textures
 
-				_bind_canvas_texture(p_draw_list, polygon->texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size);
+				_bind_canvas_texture(p_draw_list, polygon->texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
 
 				Color color = base_color;
 				if (use_linear_colors) {
@@ -751,7 +795,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 				//bind textures
 
-				_bind_canvas_texture(p_draw_list, primitive->texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size);
+				_bind_canvas_texture(p_draw_list, primitive->texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
 
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, primitive_arrays.index_array[MIN(3u, primitive->point_count) - 1]);
 
@@ -905,7 +949,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 					break;
 				}
 
-				_bind_canvas_texture(p_draw_list, texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size);
+				_bind_canvas_texture(p_draw_list, texture, current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
 
 				uint32_t surf_count = mesh_storage->mesh_get_surface_count(mesh);
 				static const PipelineVariant variant[RS::PRIMITIVE_MAX] = { PIPELINE_VARIANT_ATTRIBUTE_POINTS, PIPELINE_VARIANT_ATTRIBUTE_LINES, PIPELINE_VARIANT_ATTRIBUTE_LINES_STRIP, PIPELINE_VARIANT_ATTRIBUTE_TRIANGLES, PIPELINE_VARIANT_ATTRIBUTE_TRIANGLE_STRIP };
@@ -1011,7 +1055,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 		//bind textures
 
-		_bind_canvas_texture(p_draw_list, RID(), current_filter, current_repeat, last_texture, push_constant, texpixel_size);
+		_bind_canvas_texture(p_draw_list, RID(), current_filter, current_repeat, r_texture_binding, push_constant, texpixel_size);
 
 		Rect2 src_rect;
 		Rect2 dst_rect;
@@ -1186,6 +1230,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	PipelineVariants *pipeline_variants = &shader.pipeline_variants;
 
+	TextureBinding texture_binding;
+
 	for (int i = 0; i < p_item_count; i++) {
 		Item *ci = items[i];
 
@@ -1240,7 +1286,7 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 			}
 		}
 
-		_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, r_sdf_used, r_render_info);
+		_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, texture_binding, r_sdf_used, r_render_info);
 
 		prev_material = material;
 	}
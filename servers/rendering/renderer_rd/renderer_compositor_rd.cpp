@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 
 void RendererCompositorRD::blit_render_targets_to_screen(DisplayServer::WindowID p_screen, const BlitToScreen *p_render_targets, int p_amount) {
 	Error err = RD::get_singleton()->screen_prepare_for_drawing(p_screen);
@@ -148,6 +149,10 @@ void RendererCompositorRD::initialize() {
 uint64_t RendererCompositorRD::frame = 1;
 
 void RendererCompositorRD::finalize() {
+	if (PipelineCacheRD::is_capturing_variants()) {
+		PipelineCacheRD::capture_variants_end("user://pipeline_variants.bin");
+	}
+
 	memdelete(scene);
 	memdelete(canvas);
 	memdelete(fog);
@@ -297,6 +302,18 @@ RendererCompositorRD::RendererCompositorRD() {
 
 	singleton = this;
 
+	{
+		// Must happen before any shader is set up, so their pipeline caches can be prewarmed or captured from the start.
+		String prewarm_variants_path = GLOBAL_GET("rendering/rendering_device/pipeline_cache/prewarm_variants_file");
+		if (!prewarm_variants_path.is_empty()) {
+			PipelineCacheRD::load_prewarm_variants(prewarm_variants_path);
+		}
+
+		if (GLOBAL_GET("rendering/rendering_device/pipeline_cache/capture_variants")) {
+			PipelineCacheRD::capture_variants_begin();
+		}
+	}
+
 	utilities = memnew(RendererRD::Utilities);
 	texture_storage = memnew(RendererRD::TextureStorage);
 	material_storage = memnew(RendererRD::MaterialStorage);
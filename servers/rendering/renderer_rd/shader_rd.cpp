@@ -34,6 +34,7 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
 #include "core/version.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
@@ -470,7 +471,10 @@ bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
 void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
 	ERR_FAIL_COND(!shader_cache_dir_valid);
 	const String &path = _get_cache_file_path(p_version, p_group);
-	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	// Versions may be compiled on several threads at once, and two of them can share a cache file.
+	// Each thread writes its own temporary file and renames it when done, so the cache file is never seen half written.
+	const String temp_path = path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
 	ERR_FAIL_COND(f.is_null());
 	f->store_buffer((const uint8_t *)shader_file_header, 4);
 	f->store_32(cache_file_version); // File version.
@@ -481,6 +485,13 @@ void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
 		f->store_32(p_version->variant_data[variant_id].size()); // Stage count.
 		f->store_buffer(p_version->variant_data[variant_id].ptr(), p_version->variant_data[variant_id].size());
 	}
+
+	bool write_failed = f->get_error() != OK;
+	f->close();
+	if (write_failed || DirAccess::rename_absolute(temp_path, path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG("Can't save shader cache file: " + path);
+	}
 }
 
 void ShaderRD::_allocate_placeholders(Version *p_version, int p_group) {
@@ -21,6 +21,7 @@
 #define FLAG_ALPHA_TO_ONE (1 << 5)
 #define FLAG_LINEAR (1 << 6)
 #define FLAG_NORMAL (1 << 7)
+#define FLAG_EXTRUDE (1 << 8)
 
 #ifdef MULTIVIEW
 layout(location = 0) out vec3 uv_interp;
@@ -51,6 +52,11 @@ void main() {
 
 	gl_Position = vec4(vpos * 2.0 - 1.0, 0.0, 1.0);
 
+	if (bool(params.flags & FLAG_EXTRUDE)) {
+		// Sample past the edges, the clamping sampler repeats the edge texels there.
+		uv_interp.xy = uv_interp.xy * (1.0 + 2.0 * params.pixel_size) - params.pixel_size;
+	}
+
 	if (bool(params.flags & FLAG_FLIP_Y)) {
 		uv_interp.y = 1.0 - uv_interp.y;
 	}
@@ -79,6 +85,7 @@ void main() {
 #define FLAG_ALPHA_TO_ONE (1 << 5)
 #define FLAG_LINEAR (1 << 6)
 #define FLAG_NORMAL (1 << 7)
+#define FLAG_EXTRUDE (1 << 8)
 
 layout(push_constant, std430) uniform Params {
 	vec4 section;
@@ -1914,17 +1914,46 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	}
 
 	if (shader->data) {
+		shader->data->self = p_shader;
 		shader->data->set_path_hint(shader->path_hint);
 		shader->data->set_code(p_code);
 	}
 
-	for (Material *E : shader->owners) {
+	_shader_notify_owners(shader);
+}
+
+void MaterialStorage::_shader_notify_owners(Shader *p_shader) {
+	for (Material *E : p_shader->owners) {
 		Material *material = E;
 		material->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MATERIAL);
 		_material_queue_update(material, true, true);
 	}
 }
 
+void MaterialStorage::shader_data_compilation_queued(ShaderData *p_data) {
+	ERR_FAIL_NULL(p_data);
+	shader_compilations_queued++;
+}
+
+void MaterialStorage::shader_data_compilation_finished(ShaderData *p_data, uint64_t p_usec) {
+	ERR_FAIL_NULL(p_data);
+	ERR_FAIL_COND(shader_compilations_queued == 0);
+	shader_compilations_queued--;
+	shader_compilation_usec = p_usec;
+
+	// Materials kept using the fallback while the shader was compiling, update them now.
+	Shader *shader = shader_owner.get_or_null(p_data->self);
+	if (shader && shader->data == p_data) {
+		_shader_notify_owners(shader);
+	}
+}
+
+void MaterialStorage::shader_data_compilation_canceled(ShaderData *p_data) {
+	ERR_FAIL_NULL(p_data);
+	ERR_FAIL_COND(shader_compilations_queued == 0);
+	shader_compilations_queued--;
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -73,6 +73,11 @@ public:
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
 
 		virtual ~ShaderData() {}
+
+	private:
+		friend class MaterialStorage;
+
+		RID self;
 	};
 
 	struct MaterialData {
@@ -215,6 +220,11 @@ private:
 	mutable RID_Owner<Shader, true> shader_owner;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
 
+	void _shader_notify_owners(Shader *p_shader);
+
+	uint32_t shader_compilations_queued = 0;
+	uint64_t shader_compilation_usec = 0;
+
 	/* MATERIAL API */
 
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
@@ -407,6 +417,13 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	// Used by shader data compiling in the background; must be called from the rendering thread.
+	void shader_data_compilation_queued(ShaderData *p_data);
+	void shader_data_compilation_finished(ShaderData *p_data, uint64_t p_usec);
+	void shader_data_compilation_canceled(ShaderData *p_data);
+	uint32_t get_shader_compilations_queued() const { return shader_compilations_queued; }
+	uint64_t get_shader_compilation_time() const { return shader_compilation_usec; }
+
 	/* MATERIAL API */
 
 	bool owns_material(RID p_rid) { return material_owner.owns(p_rid); };
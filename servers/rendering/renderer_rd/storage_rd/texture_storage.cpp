@@ -32,6 +32,7 @@
 
 #include "../effects/copy_effects.h"
 #include "../framebuffer_cache_rd.h"
+#include "core/config/project_settings.h"
 #include "material_storage.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 
@@ -89,6 +90,13 @@ TextureStorage *TextureStorage::get_singleton() {
 TextureStorage::TextureStorage() {
 	singleton = this;
 
+	canvas_atlas.enabled = GLOBAL_GET("rendering/2d/texture_atlas/enabled");
+	canvas_atlas.max_texture_size = GLOBAL_GET("rendering/2d/texture_atlas/max_texture_size");
+	canvas_atlas.page_size = GLOBAL_GET("rendering/2d/texture_atlas/page_size");
+	canvas_atlas.max_pages = GLOBAL_GET("rendering/2d/texture_atlas/max_pages");
+	// Textures larger than a page, padding included, could never be packed.
+	canvas_atlas.max_texture_size = MIN(canvas_atlas.max_texture_size, canvas_atlas.page_size - CANVAS_TEXTURE_ATLAS_PADDING * 2);
+
 	{ //create default textures
 
 		RD::TextureFormat tformat;
@@ -548,6 +556,8 @@ TextureStorage::~TextureStorage() {
 		RD::get_singleton()->free(decal_atlas.texture);
 	}
 
+	_canvas_texture_atlas_clear();
+
 	//def textures
 	for (int i = 0; i < DEFAULT_RD_TEXTURE_MAX; i++) {
 		if (default_rd_textures[i].is_valid()) {
@@ -777,6 +787,7 @@ void TextureStorage::texture_free(RID p_texture) {
 	}
 
 	decal_atlas_remove_texture(p_texture);
+	canvas_texture_atlas_remove_texture(p_texture);
 
 	for (int i = 0; i < t->proxies.size(); i++) {
 		Texture *p = texture_owner.get_or_null(t->proxies[i]);
@@ -1128,6 +1139,8 @@ void TextureStorage::_texture_2d_update(RID p_texture, const Ref<Image> &p_image
 	Ref<Image> validated = _validate_texture_format(p_image, f);
 
 	RD::get_singleton()->texture_update(tex->rd_texture, p_layer, validated->get_data());
+
+	canvas_texture_atlas_mark_dirty_on_texture(p_texture);
 }
 
 void TextureStorage::texture_2d_update(RID p_texture, const Ref<Image> &p_image, int p_layer) {
@@ -1400,6 +1413,7 @@ void TextureStorage::texture_replace(RID p_texture, RID p_by_texture) {
 	texture_owner.free(p_by_texture);
 
 	decal_atlas_mark_dirty_on_texture(p_texture);
+	canvas_texture_atlas_remove_texture(p_texture); // Packed again next time it's drawn, if still eligible.
 }
 
 void TextureStorage::texture_set_size_override(RID p_texture, int p_width, int p_height) {
@@ -1409,6 +1423,8 @@ void TextureStorage::texture_set_size_override(RID p_texture, int p_width, int p
 
 	tex->width_2d = p_width;
 	tex->height_2d = p_height;
+
+	canvas_texture_atlas_mark_dirty_on_texture(p_texture);
 }
 
 void TextureStorage::texture_set_path(RID p_texture, const String &p_path) {
@@ -1535,6 +1551,7 @@ void TextureStorage::texture_rd_initialize(RID p_texture, const RID &p_rd_textur
 	texture.height_2d = texture.height;
 	texture.is_render_target = false;
 	texture.is_proxy = false;
+	texture.is_rd_texture = true;
 
 	texture_owner.initialize_rid(p_texture, texture);
 }
@@ -2754,6 +2771,359 @@ void TextureStorage::texture_remove_from_decal_atlas(RID p_texture, bool p_panor
 	}
 }
 
+/* CANVAS TEXTURE ATLAS API */
+
+bool TextureStorage::canvas_texture_atlas_get_texture(RID p_texture, RID &r_atlas_texture, Rect2 &r_uv_rect, Size2i &r_size) {
+	const CanvasTextureAtlas::Texture *at = canvas_atlas.textures.getptr(p_texture);
+	if (at) {
+		if (at->page < 0) {
+			return false;
+		}
+		r_atlas_texture = canvas_atlas.pages[at->page].texture;
+		r_uv_rect = at->uv_rect;
+		r_size = at->size;
+		return true;
+	}
+
+	if (canvas_atlas.excluded.has(p_texture)) {
+		return false;
+	}
+
+	Texture *t = get_texture(p_texture);
+	if (!t) {
+		return false; // Canvas textures may have normal or specular maps, those are never packed.
+	}
+
+	// Only plain 2D textures with an sRGB variant, so sampling from the atlas
+	// gives the exact same result as sampling the texture itself.
+	// Textures created from RD textures are excluded too, as they can be written to without going through this class.
+	bool can_pack = t->type == TYPE_2D && !t->is_render_target && !t->is_proxy && !t->is_rd_texture && t->rd_format_srgb != RD::DATA_FORMAT_MAX;
+	can_pack = can_pack && t->width == t->width_2d && t->height == t->height_2d;
+	can_pack = can_pack && canvas_texture_atlas_fits(Size2i(t->width, t->height), canvas_atlas.max_texture_size, canvas_atlas.page_size);
+	if (!can_pack) {
+		canvas_atlas.excluded.insert(p_texture);
+		return false;
+	}
+
+	// Packed on the next update, drawn from the texture itself until then.
+	CanvasTextureAtlas::Texture new_texture;
+	new_texture.size = Size2i(t->width, t->height);
+	canvas_atlas.textures.insert(p_texture, new_texture);
+	canvas_atlas.dirty = true;
+	return false;
+}
+
+void TextureStorage::canvas_texture_atlas_mark_dirty_on_texture(RID p_texture) {
+	if (canvas_atlas.textures.has(p_texture)) {
+		// Textures updated at run-time would force the atlas to be repacked
+		// constantly, so stop packing them.
+		canvas_atlas.textures.erase(p_texture);
+		canvas_atlas.excluded.insert(p_texture);
+		canvas_atlas.removed = true;
+		canvas_atlas.dirty = true;
+	}
+}
+
+void TextureStorage::canvas_texture_atlas_remove_texture(RID p_texture) {
+	canvas_atlas.excluded.erase(p_texture);
+	if (canvas_atlas.textures.has(p_texture)) {
+		canvas_atlas.textures.erase(p_texture);
+		// Not marked dirty, its space is simply left unused until the next repack.
+		canvas_atlas.removed = true;
+	}
+}
+
+void TextureStorage::_canvas_texture_atlas_clear() {
+	for (const CanvasTextureAtlas::Page &page : canvas_atlas.pages) {
+		texture_free(page.texture);
+	}
+	canvas_atlas.pages.clear();
+
+	for (KeyValue<RID, CanvasTextureAtlas::Texture> &E : canvas_atlas.textures) {
+		E.value.page = -1;
+	}
+}
+
+bool TextureStorage::canvas_texture_atlas_fits(const Size2i &p_size, int p_max_texture_size, int p_page_size) {
+	if (p_size.width <= 0 || p_size.height <= 0 || p_size.width > p_max_texture_size || p_size.height > p_max_texture_size) {
+		return false;
+	}
+	return p_size.width + CANVAS_TEXTURE_ATLAS_PADDING * 2 <= p_page_size && p_size.height + CANVAS_TEXTURE_ATLAS_PADDING * 2 <= p_page_size;
+}
+
+bool TextureStorage::canvas_texture_atlas_place(CanvasTextureAtlasShelf &r_shelf, CanvasTextureAtlasItem &r_item, int p_page, const Size2i &p_page_size) {
+	const Size2i padded_size = r_item.size + Size2i(CANVAS_TEXTURE_ATLAS_PADDING * 2, CANVAS_TEXTURE_ATLAS_PADDING * 2);
+	if (padded_size.width > p_page_size.width) {
+		return false;
+	}
+
+	Point2i position = r_shelf.cursor;
+	int row_height = r_shelf.row_height;
+	if (position.x + padded_size.width > p_page_size.width) {
+		position = Point2i(0, position.y + row_height);
+		row_height = 0;
+	}
+	if (position.y + padded_size.height > p_page_size.height) {
+		return false;
+	}
+
+	r_shelf.cursor = Point2i(position.x + padded_size.width, position.y);
+	r_shelf.row_height = MAX(row_height, padded_size.height);
+	r_item.page = p_page;
+	r_item.position = position + Point2i(CANVAS_TEXTURE_ATLAS_PADDING, CANVAS_TEXTURE_ATLAS_PADDING);
+	return true;
+}
+
+// Indices of the items from the tallest to the shortest, so rows waste little space.
+static LocalVector<uint32_t> _canvas_texture_atlas_sort(const LocalVector<TextureStorage::CanvasTextureAtlasItem> &p_items) {
+	struct SortIndex {
+		Size2i size;
+		uint32_t index = 0;
+
+		bool operator<(const SortIndex &p_item) const {
+			//sort larger to smaller
+			if (size.height == p_item.size.height) {
+				return size.width > p_item.size.width;
+			} else {
+				return size.height > p_item.size.height;
+			}
+		}
+	};
+
+	LocalVector<SortIndex> sorted;
+	sorted.resize(p_items.size());
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		sorted[i].size = p_items[i].size;
+		sorted[i].index = i;
+	}
+	sorted.sort();
+
+	LocalVector<uint32_t> order;
+	order.resize(sorted.size());
+	for (uint32_t i = 0; i < sorted.size(); i++) {
+		order[i] = sorted[i].index;
+	}
+	return order;
+}
+
+LocalVector<TextureStorage::CanvasTextureAtlasShelf> TextureStorage::canvas_texture_atlas_pack(LocalVector<CanvasTextureAtlasItem> &r_items, int p_page_size, int p_max_pages) {
+	for (CanvasTextureAtlasItem &item : r_items) {
+		item.page = -1;
+	}
+
+	LocalVector<CanvasTextureAtlasShelf> shelves;
+	if (r_items.is_empty() || p_max_pages <= 0) {
+		return shelves;
+	}
+
+	const Size2i page_size(p_page_size, p_page_size);
+	shelves.resize(1);
+	for (uint32_t index : _canvas_texture_atlas_sort(r_items)) {
+		CanvasTextureAtlasItem &item = r_items[index];
+		if (!canvas_texture_atlas_fits(item.size, p_page_size, p_page_size)) {
+			continue; // Can never fit.
+		}
+
+		if (!canvas_texture_atlas_place(shelves[shelves.size() - 1], item, shelves.size() - 1, page_size)) {
+			if (int(shelves.size()) >= p_max_pages) {
+				break; // Out of pages.
+			}
+			shelves.push_back(CanvasTextureAtlasShelf());
+			canvas_texture_atlas_place(shelves[shelves.size() - 1], item, shelves.size() - 1, page_size);
+		}
+	}
+
+	if (shelves[shelves.size() - 1].get_used_height() == 0) {
+		shelves.resize(shelves.size() - 1);
+	}
+	return shelves;
+}
+
+void TextureStorage::update_canvas_texture_atlas() {
+	canvas_atlas.binds_saved_in_frame = canvas_atlas.binds_saved;
+	canvas_atlas.binds_saved = 0;
+
+	if (!canvas_atlas.dirty) {
+		return; //nothing to do
+	}
+
+	canvas_atlas.dirty = false;
+
+	if (canvas_atlas.textures.is_empty()) {
+		_canvas_texture_atlas_clear();
+		canvas_atlas.full = false;
+		canvas_atlas.removed = false;
+		return;
+	}
+
+	// New textures only go to the space left in the pages, blitting every texture again is only done when they overflow.
+	if (!_canvas_texture_atlas_add_pending()) {
+		_canvas_texture_atlas_repack();
+	}
+}
+
+bool TextureStorage::_canvas_texture_atlas_add_pending() {
+	if (canvas_atlas.pages.is_empty()) {
+		return false;
+	}
+
+	LocalVector<RID> item_textures;
+	LocalVector<CanvasTextureAtlasItem> items;
+	for (const KeyValue<RID, CanvasTextureAtlas::Texture> &E : canvas_atlas.textures) {
+		if (E.value.pending) {
+			CanvasTextureAtlasItem item;
+			item.size = E.value.size;
+			item_textures.push_back(E.key);
+			items.push_back(item);
+		}
+	}
+
+	const LocalVector<uint32_t> order = _canvas_texture_atlas_sort(items);
+	for (uint32_t index : order) {
+		bool placed = false;
+		for (uint32_t i = 0; i < canvas_atlas.pages.size() && !placed; i++) {
+			placed = canvas_texture_atlas_place(canvas_atlas.pages[i].shelf, items[index], i, canvas_atlas.pages[i].size);
+		}
+		if (!placed && (!canvas_atlas.full || canvas_atlas.removed)) {
+			// Repacking can still make room for it, either by growing the pages or by reclaiming the space of removed textures.
+			return false;
+		}
+	}
+
+	// Textures that didn't fit are drawn from the textures themselves, until the next repack.
+	LocalVector<LocalVector<RID>> page_textures;
+	page_textures.resize(canvas_atlas.pages.size());
+	for (uint32_t i = 0; i < items.size(); i++) {
+		CanvasTextureAtlas::Texture *t = canvas_atlas.textures.getptr(item_textures[i]);
+		t->pending = false;
+		t->page = items[i].page;
+		t->uv_rect = Rect2(items[i].position, items[i].size);
+		if (t->page >= 0) {
+			page_textures[t->page].push_back(item_textures[i]);
+		}
+	}
+
+	for (uint32_t i = 0; i < page_textures.size(); i++) {
+		if (!page_textures[i].is_empty()) {
+			_canvas_texture_atlas_blit(i, page_textures[i], false);
+		}
+	}
+	return true;
+}
+
+void TextureStorage::_canvas_texture_atlas_repack() {
+	_canvas_texture_atlas_clear();
+
+	const int page_size = canvas_atlas.page_size;
+
+	LocalVector<RID> item_textures;
+	LocalVector<CanvasTextureAtlasItem> items;
+	item_textures.reserve(canvas_atlas.textures.size());
+	items.reserve(canvas_atlas.textures.size());
+	for (const KeyValue<RID, CanvasTextureAtlas::Texture> &E : canvas_atlas.textures) {
+		CanvasTextureAtlasItem item;
+		item.size = E.value.size;
+		item_textures.push_back(E.key);
+		items.push_back(item);
+	}
+
+	// Textures that didn't fit are drawn from the textures themselves.
+	LocalVector<CanvasTextureAtlasShelf> shelves = canvas_texture_atlas_pack(items, page_size, canvas_atlas.max_pages);
+	LocalVector<LocalVector<RID>> page_textures;
+	page_textures.resize(shelves.size());
+	canvas_atlas.full = false;
+	canvas_atlas.removed = false;
+	for (uint32_t i = 0; i < items.size(); i++) {
+		CanvasTextureAtlas::Texture *t = canvas_atlas.textures.getptr(item_textures[i]);
+		t->pending = false;
+		t->page = items[i].page;
+		t->uv_rect = Rect2(items[i].position, items[i].size);
+		if (t->page >= 0) {
+			page_textures[t->page].push_back(item_textures[i]);
+		} else {
+			canvas_atlas.full = true;
+		}
+	}
+
+	for (uint32_t i = 0; i < shelves.size(); i++) {
+		CanvasTextureAtlas::Page atlas_page;
+		// Rounded up, so there is some room left for textures drawn later.
+		atlas_page.size = Size2i(page_size, MIN(page_size, int(nearest_power_of_2_templated(uint32_t(shelves[i].get_used_height())))));
+		atlas_page.shelf = shelves[i];
+
+		RD::TextureFormat tformat;
+		tformat.format = RD::DATA_FORMAT_R8G8B8A8_UNORM;
+		tformat.width = atlas_page.size.width;
+		tformat.height = atlas_page.size.height;
+		tformat.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT;
+		tformat.texture_type = RD::TEXTURE_TYPE_2D;
+		tformat.shareable_formats.push_back(RD::DATA_FORMAT_R8G8B8A8_UNORM);
+		tformat.shareable_formats.push_back(RD::DATA_FORMAT_R8G8B8A8_SRGB);
+
+		// Start from a placeholder and replace its storage, the same way render targets do.
+		atlas_page.texture = texture_allocate();
+		texture_2d_placeholder_initialize(atlas_page.texture);
+		Texture *tex = get_texture(atlas_page.texture);
+		tex->cleanup();
+		tex->canvas_texture = nullptr;
+
+		tex->rd_texture = RD::get_singleton()->texture_create(tformat, RD::TextureView());
+		RD::TextureView rd_view_srgb;
+		rd_view_srgb.format_override = RD::DATA_FORMAT_R8G8B8A8_SRGB;
+		tex->rd_texture_srgb = RD::get_singleton()->texture_create_shared(rd_view_srgb, tex->rd_texture);
+		tex->rd_view = RD::TextureView();
+		tex->width = atlas_page.size.width;
+		tex->height = atlas_page.size.height;
+		tex->width_2d = atlas_page.size.width;
+		tex->height_2d = atlas_page.size.height;
+		tex->rd_format = RD::DATA_FORMAT_R8G8B8A8_UNORM;
+		tex->rd_format_srgb = RD::DATA_FORMAT_R8G8B8A8_SRGB;
+		tex->format = Image::FORMAT_RGBA8;
+		tex->validated_format = Image::FORMAT_RGBA8;
+
+		canvas_atlas.pages.push_back(atlas_page);
+		canvas_atlas.excluded.insert(atlas_page.texture);
+
+		_canvas_texture_atlas_blit(i, page_textures[i], true);
+	}
+}
+
+void TextureStorage::_canvas_texture_atlas_blit(uint32_t p_page, const LocalVector<RID> &p_textures, bool p_clear) {
+	CopyEffects *copy_effects = CopyEffects::get_singleton();
+	ERR_FAIL_NULL(copy_effects);
+
+	const CanvasTextureAtlas::Page &atlas_page = canvas_atlas.pages[p_page];
+	Texture *page_tex = get_texture(atlas_page.texture);
+
+	Vector<RID> fb_textures;
+	fb_textures.push_back(page_tex->rd_texture);
+	RID fb = RD::get_singleton()->framebuffer_create(fb_textures);
+
+	Vector<Color> cc;
+	cc.push_back(Color(0, 0, 0, 0));
+
+	// Textures already in the page are kept when adding new ones.
+	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(fb, p_clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE, RD::INITIAL_ACTION_DISCARD, RD::FINAL_ACTION_DISCARD, cc);
+
+	for (const RID &texture : p_textures) {
+		CanvasTextureAtlas::Texture *t = canvas_atlas.textures.getptr(texture);
+
+		// Stored in pixels while packing, normalize to this page.
+		const Rect2 pixel_rect = t->uv_rect;
+		t->uv_rect.position /= Size2(atlas_page.size);
+		t->uv_rect.size /= Size2(atlas_page.size);
+
+		// The edge texels are extruded into the padding, so filtering at the edges of the texture samples them instead of its neighbors.
+		const Rect2 padded_rect = pixel_rect.grow(CANVAS_TEXTURE_ATLAS_PADDING);
+		const Size2 extrusion = Size2(CANVAS_TEXTURE_ATLAS_PADDING, CANVAS_TEXTURE_ATLAS_PADDING) / pixel_rect.size;
+		Texture *src_tex = get_texture(texture);
+		copy_effects->copy_to_atlas_fb(src_tex->rd_texture, fb, Rect2(padded_rect.position / Size2(atlas_page.size), padded_rect.size / Size2(atlas_page.size)), draw_list, false, false, extrusion);
+	}
+
+	RD::get_singleton()->draw_list_end();
+	RD::get_singleton()->free(fb);
+}
+
 /* DECAL INSTANCE API */
 
 RID TextureStorage::decal_instance_create(RID p_decal) {
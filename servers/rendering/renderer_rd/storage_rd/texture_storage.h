@@ -76,6 +76,14 @@ public:
 		TYPE_3D
 	};
 
+	// Space used in a canvas texture atlas page, textures are placed left to right in rows.
+	struct CanvasTextureAtlasShelf {
+		Point2i cursor; // Where the next texture of the current row goes.
+		int row_height = 0;
+
+		int get_used_height() const { return cursor.y + row_height; }
+	};
+
 private:
 	friend class LightStorage;
 	friend class MaterialStorage;
@@ -149,6 +157,7 @@ private:
 		RenderTarget *render_target = nullptr;
 		bool is_render_target;
 		bool is_proxy;
+		bool is_rd_texture = false; // Created with texture_rd_initialize().
 
 		Ref<Image> image_cache_2d;
 		String path;
@@ -258,6 +267,45 @@ private:
 		Size2i size;
 	} decal_atlas;
 
+	/* CANVAS TEXTURE ATLAS */
+
+	// Small 2D textures drawn by the canvas renderer are packed into shared pages,
+	// so consecutive rects using different textures don't need to rebind textures.
+	struct CanvasTextureAtlas {
+		struct Texture {
+			int page = -1; // Not packed yet, or didn't fit.
+			bool pending = true; // Packed on the next update.
+			Size2i size;
+			Rect2 uv_rect;
+		};
+
+		struct Page {
+			RID texture; // A regular texture, so it can be bound like any canvas texture.
+			Size2i size;
+			CanvasTextureAtlasShelf shelf; // New textures are added after the ones already in the page.
+		};
+
+		HashMap<RID, Texture> textures;
+		HashSet<RID> excluded;
+		LocalVector<Page> pages;
+		bool dirty = false;
+		bool full = false; // The last repack left textures out, repacking again only helps once some are removed.
+		bool removed = false; // Since the last repack.
+
+		bool enabled = false;
+		int max_texture_size = 256;
+		int page_size = 2048;
+		int max_pages = 4;
+
+		uint64_t binds_saved = 0;
+		uint64_t binds_saved_in_frame = 0;
+	} canvas_atlas;
+
+	void _canvas_texture_atlas_clear();
+	bool _canvas_texture_atlas_add_pending();
+	void _canvas_texture_atlas_repack();
+	void _canvas_texture_atlas_blit(uint32_t p_page, const LocalVector<RID> &p_textures, bool p_clear);
+
 	struct Decal {
 		Vector3 size = Vector3(2, 2, 2);
 		RID textures[RS::DECAL_TEXTURE_MAX];
@@ -595,6 +643,33 @@ public:
 	virtual void texture_add_to_decal_atlas(RID p_texture, bool p_panorama_to_dp = false) override;
 	virtual void texture_remove_from_decal_atlas(RID p_texture, bool p_panorama_to_dp = false) override;
 
+	/* CANVAS TEXTURE ATLAS API */
+
+	// Space left around each texture in the atlas pages, so linear filtering doesn't bleed neighbor textures in.
+	static constexpr int CANVAS_TEXTURE_ATLAS_PADDING = 2;
+
+	struct CanvasTextureAtlasItem {
+		Size2i size;
+		int page = -1; // Didn't fit.
+		Point2i position; // Of the texture itself, within the padding.
+	};
+
+	static bool canvas_texture_atlas_fits(const Size2i &p_size, int p_max_texture_size, int p_page_size);
+	// Places the item after the ones already on the shelf, if it still fits in the page.
+	static bool canvas_texture_atlas_place(CanvasTextureAtlasShelf &r_shelf, CanvasTextureAtlasItem &r_item, int p_page, const Size2i &p_page_size);
+	// Returns the shelf of each page used.
+	static LocalVector<CanvasTextureAtlasShelf> canvas_texture_atlas_pack(LocalVector<CanvasTextureAtlasItem> &r_items, int p_page_size, int p_max_pages);
+
+	void update_canvas_texture_atlas();
+
+	bool canvas_texture_atlas_is_enabled() const { return canvas_atlas.enabled; }
+	bool canvas_texture_atlas_get_texture(RID p_texture, RID &r_atlas_texture, Rect2 &r_uv_rect, Size2i &r_size);
+	void canvas_texture_atlas_mark_dirty_on_texture(RID p_texture);
+	void canvas_texture_atlas_remove_texture(RID p_texture);
+
+	_FORCE_INLINE_ void canvas_texture_atlas_add_bind_saved() { canvas_atlas.binds_saved++; }
+	uint64_t canvas_texture_atlas_get_binds_saved_in_frame() const { return canvas_atlas.binds_saved_in_frame; }
+
 	_FORCE_INLINE_ Vector3 decal_get_size(RID p_decal) {
 		const Decal *decal = decal_owner.get_or_null(p_decal);
 		return decal->size;
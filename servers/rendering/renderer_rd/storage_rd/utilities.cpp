@@ -34,6 +34,7 @@
 #include "light_storage.h"
 #include "mesh_storage.h"
 #include "particles_storage.h"
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "texture_storage.h"
 
 using namespace RendererRD;
@@ -254,6 +255,7 @@ void Utilities::update_dirty_resources() {
 	MeshStorage::get_singleton()->_update_dirty_multimeshes();
 	MeshStorage::get_singleton()->_update_dirty_skeletons();
 	TextureStorage::get_singleton()->update_decal_atlas();
+	TextureStorage::get_singleton()->update_canvas_texture_atlas();
 }
 
 bool Utilities::has_os_feature(const String &p_feature) const {
@@ -302,6 +304,12 @@ uint64_t Utilities::get_rendering_info(RS::RenderingInfo p_info) {
 		return buffer_mem_cache;
 	} else if (p_info == RS::RENDERING_INFO_VIDEO_MEM_USED) {
 		return total_mem_cache;
+	} else if (p_info == RS::RENDERING_INFO_SHADER_COMPILATIONS_QUEUED) {
+		return MaterialStorage::get_singleton()->get_shader_compilations_queued();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_COMPILATION_TIME) {
+		return MaterialStorage::get_singleton()->get_shader_compilation_time();
+	} else if (p_info == RS::RENDERING_INFO_CANVAS_TEXTURE_ATLAS_BINDS_SAVED) {
+		return TextureStorage::get_singleton()->canvas_texture_atlas_get_binds_saved_in_frame();
 	}
 	return 0;
 }
@@ -322,6 +330,18 @@ String Utilities::get_video_adapter_api_version() const {
 	return RenderingDevice::get_singleton()->get_device_api_version();
 }
 
+void Utilities::pipeline_variants_capture_start() {
+	PipelineCacheRD::capture_variants_begin();
+}
+
+Error Utilities::pipeline_variants_capture_stop(const String &p_path) {
+	return PipelineCacheRD::capture_variants_end(p_path);
+}
+
+bool Utilities::is_capturing_pipeline_variants() const {
+	return PipelineCacheRD::is_capturing_variants();
+}
+
 Size2i Utilities::get_maximum_viewport_size() const {
 	RenderingDevice *device = RenderingDevice::get_singleton();
 
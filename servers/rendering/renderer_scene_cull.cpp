@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "renderer_scene_occlusion_cull_software.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -426,6 +427,8 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_NULL(scenario);
+	_erase_frustum_cull_cache(scenario, p_viewport);
+
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
 		return;
 	}
@@ -1076,13 +1079,18 @@ void RendererSceneCull::instance_set_extra_visibility_margin(RID p_instance, rea
 void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabled) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
+	if (instance->ignore_all_culling == p_enabled) {
+		return;
+	}
 	instance->ignore_all_culling = p_enabled;
 
 	if (instance->scenario && instance->array_index >= 0) {
 		InstanceData &idata = instance->scenario->instance_data[instance->array_index];
 		if (instance->ignore_all_culling) {
+			instance->scenario->instance_ignore_all_culling_count++;
 			idata.flags |= InstanceData::FLAG_IGNORE_ALL_CULLING;
 		} else {
+			instance->scenario->instance_ignore_all_culling_count--;
 			idata.flags &= ~uint32_t(InstanceData::FLAG_IGNORE_ALL_CULLING);
 		}
 	}
@@ -1777,10 +1785,12 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 		if (p_instance->ignore_all_culling) {
 			idata.flags |= InstanceData::FLAG_IGNORE_ALL_CULLING;
+			p_instance->scenario->instance_ignore_all_culling_count++;
 		}
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_bounds_changed(p_instance->array_index);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1789,6 +1799,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_bounds_changed(p_instance->array_index);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1844,11 +1855,72 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
 
-	pair.pair();
+	if (defer_pairing) {
+		if (pair_query_count == pair_queries.size()) {
+			pair_queries.resize(pair_query_count + 1);
+		}
+		PairQuery &query = pair_queries[pair_query_count++];
+		query.instance = p_instance;
+		query.bvh = pair.bvh;
+		query.bvh2 = pair.bvh2;
+		query.pair_mask = pair.pair_mask;
+		query.cull_mask = pair.cull_mask;
+	} else {
+		pair.pair();
+	}
 
 	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
 }
 
+void RendererSceneCull::_pair_query(uint32_t p_index, PairQuery *p_queries) {
+	PairQuery &query = p_queries[p_index];
+	query.found.clear();
+
+	if (query.bvh) {
+		query.bvh->aabb_query(query.instance->transformed_aabb, query);
+	}
+	if (query.bvh2) {
+		query.bvh2->aabb_query(query.instance->transformed_aabb, query);
+	}
+}
+
+void RendererSceneCull::_run_pair_queries() {
+	// The indexers are not modified until the pairs are committed, so they can be queried from many threads.
+	if (pair_query_count >= threaded_pair_minimum_instances) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_pair_query, pair_queries.ptr(), pair_query_count, -1, true, SNAME("PairInstances"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < pair_query_count; i++) {
+			_pair_query(i, pair_queries.ptr());
+		}
+	}
+}
+
+void RendererSceneCull::_pair_deferred_instances() {
+	if (pair_query_count == 0) {
+		return;
+	}
+
+	_run_pair_queries();
+
+	for (uint32_t i = 0; i < pair_query_count; i++) {
+		PairQuery &query = pair_queries[i];
+
+		pair_pass++;
+
+		PairInstances pair;
+		pair.instance = query.instance;
+		pair.pair_allocator = &pair_allocator;
+		pair.pair_pass = pair_pass;
+		pair.pair(query.found);
+
+		query.instance = nullptr;
+		query.found.clear();
+	}
+
+	pair_query_count = 0;
+}
+
 void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	if (!p_instance->indexer_id.is_valid()) {
 		return; //nothing to do
@@ -1876,6 +1948,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_bounds_changed(p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1892,6 +1965,9 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	if (p_instance->ignore_all_culling) {
+		p_instance->scenario->instance_ignore_all_culling_count--;
+	}
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2728,6 +2804,185 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+uint32_t RendererSceneCull::InstanceBounds::cull_frustum(const InstanceBounds *p_bounds, uint32_t p_count, const Frustum &p_frustum, uint32_t *r_visible) {
+	// Bounds are transposed in groups of LANES, so every plane is tested against the whole
+	// group with the same instructions. This layout lets the compiler vectorize the loops.
+	const uint32_t LANES = 8;
+	uint32_t visible_count = 0;
+
+	for (uint32_t from = 0; from < p_count; from += LANES) {
+		const uint32_t lanes = MIN(LANES, p_count - from);
+
+		real_t bounds[6][LANES];
+		for (uint32_t l = 0; l < LANES; l++) {
+			// Pad the last group by repeating its last bounds.
+			const real_t *src = p_bounds[from + MIN(l, lanes - 1)].bounds;
+			for (uint32_t k = 0; k < 6; k++) {
+				bounds[k][l] = src[k];
+			}
+		}
+
+		uint32_t inside[LANES];
+		for (uint32_t l = 0; l < LANES; l++) {
+			inside[l] = 1;
+		}
+
+		for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+			const Plane &plane = p_frustum.planes_ptr[i];
+			const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+			const real_t *x = bounds[signs[0]];
+			const real_t *y = bounds[signs[1]];
+			const real_t *z = bounds[signs[2]];
+
+			uint32_t any_inside = 0;
+			for (uint32_t l = 0; l < LANES; l++) {
+				inside[l] &= uint32_t(plane.normal.x * x[l] + plane.normal.y * y[l] + plane.normal.z * z[l] - plane.d < 0.0);
+				any_inside |= inside[l];
+			}
+			if (!any_inside) {
+				break;
+			}
+		}
+
+		// Compact the indices of the visible bounds without branching.
+		for (uint32_t l = 0; l < lanes; l++) {
+			r_visible[visible_count] = from + l;
+			visible_count += inside[l];
+		}
+	}
+
+	return visible_count;
+}
+
+void RendererSceneCull::_erase_frustum_cull_cache(Scenario *p_scenario, RID p_viewport) {
+	const RID *cache_scenario = frustum_cull_cache_scenarios.getptr(p_viewport);
+	if (cache_scenario && *cache_scenario == p_scenario->self) {
+		frustum_cull_cache_scenarios.erase(p_viewport);
+	}
+
+	if (!p_scenario->frustum_cull_caches.erase(p_viewport)) {
+		return;
+	}
+	if (p_scenario->frustum_cull_caches.is_empty()) {
+		p_scenario->instance_bounds_changes_base += p_scenario->instance_bounds_changes.size();
+		p_scenario->instance_bounds_changes.clear();
+	}
+}
+
+void RendererSceneCull::_update_frustum_cull_cache_page(uint32_t p_page, FrustumCullCacheUpdate *p_update) {
+	const uint32_t page_size_shift = instance_aabb_page_pool.get_page_size_shift();
+	const uint32_t from = p_page << page_size_shift;
+	const uint32_t to = MIN(p_update->scenario->instance_aabbs.size(), uint64_t(from) + (1 << page_size_shift));
+
+	// Each page writes at its own offset, the results are compacted afterwards.
+	uint32_t *visible = &p_update->cache->visible[from];
+	uint32_t count = InstanceBounds::cull_frustum(&p_update->scenario->instance_aabbs[from], to - from, *p_update->frustum, visible);
+	for (uint32_t i = 0; i < count; i++) {
+		visible[i] += from;
+	}
+	p_update->cache->page_visible_counts[p_page] = count;
+}
+
+void RendererSceneCull::_update_frustum_cull_cache(Scenario *p_scenario, FrustumCullCache &r_cache, const Frustum &p_frustum) {
+	const uint32_t instance_count = p_scenario->instance_data.size();
+	const uint64_t changes_end = p_scenario->instance_bounds_changes_base + p_scenario->instance_bounds_changes.size();
+
+	if (r_cache.planes != p_frustum.planes || r_cache.changes_consumed < p_scenario->instance_bounds_changes_base) {
+		// The camera moved (or too much changed), test everything again.
+		const uint32_t page_size_shift = instance_aabb_page_pool.get_page_size_shift();
+
+		FrustumCullCacheUpdate update;
+		update.scenario = p_scenario;
+		update.cache = &r_cache;
+		update.frustum = &p_frustum;
+		update.page_count = (instance_count + (1 << page_size_shift) - 1) >> page_size_shift;
+
+		r_cache.visible.resize(instance_count);
+		r_cache.page_visible_counts.resize(update.page_count);
+
+		if (instance_count > thread_cull_threshold) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_update_frustum_cull_cache_page, &update, update.page_count, -1, true, SNAME("RenderCullFrustumCache"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < update.page_count; i++) {
+				_update_frustum_cull_cache_page(i, &update);
+			}
+		}
+
+		uint32_t visible_count = 0;
+		for (uint32_t i = 0; i < update.page_count; i++) {
+			uint32_t page_count = r_cache.page_visible_counts[i];
+			if (visible_count != (i << page_size_shift)) {
+				memmove(&r_cache.visible[visible_count], &r_cache.visible[i << page_size_shift], page_count * sizeof(uint32_t));
+			}
+			visible_count += page_count;
+		}
+		r_cache.visible.resize(visible_count);
+
+		r_cache.in_frustum.resize(instance_count);
+		memset(r_cache.in_frustum.ptr(), 0, instance_count);
+		for (uint32_t index : r_cache.visible) {
+			r_cache.in_frustum[index] = 1;
+		}
+
+		r_cache.planes = p_frustum.planes;
+		r_cache.changes_consumed = changes_end;
+		return;
+	}
+
+	// Only test the instances whose bounds changed since the last update.
+	bool needs_compact = false;
+	if (instance_count < r_cache.in_frustum.size()) {
+		needs_compact = true; // Instances were removed from the end.
+	} else if (instance_count > r_cache.in_frustum.size()) {
+		uint32_t prev_count = r_cache.in_frustum.size();
+		r_cache.in_frustum.resize(instance_count);
+		memset(&r_cache.in_frustum[prev_count], 0, instance_count - prev_count);
+	}
+	r_cache.in_frustum.resize(instance_count);
+
+	const uint32_t *changes = p_scenario->instance_bounds_changes.ptr();
+	for (uint64_t i = r_cache.changes_consumed - p_scenario->instance_bounds_changes_base; i < p_scenario->instance_bounds_changes.size(); i++) {
+		uint32_t index = changes[i];
+		if (index >= instance_count) {
+			continue;
+		}
+
+		uint8_t in_frustum = p_scenario->instance_aabbs[index].in_frustum(p_frustum) ? 1 : 0;
+		if (in_frustum == r_cache.in_frustum[index]) {
+			continue;
+		}
+
+		r_cache.in_frustum[index] = in_frustum;
+		if (in_frustum) {
+			r_cache.visible.push_back(index);
+		}
+		needs_compact = true;
+	}
+
+	if (needs_compact) {
+		uint32_t visible_count = 0;
+		for (uint32_t index : r_cache.visible) {
+			if (index < instance_count && r_cache.in_frustum[index]) {
+				r_cache.visible[visible_count++] = index;
+			}
+		}
+		r_cache.visible.resize(visible_count);
+		r_cache.visible.sort();
+
+		// An instance can leave and enter the frustum again between two updates.
+		visible_count = 0;
+		for (uint32_t i = 0; i < r_cache.visible.size(); i++) {
+			if (i == 0 || r_cache.visible[i] != r_cache.visible[i - 1]) {
+				r_cache.visible[visible_count++] = r_cache.visible[i];
+			}
+		}
+		r_cache.visible.resize(visible_count);
+	}
+
+	r_cache.changes_consumed = changes_end;
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2749,7 +3004,60 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// The camera frustum test is done ahead for a chunk of instances at a time. When nothing
+	// else may need instances outside of the camera frustum, only the visible ones are visited.
+	const uint32_t CULL_CHUNK_SIZE = 256;
+	uint32_t chunk_visible[CULL_CHUNK_SIZE];
+	uint32_t chunk_visible_count = 0;
+	uint32_t chunk_visible_next = 0;
+	uint64_t chunk_from = p_from;
+	uint64_t chunk_to = p_from;
+	const uint32_t page_size_shift = instance_aabb_page_pool.get_page_size_shift();
+	const bool visit_visible_only = cull_data.cull->shadow_count == 0 && cull_data.cull->sdfgi.region_count == 0 && cull_data.scenario->instance_ignore_all_culling_count == 0;
+
+	// When cached results are available, they are split into chunks instead of testing the bounds.
+	const uint32_t *cached_visible = nullptr;
+	uint32_t cached_visible_count = 0;
+	uint32_t cached_visible_next = 0;
+	if (cull_data.frustum_visible) {
+		cached_visible = cull_data.frustum_visible->ptr();
+		cached_visible_count = cull_data.frustum_visible->size();
+		uint32_t hi = cached_visible_count;
+		while (cached_visible_next < hi) {
+			uint32_t mid = (cached_visible_next + hi) / 2;
+			if (cached_visible[mid] < p_from) {
+				cached_visible_next = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+	}
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (i == chunk_to) {
+			// Chunks must not cross pages, so their bounds are contiguous.
+			chunk_from = i;
+			chunk_to = MIN(MIN(p_to, i + CULL_CHUNK_SIZE), ((i >> page_size_shift) + 1) << page_size_shift);
+			if (cached_visible) {
+				chunk_visible_count = 0;
+				while (cached_visible_next < cached_visible_count && cached_visible[cached_visible_next] < chunk_to) {
+					chunk_visible[chunk_visible_count++] = cached_visible[cached_visible_next++] - chunk_from;
+				}
+			} else {
+				chunk_visible_count = InstanceBounds::cull_frustum(&cull_data.scenario->instance_aabbs[i], chunk_to - i, cull_data.cull->frustum, chunk_visible);
+			}
+			chunk_visible_next = 0;
+		}
+
+		bool in_camera_frustum = chunk_visible_next < chunk_visible_count && chunk_from + chunk_visible[chunk_visible_next] == i;
+		if (in_camera_frustum) {
+			chunk_visible_next++;
+		} else if (visit_visible_only) {
+			// Jump to the next visible instance, or to the next chunk.
+			i = (chunk_visible_next < chunk_visible_count ? chunk_from + chunk_visible[chunk_visible_next] : chunk_to) - 1;
+			continue;
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2765,7 +3073,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && in_camera_frustum && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3144,6 +3452,32 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+
+		if (use_temporal_coherence && p_viewport.is_valid() && !render_reflection_probe) {
+			FrustumCullCache *cache = scenario->frustum_cull_caches.getptr(p_viewport);
+			if (!cache) {
+				// The viewport moved to another scenario, so the cache it left behind is never consumed again.
+				const RID *previous = frustum_cull_cache_scenarios.getptr(p_viewport);
+				Scenario *previous_scenario = previous ? scenario_owner.get_or_null(*previous) : nullptr;
+				if (previous_scenario) {
+					_erase_frustum_cull_cache(previous_scenario, p_viewport);
+				}
+				frustum_cull_cache_scenarios[p_viewport] = scenario->self;
+				cache = &scenario->frustum_cull_caches.insert(p_viewport, FrustumCullCache())->value;
+			}
+			_update_frustum_cull_cache(scenario, *cache, cull.frustum);
+			cull_data.frustum_visible = &cache->visible;
+
+			// Drop the changes every cache has seen.
+			uint64_t consumed = UINT64_MAX;
+			for (const KeyValue<RID, FrustumCullCache> &E : scenario->frustum_cull_caches) {
+				consumed = MIN(consumed, E.value.changes_consumed);
+			}
+			if (consumed == scenario->instance_bounds_changes_base + scenario->instance_bounds_changes.size()) {
+				scenario->instance_bounds_changes_base = consumed;
+				scenario->instance_bounds_changes.clear();
+			}
+		}
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -4070,7 +4404,15 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 
 void RendererSceneCull::update_dirty_instances() {
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		// Pairing is deferred until all instances are updated, so it can be done as a batch.
+		defer_pairing = true;
+		while (_instance_update_list.first()) {
+			_update_dirty_instance(_instance_update_list.first()->self());
+		}
+		defer_pairing = false;
+
+		// Committing the pairs may queue more instances for update.
+		_pair_deferred_instances();
 	}
 
 	// Update dirty resources after dirty instances as instance updates may affect resources.
@@ -4115,6 +4457,10 @@ bool RendererSceneCull::free(RID p_rid) {
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
+		for (const KeyValue<RID, FrustumCullCache> &E : scenario->frustum_cull_caches) {
+			frustum_cull_cache_scenarios.erase(E.key);
+		}
+
 		RSG::light_storage->shadow_atlas_free(scenario->reflection_probe_shadow_atlas);
 		RSG::light_storage->reflection_atlas_free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
@@ -4212,8 +4558,9 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	use_temporal_coherence = GLOBAL_GET("rendering/limits/spatial_indexer/use_temporal_coherence");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	software_occlusion_culling = memnew(RendererSceneOcclusionCullSoftware);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4239,8 +4586,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (software_occlusion_culling) {
+		memdelete(software_occlusion_culling);
 	}
 
 	if (light_culler) {
@@ -56,7 +56,8 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		MAX_INSTANCE_BOUNDS_CHANGES = 65536
 	};
 
 	uint64_t render_pass;
@@ -118,7 +119,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *software_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -241,6 +242,21 @@ public:
 
 			return true;
 		}
+
+		// Same test as in_frustum(), for many contiguous bounds at once. Writes the indices
+		// of the bounds inside the frustum to r_visible (which must fit p_count entries)
+		// in increasing order, and returns how many were written.
+		static uint32_t cull_frustum(const InstanceBounds *p_bounds, uint32_t p_count, const Frustum &p_frustum, uint32_t *r_visible);
+	};
+
+	// Camera frustum test results kept from the previous frame of a viewport, so that only
+	// instances whose bounds changed are tested again while the camera doesn't move.
+	struct FrustumCullCache {
+		Vector<Plane> planes;
+		uint64_t changes_consumed = 0; // Position reached in Scenario::instance_bounds_changes.
+		LocalVector<uint8_t> in_frustum; // Per instance_data index.
+		LocalVector<uint32_t> visible; // Sorted instance_data indices inside the frustum.
+		LocalVector<uint32_t> page_visible_counts;
 	};
 
 	struct InstanceVisibilityNotifierData;
@@ -336,6 +352,24 @@ public:
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
+		uint32_t instance_ignore_all_culling_count = 0; // Instances in instance_data with FLAG_IGNORE_ALL_CULLING.
+
+		// Indices in instance_data whose bounds changed, only logged while there are frustum cull caches to consume them.
+		LocalVector<uint32_t> instance_bounds_changes;
+		uint64_t instance_bounds_changes_base = 0; // Number of changes dropped from the front of instance_bounds_changes.
+		HashMap<RID, FrustumCullCache> frustum_cull_caches; // Per viewport.
+
+		_FORCE_INLINE_ void instance_bounds_changed(uint32_t p_index) {
+			if (frustum_cull_caches.is_empty()) {
+				return;
+			}
+			if (instance_bounds_changes.size() >= (uint32_t)MAX_INSTANCE_BOUNDS_CHANGES) {
+				// Caches that are this far behind are rebuilt from scratch.
+				instance_bounds_changes_base += instance_bounds_changes.size();
+				instance_bounds_changes.clear();
+			}
+			instance_bounds_changes.push_back(p_index);
+		}
 
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
@@ -810,16 +844,24 @@ public:
 		uint64_t pair_pass;
 		uint32_t cull_mask = 0xFFFFFFFF; // Needed for decals and lights in the mobile and compatibility renderers.
 
+		_FORCE_INLINE_ static bool can_pair(const Instance *p_instance, const Instance *p_other, uint32_t p_pair_mask, uint32_t p_cull_mask) {
+			//test is more coarse in indexer
+			return p_instance != p_other && p_instance->transformed_aabb.intersects(p_other->transformed_aabb) && (p_pair_mask & (1 << p_other->base_type)) && (p_cull_mask & p_other->layer_mask);
+		}
+
+		_FORCE_INLINE_ void add_found(Instance *p_instance) {
+			p_instance->pair_check = pair_pass;
+			InstancePair *pair = pair_allocator->alloc();
+			pair->a = instance;
+			pair->b = p_instance;
+			pairs_found.add(&pair->list_a);
+		}
+
 		_FORCE_INLINE_ bool operator()(void *p_data) {
 			Instance *p_instance = (Instance *)p_data;
 
-			if (instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type)) && (cull_mask & p_instance->layer_mask)) {
-				//test is more coarse in indexer
-				p_instance->pair_check = pair_pass;
-				InstancePair *pair = pair_allocator->alloc();
-				pair->a = instance;
-				pair->b = p_instance;
-				pairs_found.add(&pair->list_a);
+			if (can_pair(instance, p_instance, pair_mask, cull_mask)) {
+				add_found(p_instance);
 			}
 			return false;
 		}
@@ -831,6 +873,18 @@ public:
 			if (bvh2) {
 				bvh2->aabb_query(instance->transformed_aabb, *this);
 			}
+			commit();
+		}
+
+		// Same as pair(), but with the indexer queries done beforehand.
+		void pair(const LocalVector<Instance *> &p_found) {
+			for (Instance *found : p_found) {
+				add_found(found);
+			}
+			commit();
+		}
+
+		void commit() {
 			while (instance->pairs.first()) {
 				InstancePair *pair = instance->pairs.first()->self();
 				Instance *other_instance = instance == pair->a ? pair->b : pair->a;
@@ -858,6 +912,35 @@ public:
 		}
 	};
 
+	// Indexer queries of the instances updated by update_dirty_instances(), which run in parallel.
+	// Pairs are then committed on the calling thread in update order, so the results don't depend on threading.
+	struct PairQuery {
+		Instance *instance = nullptr;
+		DynamicBVH *bvh = nullptr;
+		DynamicBVH *bvh2 = nullptr;
+		uint32_t pair_mask = 0;
+		uint32_t cull_mask = 0xFFFFFFFF;
+		LocalVector<Instance *> found;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+
+			if (PairInstances::can_pair(instance, p_instance, pair_mask, cull_mask)) {
+				found.push_back(p_instance);
+			}
+			return false;
+		}
+	};
+
+	bool defer_pairing = false;
+	LocalVector<PairQuery> pair_queries;
+	uint32_t pair_query_count = 0;
+	uint32_t threaded_pair_minimum_instances = 64;
+
+	void _pair_query(uint32_t p_index, PairQuery *p_queries);
+	void _run_pair_queries();
+	void _pair_deferred_instances();
+
 	HashSet<Instance *> heightfield_particle_colliders_update_list;
 
 	PagedArrayPool<Instance *> instance_cull_page_pool;
@@ -997,6 +1080,20 @@ public:
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
+	bool use_temporal_coherence = false;
+
+	struct FrustumCullCacheUpdate {
+		Scenario *scenario = nullptr;
+		FrustumCullCache *cache = nullptr;
+		const Frustum *frustum = nullptr;
+		uint32_t page_count = 0;
+	};
+
+	void _update_frustum_cull_cache_page(uint32_t p_page, FrustumCullCacheUpdate *p_update);
+	void _update_frustum_cull_cache(Scenario *p_scenario, FrustumCullCache &r_cache, const Frustum &p_frustum);
+	void _erase_frustum_cull_cache(Scenario *p_scenario, RID p_viewport);
+
+	HashMap<RID, RID> frustum_cull_cache_scenarios; // Scenario holding the frustum cull cache of each viewport.
 
 	RID_Owner<Instance, true> instance_owner;
 
@@ -1127,6 +1224,7 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		const LocalVector<uint32_t> *frustum_visible = nullptr; // Cached camera frustum test results, if any.
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
@@ -0,0 +1,467 @@
+/**************************************************************************/
+/*  renderer_scene_occlusion_cull_software.cpp                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_occlusion_cull_software.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::begin(const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	cam_inv_transform = p_cam_transform.affine_inverse();
+	cam_projection = p_cam_projection;
+	z_near = p_cam_projection.get_z_near();
+	debug_tex_range = p_cam_projection.get_z_far();
+	triangles.clear();
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::add_mesh(const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count) {
+	view_vertices.resize(p_vertex_count);
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		view_vertices[i] = cam_inv_transform.xform(p_vertices[i]);
+	}
+
+	Vector3 triangle[3];
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		if (p_indices[i] >= p_vertex_count || p_indices[i + 1] >= p_vertex_count || p_indices[i + 2] >= p_vertex_count) {
+			continue;
+		}
+		triangle[0] = view_vertices[p_indices[i]];
+		triangle[1] = view_vertices[p_indices[i + 1]];
+		triangle[2] = view_vertices[p_indices[i + 2]];
+		_add_triangle(triangle);
+	}
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::_add_triangle(const Vector3 *p_view_vertices) {
+	// Clip against the near plane, which can turn the triangle into a quad.
+	Vector3 polygon[4];
+	int count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view_vertices[i];
+		const Vector3 &b = p_view_vertices[(i + 1) % 3];
+		real_t da = -a.z - z_near;
+		real_t db = -b.z - z_near;
+
+		if (da >= 0) {
+			polygon[count++] = a;
+		}
+		if ((da >= 0) != (db >= 0)) {
+			polygon[count++] = a.lerp(b, da / (da - db));
+		}
+	}
+
+	if (count < 3) {
+		return;
+	}
+
+	_emit_triangle(polygon[0], polygon[1], polygon[2]);
+	if (count == 4) {
+		_emit_triangle(polygon[0], polygon[2], polygon[3]);
+	}
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::_emit_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+	const Vector3 *view[3] = { &p_a, &p_b, &p_c };
+	const Size2i &size = sizes[0];
+
+	float x[3];
+	float y[3];
+	float depth_w[3];
+	float inv_w[3];
+
+	for (int i = 0; i < 3; i++) {
+		Plane projected = cam_projection.xform4(Plane(*view[i], 1.0));
+		if (projected.d <= 0) {
+			return;
+		}
+		inv_w[i] = 1.0f / projected.d;
+		x[i] = (projected.normal.x * inv_w[i] * 0.5f + 0.5f) * size.x;
+		y[i] = (projected.normal.y * inv_w[i] * 0.5f + 0.5f) * size.y;
+		depth_w[i] = -view[i]->z * inv_w[i];
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0) {
+		// Occluders are double-sided, so just flip the winding.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(depth_w[1], depth_w[2]);
+		SWAP(inv_w[1], inv_w[2]);
+		area = -area;
+	}
+
+	// Only pixels whose centers are covered are rasterized.
+	float min_x = CLAMP(MIN(x[0], MIN(x[1], x[2])) - 0.5f, 0.0f, float(size.x));
+	float max_x = CLAMP(MAX(x[0], MAX(x[1], x[2])) - 0.5f, -1.0f, float(size.x - 1));
+	float min_y = CLAMP(MIN(y[0], MIN(y[1], y[2])) - 0.5f, 0.0f, float(size.y));
+	float max_y = CLAMP(MAX(y[0], MAX(y[1], y[2])) - 0.5f, -1.0f, float(size.y - 1));
+
+	Triangle t;
+	t.min_x = int(Math::ceil(min_x));
+	t.max_x = int(Math::floor(max_x));
+	t.min_y = int(Math::ceil(min_y));
+	t.max_y = int(Math::floor(max_y));
+
+	if (t.min_x > t.max_x || t.min_y > t.max_y) {
+		return;
+	}
+
+	// Edge i is opposite to vertex i, so it evaluates to the (scaled) barycentric weight of that vertex.
+	for (int i = 0; i < 3; i++) {
+		int a = (i + 1) % 3;
+		int b = (i + 2) % 3;
+		t.edge_a[i] = y[a] - y[b];
+		t.edge_b[i] = x[b] - x[a];
+		t.edge_c[i] = x[a] * y[b] - x[b] * y[a];
+	}
+
+	float inv_area = 1.0f / area;
+	for (int i = 0; i < 3; i++) {
+		const float *edge = i == 0 ? t.edge_a : (i == 1 ? t.edge_b : t.edge_c);
+		t.depth_w[i] = (edge[0] * depth_w[0] + edge[1] * depth_w[1] + edge[2] * depth_w[2]) * inv_area;
+		t.inv_w[i] = (edge[0] * inv_w[0] + edge[1] * inv_w[1] + edge[2] * inv_w[2]) * inv_area;
+	}
+
+	triangles.push_back(t);
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::_rasterize_band(uint32_t p_band, void *p_userdata) {
+	int height = sizes[0].y;
+	int from = p_band * height / band_count;
+	int to = (p_band + 1 == band_count) ? height : ((p_band + 1) * height / band_count);
+	_rasterize_rows(from, to);
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::_rasterize_rows(int p_from, int p_to) {
+	const int width = sizes[0].x;
+	float *depth = mips[0];
+
+	for (const Triangle &t : triangles) {
+		int y_begin = MAX(t.min_y, p_from);
+		int y_end = MIN(t.max_y + 1, p_to);
+
+		// Copied to locals so the compiler doesn't have to assume they alias the depth rows.
+		const float a0 = t.edge_a[0];
+		const float a1 = t.edge_a[1];
+		const float a2 = t.edge_a[2];
+		const float depth_a = t.depth_w[0];
+		const float inv_w_a = t.inv_w[0];
+		const int min_x = t.min_x;
+		const int max_x = t.max_x;
+
+		for (int y = y_begin; y < y_end; y++) {
+			const float py = y + 0.5f;
+			const float e0 = t.edge_b[0] * py + t.edge_c[0];
+			const float e1 = t.edge_b[1] * py + t.edge_c[1];
+			const float e2 = t.edge_b[2] * py + t.edge_c[2];
+			const float row_depth = t.depth_w[1] * py + t.depth_w[2];
+			const float row_inv_w = t.inv_w[1] * py + t.inv_w[2];
+			float *row = depth + y * width;
+
+			// Branchless so it can be vectorized.
+			for (int x = min_x; x <= max_x; x++) {
+				const float px = x + 0.5f;
+				const float w0 = a0 * px + e0;
+				const float w1 = a1 * px + e1;
+				const float w2 = a2 * px + e2;
+				const float d = (depth_a * px + row_depth) / (inv_w_a * px + row_inv_w);
+				const bool covered = (w0 >= 0.0f) & (w1 >= 0.0f) & (w2 >= 0.0f) & (d < row[x]);
+				row[x] = covered ? d : row[x];
+			}
+		}
+	}
+}
+
+void RendererSceneOcclusionCullSoftware::SoftwareHZBuffer::rasterize() {
+	const Size2i &size = sizes[0];
+	float *depth = mips[0];
+	for (int i = 0; i < size.x * size.y; i++) {
+		depth[i] = FLT_MAX;
+	}
+
+	if (triangles.is_empty()) {
+		return;
+	}
+
+	// Split the buffer into horizontal bands so every thread writes to its own rows.
+	band_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), (uint32_t)size.y);
+	if (triangles.size() < 64 || band_count <= 1) {
+		_rasterize_rows(0, size.y);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SoftwareHZBuffer::_rasterize_band, (void *)nullptr, band_count, -1, true, SNAME("SoftwareOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RendererSceneOcclusionCullSoftware::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RendererSceneOcclusionCullSoftware::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RendererSceneOcclusionCullSoftware::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RendererSceneOcclusionCullSoftware::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices.resize(p_indices.size());
+	for (int i = 0; i < p_indices.size(); i++) {
+		occluder->indices[i] = p_indices[i];
+	}
+
+	_mark_users_dirty(occluder);
+}
+
+void RendererSceneOcclusionCullSoftware::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	_mark_users_dirty(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+void RendererSceneOcclusionCullSoftware::_mark_users_dirty(Occluder *p_occluder) {
+	for (const InstanceID &E : p_occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		scenario->dirty_instances.insert(E.instance);
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullSoftware::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RendererSceneOcclusionCullSoftware::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RendererSceneOcclusionCullSoftware::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		instance = &scenario->instances.insert(p_instance, OccluderInstance())->value;
+		scenario->dirty_instances.insert(p_instance);
+	}
+
+	if (instance->occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance->occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance->occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		scenario->dirty_instances.insert(p_instance);
+	}
+
+	if (instance->xform != p_xform) {
+		instance->xform = p_xform;
+		scenario->dirty_instances.insert(p_instance);
+	}
+
+	instance->enabled = p_enabled;
+}
+
+void RendererSceneOcclusionCullSoftware::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+
+	scenario->instances.erase(p_instance);
+	scenario->dirty_instances.erase(p_instance);
+}
+
+void RendererSceneOcclusionCullSoftware::Scenario::update(RID_PtrOwner<Occluder> &p_occluder_owner) {
+	for (const RID &rid : dirty_instances) {
+		OccluderInstance *instance = instances.getptr(rid);
+		if (!instance) {
+			continue;
+		}
+
+		instance->xformed_vertices.clear();
+		instance->aabb = AABB();
+
+		const Occluder *occluder = p_occluder_owner.get_or_null(instance->occluder);
+		if (!occluder || occluder->vertices.is_empty()) {
+			continue;
+		}
+
+		const Vector3 *read = occluder->vertices.ptr();
+		uint32_t vertex_count = occluder->vertices.size();
+		instance->xformed_vertices.resize(vertex_count);
+		Vector3 *write = instance->xformed_vertices.ptr();
+
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			write[i] = instance->xform.xform(read[i]);
+		}
+
+		instance->aabb.position = write[0];
+		for (uint32_t i = 1; i < vertex_count; i++) {
+			instance->aabb.expand_to(write[i]);
+		}
+	}
+
+	dirty_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullSoftware::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = SoftwareHZBuffer();
+}
+
+void RendererSceneOcclusionCullSoftware::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RendererSceneOcclusionCullSoftware::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RendererSceneOcclusionCullSoftware::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RendererSceneOcclusionCullSoftware::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	SoftwareHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	scenario->update(occluder_owner);
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+
+	buffer->begin(p_cam_transform, p_cam_projection);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.xformed_vertices.is_empty()) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder) {
+			continue;
+		}
+
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			if (plane.distance_to(instance.aabb.get_support(-plane.normal)) > 0) {
+				outside = true;
+				break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		buffer->add_mesh(instance.xformed_vertices.ptr(), instance.xformed_vertices.size(), occluder->indices.ptr(), occluder->indices.size());
+	}
+
+	buffer->rasterize();
+	buffer->update_mips();
+}
+
+RendererSceneOcclusionCull::HZBuffer *RendererSceneOcclusionCullSoftware::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RendererSceneOcclusionCullSoftware::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RendererSceneOcclusionCullSoftware::RendererSceneOcclusionCullSoftware() {
+}
+
+RendererSceneOcclusionCullSoftware::~RendererSceneOcclusionCullSoftware() {
+	List<RID> occluders;
+	occluder_owner.get_owned_list(&occluders);
+	for (const RID &rid : occluders) {
+		memdelete(occluder_owner.get_or_null(rid));
+		occluder_owner.free(rid);
+	}
+}
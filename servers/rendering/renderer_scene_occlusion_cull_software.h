@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  renderer_scene_occlusion_cull_software.h                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_SCENE_OCCLUSION_CULL_SOFTWARE_H
+#define RENDERER_SCENE_OCCLUSION_CULL_SOFTWARE_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes occluder triangles into the depth buffer on the CPU.
+// It is always available, and is replaced by the raycast module backend when that module is enabled.
+class RendererSceneOcclusionCullSoftware : public RendererSceneOcclusionCull {
+public:
+	class SoftwareHZBuffer : public HZBuffer {
+	public:
+		// Screen-space triangle, set up so that edge functions and interpolated
+		// attributes are plane equations evaluated at pixel centers.
+		struct Triangle {
+			float edge_a[3];
+			float edge_b[3];
+			float edge_c[3];
+			// Depth / w and 1 / w are affine in screen space; their ratio is the view-space depth.
+			float depth_w[3];
+			float inv_w[3];
+			int min_x = 0;
+			int max_x = 0;
+			int min_y = 0;
+			int max_y = 0;
+		};
+
+	private:
+		Transform3D cam_inv_transform;
+		Projection cam_projection;
+		float z_near = 0.0f;
+		uint32_t band_count = 1;
+
+		LocalVector<Vector3> view_vertices;
+
+		void _add_triangle(const Vector3 *p_view_vertices);
+		void _emit_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c);
+		void _rasterize_band(uint32_t p_band, void *p_userdata);
+		void _rasterize_rows(int p_from, int p_to);
+
+	public:
+		RID scenario_rid;
+		LocalVector<Triangle> triangles;
+
+		void begin(const Transform3D &p_cam_transform, const Projection &p_cam_projection);
+		void add_mesh(const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count);
+		void rasterize();
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		LocalVector<uint32_t> indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<Vector3> xformed_vertices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances;
+
+		void update(RID_PtrOwner<Occluder> &p_occluder_owner);
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, SoftwareHZBuffer> buffers;
+
+	void _mark_users_dirty(Occluder *p_occluder);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RendererSceneOcclusionCullSoftware();
+	~RendererSceneOcclusionCullSoftware();
+};
+
+#endif // RENDERER_SCENE_OCCLUSION_CULL_SOFTWARE_H
@@ -116,12 +116,6 @@ static uint32_t _get_device_type_score(const RenderingContextDriver::Device &p_d
 
 #define RENDER_GRAPH_FULL_BARRIERS 0
 
-// The command graph can automatically issue secondary command buffers and record them on background threads when they reach an arbitrary
-// size threshold. This can be very beneficial towards reducing the time the main thread takes to record all the rendering commands. However,
-// this setting is not enabled by default as it's been shown to cause some strange issues with certain IHVs that have yet to be understood.
-
-#define SECONDARY_COMMAND_BUFFERS_PER_FRAME 0
-
 RenderingDevice *RenderingDevice::singleton = nullptr;
 
 RenderingDevice *RenderingDevice::get_singleton() {
@@ -1977,6 +1971,19 @@ RenderingDevice::TextureSamples RenderingDevice::framebuffer_format_get_texture_
 	return E->value.pass_samples[p_pass];
 }
 
+bool RenderingDevice::framebuffer_format_get_description(FramebufferFormatID p_format, Vector<AttachmentFormat> &r_attachments, Vector<FramebufferPass> &r_passes, uint32_t &r_view_count) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<FramebufferFormatID, FramebufferFormat>::Iterator E = framebuffer_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, false);
+
+	const FramebufferFormatKey &key = E->value.E->key();
+	r_attachments = key.attachments;
+	r_passes = key.passes;
+	r_view_count = key.view_count;
+	return true;
+}
+
 RID RenderingDevice::framebuffer_create_empty(const Size2i &p_size, TextureSamples p_samples, FramebufferFormatID p_format_check) {
 	_THREAD_SAFE_METHOD_
 	Framebuffer framebuffer;
@@ -2212,6 +2219,14 @@ RenderingDevice::VertexFormatID RenderingDevice::vertex_format_create(const Vect
 	return id;
 }
 
+Vector<RenderingDevice::VertexAttribute> RenderingDevice::vertex_format_get_attributes(VertexFormatID p_vertex_format) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<VertexFormatID, VertexDescriptionCache>::Iterator E = vertex_formats.find(p_vertex_format);
+	ERR_FAIL_COND_V(!E, Vector<VertexAttribute>());
+	return E->value.vertex_formats;
+}
+
 RID RenderingDevice::vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets) {
 	_THREAD_SAFE_METHOD_
 
@@ -2426,6 +2441,7 @@ RID RenderingDevice::shader_create_from_bytecode(const Vector<uint8_t> &p_shader
 	shader->name = name;
 	shader->driver_id = shader_id;
 	shader->layout_hash = driver->shader_get_layout_hash(shader_id);
+	shader->binary_hash = (uint64_t(hash_murmur3_buffer(p_shader_binary.ptr(), p_shader_binary.size())) << 32) | hash_djb2_buffer(p_shader_binary.ptr(), p_shader_binary.size());
 
 	for (int i = 0; i < shader->uniform_sets.size(); i++) {
 		uint32_t format = 0; // No format, default.
@@ -2491,6 +2507,14 @@ uint64_t RenderingDevice::shader_get_vertex_input_attribute_mask(RID p_shader) {
 	return shader->vertex_input_mask;
 }
 
+uint64_t RenderingDevice::shader_get_binary_hash(RID p_shader) {
+	_THREAD_SAFE_METHOD_
+
+	const Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, 0);
+	return shader->binary_hash;
+}
+
 /******************/
 /**** UNIFORMS ****/
 /******************/
@@ -3754,6 +3778,43 @@ void RenderingDevice::draw_list_set_push_constant(DrawListID p_list, const void
 #endif
 }
 
+bool RenderingDevice::_draw_list_bind_uniform_sets(DrawList *p_draw_list) {
+	for (uint32_t i = 0; i < p_draw_list->state.set_count; i++) {
+		if (p_draw_list->state.sets[i].pipeline_expected_format == 0) {
+			continue; // Nothing expected by this pipeline.
+		}
+#ifdef DEBUG_ENABLED
+		if (p_draw_list->state.sets[i].pipeline_expected_format != p_draw_list->state.sets[i].uniform_set_format) {
+			if (p_draw_list->state.sets[i].uniform_set_format == 0) {
+				ERR_FAIL_V_MSG(false, "Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline");
+			} else if (uniform_set_owner.owns(p_draw_list->state.sets[i].uniform_set)) {
+				UniformSet *us = uniform_set_owner.get_or_null(p_draw_list->state.sets[i].uniform_set);
+				ERR_FAIL_V_MSG(false, "Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(p_draw_list->state.pipeline_shader));
+			} else {
+				ERR_FAIL_V_MSG(false, "Uniforms supplied for set (" + itos(i) + ", which was was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(p_draw_list->state.pipeline_shader));
+			}
+		}
+#endif
+		draw_graph.add_draw_list_uniform_set_prepare_for_use(p_draw_list->state.pipeline_shader_driver_id, p_draw_list->state.sets[i].uniform_set_driver_id, i);
+	}
+	for (uint32_t i = 0; i < p_draw_list->state.set_count; i++) {
+		if (p_draw_list->state.sets[i].pipeline_expected_format == 0) {
+			continue; // Nothing expected by this pipeline.
+		}
+		if (!p_draw_list->state.sets[i].bound) {
+			// All good, see if this requires re-binding.
+			draw_graph.add_draw_list_bind_uniform_set(p_draw_list->state.pipeline_shader_driver_id, p_draw_list->state.sets[i].uniform_set_driver_id, i);
+
+			UniformSet *uniform_set = uniform_set_owner.get_or_null(p_draw_list->state.sets[i].uniform_set);
+			draw_graph.add_draw_list_usages(uniform_set->draw_trackers, uniform_set->draw_trackers_usage);
+
+			p_draw_list->state.sets[i].bound = true;
+		}
+	}
+
+	return true;
+}
+
 void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances, uint32_t p_procedural_vertices) {
 	DrawList *dl = _get_draw_list_ptr(p_list);
 	ERR_FAIL_NULL(dl);
@@ -3785,38 +3846,8 @@ void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint
 #endif
 
 	// Bind descriptor sets.
-
-	for (uint32_t i = 0; i < dl->state.set_count; i++) {
-		if (dl->state.sets[i].pipeline_expected_format == 0) {
-			continue; // Nothing expected by this pipeline.
-		}
-#ifdef DEBUG_ENABLED
-		if (dl->state.sets[i].pipeline_expected_format != dl->state.sets[i].uniform_set_format) {
-			if (dl->state.sets[i].uniform_set_format == 0) {
-				ERR_FAIL_MSG("Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline");
-			} else if (uniform_set_owner.owns(dl->state.sets[i].uniform_set)) {
-				UniformSet *us = uniform_set_owner.get_or_null(dl->state.sets[i].uniform_set);
-				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
-			} else {
-				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + ", which was was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
-			}
-		}
-#endif
-		draw_graph.add_draw_list_uniform_set_prepare_for_use(dl->state.pipeline_shader_driver_id, dl->state.sets[i].uniform_set_driver_id, i);
-	}
-	for (uint32_t i = 0; i < dl->state.set_count; i++) {
-		if (dl->state.sets[i].pipeline_expected_format == 0) {
-			continue; // Nothing expected by this pipeline.
-		}
-		if (!dl->state.sets[i].bound) {
-			// All good, see if this requires re-binding.
-			draw_graph.add_draw_list_bind_uniform_set(dl->state.pipeline_shader_driver_id, dl->state.sets[i].uniform_set_driver_id, i);
-
-			UniformSet *uniform_set = uniform_set_owner.get_or_null(dl->state.sets[i].uniform_set);
-			draw_graph.add_draw_list_usages(uniform_set->draw_trackers, uniform_set->draw_trackers_usage);
-
-			dl->state.sets[i].bound = true;
-		}
+	if (!_draw_list_bind_uniform_sets(dl)) {
+		return;
 	}
 
 	if (p_use_indices) {
@@ -3870,6 +3901,78 @@ void RenderingDevice::draw_list_draw(DrawListID p_list, bool p_use_indices, uint
 	}
 }
 
+void RenderingDevice::draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	DrawList *dl = _get_draw_list_ptr(p_list);
+	ERR_FAIL_NULL(dl);
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.active, "Submitted Draw Lists can no longer be modified.");
+#endif
+
+	Buffer *buffer = storage_buffer_owner.get_or_null(p_buffer);
+	ERR_FAIL_NULL(buffer);
+
+	ERR_FAIL_COND_MSG(!buffer->usage.has_flag(RDD::BUFFER_USAGE_INDIRECT_BIT), "Buffer provided was not created to do indirect draws.");
+	ERR_FAIL_COND_MSG(p_draw_count == 0, "Draw count must be greater than zero.");
+	// Without multi-draw support, the commands are drawn one by one below, so the limit doesn't apply.
+	ERR_FAIL_COND_MSG(p_draw_count > 1 && driver->has_feature(SUPPORTS_MULTI_DRAW_INDIRECT) && p_draw_count > driver->limit_get(LIMIT_MAX_DRAW_INDIRECT_COUNT),
+			"Draw count (" + itos(p_draw_count) + ") is larger than device limit (" + itos(driver->limit_get(LIMIT_MAX_DRAW_INDIRECT_COUNT)) + ").");
+
+	// Each command is VkDrawIndexedIndirectCommand (20 bytes) or VkDrawIndirectCommand (16 bytes).
+	const uint32_t command_size = p_use_indices ? 20 : 16;
+	if (p_stride == 0) {
+		p_stride = command_size;
+	}
+	ERR_FAIL_COND_MSG(p_stride < command_size || (p_stride % 4) != 0, "Stride (" + itos(p_stride) + ") must be a multiple of 4 and at least the size of one draw command (" + itos(command_size) + ").");
+	ERR_FAIL_COND_MSG((p_offset % 4) != 0, "Offset (" + itos(p_offset) + ") must be a multiple of 4.");
+	ERR_FAIL_COND_MSG(uint64_t(p_offset) + uint64_t(p_stride) * (p_draw_count - 1) + command_size > buffer->size, "Draw commands requested go past the end of the buffer.");
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.pipeline_active,
+			"No render pipeline was set before attempting to draw.");
+	if (dl->validation.pipeline_vertex_format != INVALID_ID) {
+		// Pipeline uses vertices, validate format.
+		ERR_FAIL_COND_MSG(dl->validation.vertex_format == INVALID_ID,
+				"No vertex array was bound, and render pipeline expects vertices.");
+		// Make sure format is right.
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_vertex_format != dl->validation.vertex_format,
+				"The vertex format used to create the pipeline does not match the vertex format bound.");
+	}
+
+	if (dl->validation.pipeline_push_constant_size > 0) {
+		// Using push constants, check that they were supplied.
+		ERR_FAIL_COND_MSG(!dl->validation.pipeline_push_constant_supplied,
+				"The shader in this pipeline requires a push constant to be set before drawing, but it's not present.");
+	}
+
+	if (p_use_indices) {
+		ERR_FAIL_COND_MSG(!dl->validation.index_array_count,
+				"Draw command requested indices, but no index buffer was set.");
+
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_uses_restart_indices != dl->validation.index_buffer_uses_restart_indices,
+				"The usage of restart indices in index buffer does not match the render primitive in the pipeline.");
+	}
+#endif
+
+	// Bind descriptor sets.
+	if (!_draw_list_bind_uniform_sets(dl)) {
+		return;
+	}
+
+	// Vertex and index counts live in the buffer, so they can only be validated by the GPU.
+	if (p_draw_count == 1 || driver->has_feature(SUPPORTS_MULTI_DRAW_INDIRECT)) {
+		draw_graph.add_draw_list_draw_indirect(buffer->driver_id, p_offset, p_draw_count, p_stride, p_use_indices);
+	} else {
+		// Emulate multi-draw by issuing one indirect draw per command.
+		for (uint32_t i = 0; i < p_draw_count; i++) {
+			draw_graph.add_draw_list_draw_indirect(buffer->driver_id, p_offset + i * p_stride, 1, p_stride, p_use_indices);
+		}
+	}
+
+	if (buffer->draw_tracker != nullptr) {
+		draw_graph.add_draw_list_usage(buffer->draw_tracker, RDG::RESOURCE_USAGE_INDIRECT_BUFFER_READ);
+	}
+}
+
 void RenderingDevice::draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect) {
 	DrawList *dl = _get_draw_list_ptr(p_list);
 
@@ -4839,6 +4942,38 @@ uint64_t RenderingDevice::get_memory_usage(MemoryType p_type) const {
 	}
 }
 
+uint64_t RenderingDevice::get_render_graph_info(RenderGraphInfo p_info) {
+	draw_graph.request_statistics();
+	const RDG::Statistics &statistics = draw_graph.get_statistics();
+	switch (p_info) {
+		case RENDER_GRAPH_INFO_BUILD_TIME: {
+			return statistics.build_usec;
+		}
+		case RENDER_GRAPH_INFO_REORDER_TIME: {
+			return statistics.reorder_usec;
+		}
+		case RENDER_GRAPH_INFO_RECORD_TIME: {
+			return statistics.record_usec;
+		}
+		case RENDER_GRAPH_INFO_COMMAND_COUNT: {
+			return statistics.command_count;
+		}
+		case RENDER_GRAPH_INFO_LEVEL_COUNT: {
+			return statistics.level_count;
+		}
+		case RENDER_GRAPH_INFO_SECONDARY_COMMAND_BUFFER_COUNT: {
+			return statistics.secondary_command_buffer_count;
+		}
+		case RENDER_GRAPH_INFO_COMMAND_DATA_SIZE: {
+			return statistics.command_data_size;
+		}
+		default: {
+			DEV_ASSERT(false);
+			return 0;
+		}
+	}
+}
+
 void RenderingDevice::_begin_frame() {
 	// Before beginning this frame, wait on the fence if it was signaled to make sure its work is finished.
 	if (frames[frame].draw_fence_signaled) {
@@ -5058,7 +5193,12 @@ Error RenderingDevice::initialize(RenderingContextDriver *p_context, DisplayServ
 	driver->command_buffer_begin(frames[0].draw_command_buffer);
 
 	// Create draw graph and start it initialized as well.
-	draw_graph.initialize(driver, frames.size(), main_queue_family, SECONDARY_COMMAND_BUFFERS_PER_FRAME);
+	// The command graph can automatically issue secondary command buffers and record them on background threads when they reach an arbitrary
+	// size threshold, splitting large draw lists across several of them. This can be very beneficial towards reducing the time the main thread
+	// takes to record all the rendering commands. However, this setting is not enabled by default as it's been shown to cause some strange
+	// issues with certain IHVs that have yet to be understood.
+	uint32_t secondary_command_buffers_per_frame = GLOBAL_GET("rendering/rendering_device/command_recording/secondary_command_buffers_per_frame");
+	draw_graph.initialize(driver, frames.size(), main_queue_family, secondary_command_buffers_per_frame);
 	draw_graph.begin();
 
 	for (uint32_t i = 0; i < frames.size(); i++) {
@@ -5541,6 +5681,7 @@ void RenderingDevice::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("draw_list_set_push_constant", "draw_list", "buffer", "size_bytes"), &RenderingDevice::_draw_list_set_push_constant);
 
 	ClassDB::bind_method(D_METHOD("draw_list_draw", "draw_list", "use_indices", "instances", "procedural_vertex_count"), &RenderingDevice::draw_list_draw, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("draw_list_draw_indirect", "draw_list", "use_indices", "buffer", "offset", "draw_count", "stride"), &RenderingDevice::draw_list_draw_indirect, DEFVAL(0), DEFVAL(1), DEFVAL(0));
 
 	ClassDB::bind_method(D_METHOD("draw_list_enable_scissor", "draw_list", "rect"), &RenderingDevice::draw_list_enable_scissor, DEFVAL(Rect2()));
 	ClassDB::bind_method(D_METHOD("draw_list_disable_scissor", "draw_list"), &RenderingDevice::draw_list_disable_scissor);
@@ -5594,6 +5735,7 @@ void RenderingDevice::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_device_pipeline_cache_uuid"), &RenderingDevice::get_device_pipeline_cache_uuid);
 
 	ClassDB::bind_method(D_METHOD("get_memory_usage", "type"), &RenderingDevice::get_memory_usage);
+	ClassDB::bind_method(D_METHOD("get_render_graph_info", "info"), &RenderingDevice::get_render_graph_info);
 
 	ClassDB::bind_method(D_METHOD("get_driver_resource", "resource", "rid", "index"), &RenderingDevice::get_driver_resource);
 
@@ -6117,6 +6259,14 @@ void RenderingDevice::_bind_methods() {
 	BIND_ENUM_CONSTANT(MEMORY_BUFFERS);
 	BIND_ENUM_CONSTANT(MEMORY_TOTAL);
 
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_BUILD_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_REORDER_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_RECORD_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_COMMAND_COUNT);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_LEVEL_COUNT);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_SECONDARY_COMMAND_BUFFER_COUNT);
+	BIND_ENUM_CONSTANT(RENDER_GRAPH_INFO_COMMAND_DATA_SIZE);
+
 	BIND_CONSTANT(INVALID_ID);
 	BIND_CONSTANT(INVALID_FORMAT_ID);
 }
@@ -539,6 +539,7 @@ public:
 	FramebufferFormatID framebuffer_format_create_multipass(const Vector<AttachmentFormat> &p_attachments, const Vector<FramebufferPass> &p_passes, uint32_t p_view_count = 1);
 	FramebufferFormatID framebuffer_format_create_empty(TextureSamples p_samples = TEXTURE_SAMPLES_1);
 	TextureSamples framebuffer_format_get_texture_samples(FramebufferFormatID p_format, uint32_t p_pass = 0);
+	bool framebuffer_format_get_description(FramebufferFormatID p_format, Vector<AttachmentFormat> &r_attachments, Vector<FramebufferPass> &r_passes, uint32_t &r_view_count);
 
 	RID framebuffer_create(const Vector<RID> &p_texture_attachments, FramebufferFormatID p_format_check = INVALID_ID, uint32_t p_view_count = 1);
 	RID framebuffer_create_multipass(const Vector<RID> &p_texture_attachments, const Vector<FramebufferPass> &p_passes, FramebufferFormatID p_format_check = INVALID_ID, uint32_t p_view_count = 1);
@@ -685,6 +686,7 @@ public:
 
 	// This ID is warranted to be unique for the same formats, does not need to be freed
 	VertexFormatID vertex_format_create(const Vector<VertexAttribute> &p_vertex_descriptions);
+	Vector<VertexAttribute> vertex_format_get_attributes(VertexFormatID p_vertex_format);
 	RID vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets = Vector<uint64_t>());
 
 	RID index_buffer_create(uint32_t p_size_indices, IndexBufferFormat p_format, const Vector<uint8_t> &p_data = Vector<uint8_t>(), bool p_use_restart_indices = false);
@@ -749,6 +751,7 @@ private:
 		String name; // Used for debug.
 		RDD::ShaderID driver_id;
 		uint32_t layout_hash = 0;
+		uint64_t binary_hash = 0; // Identifies the shader across runs, as long as the driver doesn't change.
 		BitField<RDD::PipelineStageBits> stage_bits;
 		Vector<uint32_t> set_formats;
 	};
@@ -817,6 +820,7 @@ public:
 	RID shader_create_placeholder();
 
 	uint64_t shader_get_vertex_input_attribute_mask(RID p_shader);
+	uint64_t shader_get_binary_hash(RID p_shader);
 
 	/******************/
 	/**** UNIFORMS ****/
@@ -1101,6 +1105,7 @@ private:
 	_FORCE_INLINE_ DrawList *_get_draw_list_ptr(DrawListID p_id);
 	Error _draw_list_allocate(const Rect2i &p_viewport, uint32_t p_subpass);
 	void _draw_list_free(Rect2i *r_last_viewport = nullptr);
+	bool _draw_list_bind_uniform_sets(DrawList *p_draw_list);
 
 public:
 	DrawListID draw_list_begin_for_screen(DisplayServer::WindowID p_screen = 0, const Color &p_clear_color = Color());
@@ -1115,6 +1120,7 @@ public:
 	void draw_list_set_push_constant(DrawListID p_list, const void *p_data, uint32_t p_data_size);
 
 	void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0);
+	void draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset = 0, uint32_t p_draw_count = 1, uint32_t p_stride = 0);
 
 	void draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect);
 	void draw_list_disable_scissor(DrawListID p_list);
@@ -1341,6 +1347,18 @@ public:
 
 	uint64_t get_memory_usage(MemoryType p_type) const;
 
+	enum RenderGraphInfo {
+		RENDER_GRAPH_INFO_BUILD_TIME,
+		RENDER_GRAPH_INFO_REORDER_TIME,
+		RENDER_GRAPH_INFO_RECORD_TIME,
+		RENDER_GRAPH_INFO_COMMAND_COUNT,
+		RENDER_GRAPH_INFO_LEVEL_COUNT,
+		RENDER_GRAPH_INFO_SECONDARY_COMMAND_BUFFER_COUNT,
+		RENDER_GRAPH_INFO_COMMAND_DATA_SIZE,
+	};
+
+	uint64_t get_render_graph_info(RenderGraphInfo p_info);
+
 	RenderingDevice *create_local_device();
 
 	void set_resource_name(RID p_id, const String &p_name);
@@ -1428,6 +1446,7 @@ VARIANT_ENUM_CAST(RenderingDevice::InitialAction)
 VARIANT_ENUM_CAST(RenderingDevice::FinalAction)
 VARIANT_ENUM_CAST(RenderingDevice::Limit)
 VARIANT_ENUM_CAST(RenderingDevice::MemoryType)
+VARIANT_ENUM_CAST(RenderingDevice::RenderGraphInfo)
 VARIANT_ENUM_CAST(RenderingDevice::Features)
 
 #ifndef DISABLE_DEPRECATED
@@ -810,6 +810,7 @@ public:
 		LIMIT_SUBGROUP_OPERATIONS,
 		LIMIT_VRS_TEXEL_WIDTH,
 		LIMIT_VRS_TEXEL_HEIGHT,
+		LIMIT_MAX_DRAW_INDIRECT_COUNT,
 	};
 
 	enum Features {
@@ -818,6 +819,8 @@ public:
 		SUPPORTS_ATTACHMENT_VRS,
 		// If not supported, a fragment shader with only side effets (i.e., writes  to buffers, but doesn't output to attachments), may be optimized down to no-op by the GPU driver.
 		SUPPORTS_FRAGMENT_SHADER_WITH_ONLY_SIDE_EFFECTS,
+		// If not supported, indirect draws can only source one draw command per call.
+		SUPPORTS_MULTI_DRAW_INDIRECT,
 	};
 
 	enum SubgroupOperations {
@@ -30,6 +30,8 @@
 
 #include "rendering_device_graph.h"
 
+#include "core/os/os.h"
+
 #define PRINT_RENDER_GRAPH 0
 #define FORCE_FULL_ACCESS_BITS 0
 #define PRINT_RESOURCE_TRACKER_TOTAL 0
@@ -210,6 +212,8 @@ RenderingDeviceGraph::ComputeListInstruction *RenderingDeviceGraph::_allocate_co
 }
 
 void RenderingDeviceGraph::_add_command_to_graph(ResourceTracker **p_resource_trackers, ResourceUsage *p_resource_usages, uint32_t p_resource_count, int32_t p_command_index, RecordedCommand *r_command) {
+	const uint64_t build_begin_usec = statistics_requested.is_set() ? OS::get_singleton()->get_ticks_usec() : 0;
+
 	// Assign the next stages derived from the stages the command requires first.
 	r_command->next_stages = r_command->self_stages;
 
@@ -559,6 +563,10 @@ void RenderingDeviceGraph::_add_command_to_graph(ResourceTracker **p_resource_tr
 			search_tracker->read_full_command_list_index = _add_to_command_list(p_command_index, search_tracker->read_full_command_list_index);
 		}
 	}
+
+	if (statistics_requested.is_set()) {
+		build_usec += OS::get_singleton()->get_ticks_usec() - build_begin_usec;
+	}
 }
 
 void RenderingDeviceGraph::_add_texture_barrier_to_command(RDD::TextureID p_texture_id, BitField<RDD::BarrierAccessBits> p_src_access, BitField<RDD::BarrierAccessBits> p_dst_access, ResourceUsage p_prev_usage, ResourceUsage p_next_usage, RDD::TextureSubresourceRange p_subresources, LocalVector<RDD::TextureBarrier> &r_barrier_vector, int32_t &r_barrier_index, int32_t &r_barrier_count) {
@@ -658,91 +666,285 @@ void RenderingDeviceGraph::_run_draw_list_command(RDD::CommandBufferID p_command
 			case DrawListInstruction::TYPE_BIND_INDEX_BUFFER: {
 				const DrawListBindIndexBufferInstruction *bind_index_buffer_instruction = reinterpret_cast<const DrawListBindIndexBufferInstruction *>(instruction);
 				driver->command_render_bind_index_buffer(p_command_buffer, bind_index_buffer_instruction->buffer, bind_index_buffer_instruction->format, bind_index_buffer_instruction->offset);
-				instruction_data_cursor += sizeof(DrawListBindIndexBufferInstruction);
 			} break;
 			case DrawListInstruction::TYPE_BIND_PIPELINE: {
 				const DrawListBindPipelineInstruction *bind_pipeline_instruction = reinterpret_cast<const DrawListBindPipelineInstruction *>(instruction);
 				driver->command_bind_render_pipeline(p_command_buffer, bind_pipeline_instruction->pipeline);
-				instruction_data_cursor += sizeof(DrawListBindPipelineInstruction);
 			} break;
 			case DrawListInstruction::TYPE_BIND_UNIFORM_SET: {
 				const DrawListBindUniformSetInstruction *bind_uniform_set_instruction = reinterpret_cast<const DrawListBindUniformSetInstruction *>(instruction);
 				driver->command_bind_render_uniform_set(p_command_buffer, bind_uniform_set_instruction->uniform_set, bind_uniform_set_instruction->shader, bind_uniform_set_instruction->set_index);
-				instruction_data_cursor += sizeof(DrawListBindUniformSetInstruction);
 			} break;
 			case DrawListInstruction::TYPE_BIND_VERTEX_BUFFERS: {
 				const DrawListBindVertexBuffersInstruction *bind_vertex_buffers_instruction = reinterpret_cast<const DrawListBindVertexBuffersInstruction *>(instruction);
 				driver->command_render_bind_vertex_buffers(p_command_buffer, bind_vertex_buffers_instruction->vertex_buffers_count, bind_vertex_buffers_instruction->vertex_buffers(), bind_vertex_buffers_instruction->vertex_buffer_offsets());
-				instruction_data_cursor += sizeof(DrawListBindVertexBuffersInstruction);
-				instruction_data_cursor += sizeof(RDD::BufferID) * bind_vertex_buffers_instruction->vertex_buffers_count;
-				instruction_data_cursor += sizeof(uint64_t) * bind_vertex_buffers_instruction->vertex_buffers_count;
 			} break;
 			case DrawListInstruction::TYPE_CLEAR_ATTACHMENTS: {
 				const DrawListClearAttachmentsInstruction *clear_attachments_instruction = reinterpret_cast<const DrawListClearAttachmentsInstruction *>(instruction);
 				const VectorView attachments_clear_view(clear_attachments_instruction->attachments_clear(), clear_attachments_instruction->attachments_clear_count);
 				const VectorView attachments_clear_rect_view(clear_attachments_instruction->attachments_clear_rect(), clear_attachments_instruction->attachments_clear_rect_count);
 				driver->command_render_clear_attachments(p_command_buffer, attachments_clear_view, attachments_clear_rect_view);
-				instruction_data_cursor += sizeof(DrawListClearAttachmentsInstruction);
-				instruction_data_cursor += sizeof(RDD::AttachmentClear) * clear_attachments_instruction->attachments_clear_count;
-				instruction_data_cursor += sizeof(Rect2i) * clear_attachments_instruction->attachments_clear_rect_count;
 			} break;
 			case DrawListInstruction::TYPE_DRAW: {
 				const DrawListDrawInstruction *draw_instruction = reinterpret_cast<const DrawListDrawInstruction *>(instruction);
 				driver->command_render_draw(p_command_buffer, draw_instruction->vertex_count, draw_instruction->instance_count, 0, 0);
-				instruction_data_cursor += sizeof(DrawListDrawInstruction);
 			} break;
 			case DrawListInstruction::TYPE_DRAW_INDEXED: {
 				const DrawListDrawIndexedInstruction *draw_indexed_instruction = reinterpret_cast<const DrawListDrawIndexedInstruction *>(instruction);
 				driver->command_render_draw_indexed(p_command_buffer, draw_indexed_instruction->index_count, draw_indexed_instruction->instance_count, draw_indexed_instruction->first_index, 0, 0);
-				instruction_data_cursor += sizeof(DrawListDrawIndexedInstruction);
+			} break;
+			case DrawListInstruction::TYPE_DRAW_INDIRECT: {
+				const DrawListDrawIndirectInstruction *draw_indirect_instruction = reinterpret_cast<const DrawListDrawIndirectInstruction *>(instruction);
+				driver->command_render_draw_indirect(p_command_buffer, draw_indirect_instruction->buffer, draw_indirect_instruction->offset, draw_indirect_instruction->draw_count, draw_indirect_instruction->stride);
+			} break;
+			case DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT: {
+				const DrawListDrawIndirectInstruction *draw_indirect_instruction = reinterpret_cast<const DrawListDrawIndirectInstruction *>(instruction);
+				driver->command_render_draw_indexed_indirect(p_command_buffer, draw_indirect_instruction->buffer, draw_indirect_instruction->offset, draw_indirect_instruction->draw_count, draw_indirect_instruction->stride);
 			} break;
 			case DrawListInstruction::TYPE_EXECUTE_COMMANDS: {
 				const DrawListExecuteCommandsInstruction *execute_commands_instruction = reinterpret_cast<const DrawListExecuteCommandsInstruction *>(instruction);
 				driver->command_buffer_execute_secondary(p_command_buffer, execute_commands_instruction->command_buffer);
-				instruction_data_cursor += sizeof(DrawListExecuteCommandsInstruction);
 			} break;
 			case DrawListInstruction::TYPE_NEXT_SUBPASS: {
 				const DrawListNextSubpassInstruction *next_subpass_instruction = reinterpret_cast<const DrawListNextSubpassInstruction *>(instruction);
 				driver->command_next_render_subpass(p_command_buffer, next_subpass_instruction->command_buffer_type);
-				instruction_data_cursor += sizeof(DrawListNextSubpassInstruction);
 			} break;
 			case DrawListInstruction::TYPE_SET_BLEND_CONSTANTS: {
 				const DrawListSetBlendConstantsInstruction *set_blend_constants_instruction = reinterpret_cast<const DrawListSetBlendConstantsInstruction *>(instruction);
 				driver->command_render_set_blend_constants(p_command_buffer, set_blend_constants_instruction->color);
-				instruction_data_cursor += sizeof(DrawListSetBlendConstantsInstruction);
 			} break;
 			case DrawListInstruction::TYPE_SET_LINE_WIDTH: {
 				const DrawListSetLineWidthInstruction *set_line_width_instruction = reinterpret_cast<const DrawListSetLineWidthInstruction *>(instruction);
 				driver->command_render_set_line_width(p_command_buffer, set_line_width_instruction->width);
-				instruction_data_cursor += sizeof(DrawListSetLineWidthInstruction);
 			} break;
 			case DrawListInstruction::TYPE_SET_PUSH_CONSTANT: {
 				const DrawListSetPushConstantInstruction *set_push_constant_instruction = reinterpret_cast<const DrawListSetPushConstantInstruction *>(instruction);
 				const VectorView push_constant_data_view(reinterpret_cast<const uint32_t *>(set_push_constant_instruction->data()), set_push_constant_instruction->size / sizeof(uint32_t));
 				driver->command_bind_push_constants(p_command_buffer, set_push_constant_instruction->shader, 0, push_constant_data_view);
-				instruction_data_cursor += sizeof(DrawListSetPushConstantInstruction);
-				instruction_data_cursor += set_push_constant_instruction->size;
 			} break;
 			case DrawListInstruction::TYPE_SET_SCISSOR: {
 				const DrawListSetScissorInstruction *set_scissor_instruction = reinterpret_cast<const DrawListSetScissorInstruction *>(instruction);
 				driver->command_render_set_scissor(p_command_buffer, set_scissor_instruction->rect);
-				instruction_data_cursor += sizeof(DrawListSetScissorInstruction);
 			} break;
 			case DrawListInstruction::TYPE_SET_VIEWPORT: {
 				const DrawListSetViewportInstruction *set_viewport_instruction = reinterpret_cast<const DrawListSetViewportInstruction *>(instruction);
 				driver->command_render_set_viewport(p_command_buffer, set_viewport_instruction->rect);
-				instruction_data_cursor += sizeof(DrawListSetViewportInstruction);
 			} break;
 			case DrawListInstruction::TYPE_UNIFORM_SET_PREPARE_FOR_USE: {
 				const DrawListUniformSetPrepareForUseInstruction *uniform_set_prepare_for_use_instruction = reinterpret_cast<const DrawListUniformSetPrepareForUseInstruction *>(instruction);
 				driver->command_uniform_set_prepare_for_use(p_command_buffer, uniform_set_prepare_for_use_instruction->uniform_set, uniform_set_prepare_for_use_instruction->shader, uniform_set_prepare_for_use_instruction->set_index);
-				instruction_data_cursor += sizeof(DrawListUniformSetPrepareForUseInstruction);
 			} break;
 			default:
 				DEV_ASSERT(false && "Unknown draw list instruction type.");
 				return;
 		}
+
+		instruction_data_cursor += _get_draw_list_instruction_size(instruction);
+	}
+}
+
+uint32_t RenderingDeviceGraph::_get_draw_list_instruction_size(const DrawListInstruction *p_instruction) {
+	switch (p_instruction->type) {
+		case DrawListInstruction::TYPE_BIND_INDEX_BUFFER:
+			return sizeof(DrawListBindIndexBufferInstruction);
+		case DrawListInstruction::TYPE_BIND_PIPELINE:
+			return sizeof(DrawListBindPipelineInstruction);
+		case DrawListInstruction::TYPE_BIND_UNIFORM_SET:
+			return sizeof(DrawListBindUniformSetInstruction);
+		case DrawListInstruction::TYPE_BIND_VERTEX_BUFFERS: {
+			const DrawListBindVertexBuffersInstruction *bind_vertex_buffers_instruction = reinterpret_cast<const DrawListBindVertexBuffersInstruction *>(p_instruction);
+			return sizeof(DrawListBindVertexBuffersInstruction) + (sizeof(RDD::BufferID) + sizeof(uint64_t)) * bind_vertex_buffers_instruction->vertex_buffers_count;
+		}
+		case DrawListInstruction::TYPE_CLEAR_ATTACHMENTS: {
+			const DrawListClearAttachmentsInstruction *clear_attachments_instruction = reinterpret_cast<const DrawListClearAttachmentsInstruction *>(p_instruction);
+			return sizeof(DrawListClearAttachmentsInstruction) + sizeof(RDD::AttachmentClear) * clear_attachments_instruction->attachments_clear_count + sizeof(Rect2i) * clear_attachments_instruction->attachments_clear_rect_count;
+		}
+		case DrawListInstruction::TYPE_DRAW:
+			return sizeof(DrawListDrawInstruction);
+		case DrawListInstruction::TYPE_DRAW_INDEXED:
+			return sizeof(DrawListDrawIndexedInstruction);
+		case DrawListInstruction::TYPE_DRAW_INDIRECT:
+		case DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT:
+			return sizeof(DrawListDrawIndirectInstruction);
+		case DrawListInstruction::TYPE_EXECUTE_COMMANDS:
+			return sizeof(DrawListExecuteCommandsInstruction);
+		case DrawListInstruction::TYPE_NEXT_SUBPASS:
+			return sizeof(DrawListNextSubpassInstruction);
+		case DrawListInstruction::TYPE_SET_BLEND_CONSTANTS:
+			return sizeof(DrawListSetBlendConstantsInstruction);
+		case DrawListInstruction::TYPE_SET_LINE_WIDTH:
+			return sizeof(DrawListSetLineWidthInstruction);
+		case DrawListInstruction::TYPE_SET_PUSH_CONSTANT: {
+			const DrawListSetPushConstantInstruction *set_push_constant_instruction = reinterpret_cast<const DrawListSetPushConstantInstruction *>(p_instruction);
+			return sizeof(DrawListSetPushConstantInstruction) + set_push_constant_instruction->size;
+		}
+		case DrawListInstruction::TYPE_SET_SCISSOR:
+			return sizeof(DrawListSetScissorInstruction);
+		case DrawListInstruction::TYPE_SET_VIEWPORT:
+			return sizeof(DrawListSetViewportInstruction);
+		case DrawListInstruction::TYPE_UNIFORM_SET_PREPARE_FOR_USE:
+			return sizeof(DrawListUniformSetPrepareForUseInstruction);
+		default:
+			DEV_ASSERT(false && "Unknown draw list instruction type.");
+			return 0;
+	}
+}
+
+uint32_t RenderingDeviceGraph::split_draw_list_instructions(const uint8_t *p_instruction_data, uint32_t p_instruction_data_size, uint32_t p_chunk_size, LocalVector<uint8_t> *const *r_chunks, uint32_t p_max_chunks) {
+	// Secondary command buffers don't inherit any state from each other, so the last instruction that set each piece of state is
+	// remembered and replayed at the start of every chunk. The slots after the fixed ones are used for the uniform set indices.
+	enum StateSlot {
+		STATE_SLOT_VIEWPORT,
+		STATE_SLOT_SCISSOR,
+		STATE_SLOT_BLEND_CONSTANTS,
+		STATE_SLOT_LINE_WIDTH,
+		STATE_SLOT_PIPELINE,
+		STATE_SLOT_VERTEX_BUFFERS,
+		STATE_SLOT_INDEX_BUFFER,
+		STATE_SLOT_PUSH_CONSTANT,
+		STATE_SLOT_UNIFORM_SET_0,
+	};
+
+	ERR_FAIL_COND_V(p_max_chunks == 0 || p_chunk_size == 0, 0);
+
+	// Subpass changes can't be recorded in a secondary command buffer that was started for a different subpass, so the draw list can only be split if it has none.
+	bool can_split = true;
+	uint32_t instruction_data_cursor = 0;
+	while (instruction_data_cursor < p_instruction_data_size) {
+		const DrawListInstruction *instruction = reinterpret_cast<const DrawListInstruction *>(&p_instruction_data[instruction_data_cursor]);
+		if (instruction->type == DrawListInstruction::TYPE_NEXT_SUBPASS || instruction->type == DrawListInstruction::TYPE_EXECUTE_COMMANDS) {
+			can_split = false;
+			break;
+		}
+
+		instruction_data_cursor += _get_draw_list_instruction_size(instruction);
+	}
+
+	const uint32_t chunk_count = can_split ? CLAMP((p_instruction_data_size + p_chunk_size - 1) / p_chunk_size, 1U, p_max_chunks) : 1U;
+	const uint32_t chunk_target_size = p_instruction_data_size / chunk_count;
+
+	thread_local LocalVector<int32_t> state_offsets;
+	state_offsets.clear();
+
+	uint32_t chunk_start = 0;
+	uint32_t chunks_used = 1;
+	LocalVector<uint8_t> *chunk = r_chunks[0];
+	chunk->clear();
+
+	instruction_data_cursor = 0;
+	while (instruction_data_cursor < p_instruction_data_size) {
+		const DrawListInstruction *instruction = reinterpret_cast<const DrawListInstruction *>(&p_instruction_data[instruction_data_cursor]);
+		const uint32_t instruction_size = _get_draw_list_instruction_size(instruction);
+		ERR_FAIL_COND_V(instruction_size == 0, 0);
+
+		int32_t state_slot = -1;
+		bool is_draw = false;
+		switch (instruction->type) {
+			case DrawListInstruction::TYPE_SET_VIEWPORT:
+				state_slot = STATE_SLOT_VIEWPORT;
+				break;
+			case DrawListInstruction::TYPE_SET_SCISSOR:
+				state_slot = STATE_SLOT_SCISSOR;
+				break;
+			case DrawListInstruction::TYPE_SET_BLEND_CONSTANTS:
+				state_slot = STATE_SLOT_BLEND_CONSTANTS;
+				break;
+			case DrawListInstruction::TYPE_SET_LINE_WIDTH:
+				state_slot = STATE_SLOT_LINE_WIDTH;
+				break;
+			case DrawListInstruction::TYPE_BIND_PIPELINE:
+				state_slot = STATE_SLOT_PIPELINE;
+				break;
+			case DrawListInstruction::TYPE_BIND_VERTEX_BUFFERS:
+				state_slot = STATE_SLOT_VERTEX_BUFFERS;
+				break;
+			case DrawListInstruction::TYPE_BIND_INDEX_BUFFER:
+				state_slot = STATE_SLOT_INDEX_BUFFER;
+				break;
+			case DrawListInstruction::TYPE_SET_PUSH_CONSTANT:
+				state_slot = STATE_SLOT_PUSH_CONSTANT;
+				break;
+			case DrawListInstruction::TYPE_BIND_UNIFORM_SET:
+				state_slot = STATE_SLOT_UNIFORM_SET_0 + reinterpret_cast<const DrawListBindUniformSetInstruction *>(instruction)->set_index;
+				break;
+			case DrawListInstruction::TYPE_DRAW:
+			case DrawListInstruction::TYPE_DRAW_INDEXED:
+			case DrawListInstruction::TYPE_DRAW_INDIRECT:
+			case DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT:
+				is_draw = true;
+				break;
+			default:
+				break;
+		}
+
+		if (state_slot >= 0) {
+			if (uint32_t(state_slot) >= state_offsets.size()) {
+				uint32_t previous_size = state_offsets.size();
+				state_offsets.resize(state_slot + 1);
+				for (uint32_t i = previous_size; i < state_offsets.size(); i++) {
+					state_offsets[i] = -1;
+				}
+			}
+
+			state_offsets[state_slot] = instruction_data_cursor;
+		}
+
+		instruction_data_cursor += instruction_size;
+
+		// Only split right after a draw so no chunk starts with state changes that would be replayed twice.
+		if (is_draw && chunks_used < chunk_count && (instruction_data_cursor - chunk_start) >= chunk_target_size && instruction_data_cursor < p_instruction_data_size) {
+			uint32_t previous_size = chunk->size();
+			chunk->resize(previous_size + instruction_data_cursor - chunk_start);
+			memcpy(&(*chunk)[previous_size], &p_instruction_data[chunk_start], instruction_data_cursor - chunk_start);
+			chunk_start = instruction_data_cursor;
+
+			// Start the next chunk by restoring the state.
+			chunk = r_chunks[chunks_used++];
+			chunk->clear();
+			for (uint32_t i = 0; i < state_offsets.size(); i++) {
+				if (state_offsets[i] < 0) {
+					continue;
+				}
+
+				const DrawListInstruction *state_instruction = reinterpret_cast<const DrawListInstruction *>(&p_instruction_data[state_offsets[i]]);
+				const uint32_t state_instruction_size = _get_draw_list_instruction_size(state_instruction);
+				previous_size = chunk->size();
+				chunk->resize(previous_size + state_instruction_size);
+				memcpy(&(*chunk)[previous_size], state_instruction, state_instruction_size);
+			}
+		}
 	}
+
+	uint32_t previous_size = chunk->size();
+	chunk->resize(previous_size + p_instruction_data_size - chunk_start);
+	memcpy(&(*chunk)[previous_size], &p_instruction_data[chunk_start], p_instruction_data_size - chunk_start);
+	return chunks_used;
+}
+
+void RenderingDeviceGraph::_record_draw_list_in_secondary_command_buffers(uint32_t p_chunk_size) {
+	Frame &f = frames[frame];
+	const uint32_t first_secondary = f.secondary_command_buffers_used;
+	const uint32_t secondary_buffers_available = f.secondary_command_buffers.size() - first_secondary;
+
+	thread_local LocalVector<LocalVector<uint8_t> *> chunks;
+	chunks.resize(secondary_buffers_available);
+	for (uint32_t i = 0; i < secondary_buffers_available; i++) {
+		chunks[i] = &f.secondary_command_buffers[first_secondary + i].instruction_data;
+	}
+
+	const uint32_t chunk_count = split_draw_list_instructions(draw_instruction_list.data.ptr(), draw_instruction_list.data.size(), p_chunk_size, chunks.ptr(), secondary_buffers_available);
+	ERR_FAIL_COND(chunk_count == 0);
+
+	// Replace the instruction list with the execution of every secondary command buffer in order.
+	draw_instruction_list.data.clear();
+	for (uint32_t i = first_secondary; i < first_secondary + chunk_count; i++) {
+		SecondaryCommandBuffer *secondary = &f.secondary_command_buffers[i];
+		secondary->render_pass = draw_instruction_list.render_pass;
+		secondary->framebuffer = draw_instruction_list.framebuffer;
+		secondary->task = WorkerThreadPool::get_singleton()->add_template_task(this, &RenderingDeviceGraph::_run_secondary_command_buffer_task, secondary, true);
+		add_draw_list_execute_commands(secondary->command_buffer);
+	}
+	f.secondary_command_buffers_used += chunk_count;
 }
 
 void RenderingDeviceGraph::_run_secondary_command_buffer_task(const SecondaryCommandBuffer *p_secondary) {
@@ -1146,6 +1348,12 @@ void RenderingDeviceGraph::_print_draw_list(const uint8_t *p_instruction_data, u
 				print_line("\tDRAW INDICES", draw_indexed_instruction->index_count, "INSTANCES", draw_indexed_instruction->instance_count, "FIRST INDEX", draw_indexed_instruction->first_index);
 				instruction_data_cursor += sizeof(DrawListDrawIndexedInstruction);
 			} break;
+			case DrawListInstruction::TYPE_DRAW_INDIRECT:
+			case DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT: {
+				const DrawListDrawIndirectInstruction *draw_indirect_instruction = reinterpret_cast<const DrawListDrawIndirectInstruction *>(instruction);
+				print_line(instruction->type == DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT ? "\tDRAW INDEXED INDIRECT BUFFER ID" : "\tDRAW INDIRECT BUFFER ID", itos(draw_indirect_instruction->buffer.id), "OFFSET", draw_indirect_instruction->offset, "DRAW COUNT", draw_indirect_instruction->draw_count, "STRIDE", draw_indirect_instruction->stride);
+				instruction_data_cursor += sizeof(DrawListDrawIndirectInstruction);
+			} break;
 			case DrawListInstruction::TYPE_EXECUTE_COMMANDS: {
 				print_line("\tEXECUTE COMMANDS");
 				instruction_data_cursor += sizeof(DrawListExecuteCommandsInstruction);
@@ -1288,6 +1496,7 @@ void RenderingDeviceGraph::begin() {
 	command_synchronization_pending = false;
 	command_label_index = -1;
 	frames[frame].secondary_command_buffers_used = 0;
+	build_usec = 0;
 	draw_instruction_list.index = 0;
 	compute_instruction_list.index = 0;
 	tracking_frame++;
@@ -1554,6 +1763,16 @@ void RenderingDeviceGraph::add_draw_list_draw_indexed(uint32_t p_index_count, ui
 	instruction->first_index = p_first_index;
 }
 
+void RenderingDeviceGraph::add_draw_list_draw_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride, bool p_indexed) {
+	DrawListDrawIndirectInstruction *instruction = reinterpret_cast<DrawListDrawIndirectInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListDrawIndirectInstruction)));
+	instruction->type = p_indexed ? DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT : DrawListInstruction::TYPE_DRAW_INDIRECT;
+	instruction->buffer = p_buffer;
+	instruction->offset = p_offset;
+	instruction->draw_count = p_draw_count;
+	instruction->stride = p_stride;
+	draw_instruction_list.stages.set_flag(RDD::PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+}
+
 void RenderingDeviceGraph::add_draw_list_execute_commands(RDD::CommandBufferID p_command_buffer) {
 	DrawListExecuteCommandsInstruction *instruction = reinterpret_cast<DrawListExecuteCommandsInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListExecuteCommandsInstruction)));
 	instruction->type = DrawListInstruction::TYPE_EXECUTE_COMMANDS;
@@ -1629,22 +1848,11 @@ void RenderingDeviceGraph::add_draw_list_end() {
 	// Arbitrary size threshold to evaluate if it'd be best to record the draw list on the background as a secondary buffer.
 	const uint32_t instruction_data_threshold_for_secondary = 16384;
 	RDD::CommandBufferType command_buffer_type;
-	uint32_t &secondary_buffers_used = frames[frame].secondary_command_buffers_used;
+	const uint32_t secondary_buffers_used = frames[frame].secondary_command_buffers_used;
 	if (draw_instruction_list.data.size() > instruction_data_threshold_for_secondary && secondary_buffers_used < frames[frame].secondary_command_buffers.size()) {
-		// Copy the current instruction list data into another array that will be used by the secondary command buffer worker.
-		SecondaryCommandBuffer &secondary = frames[frame].secondary_command_buffers[secondary_buffers_used];
-		secondary.render_pass = draw_instruction_list.render_pass;
-		secondary.framebuffer = draw_instruction_list.framebuffer;
-		secondary.instruction_data.resize(draw_instruction_list.data.size());
-		memcpy(secondary.instruction_data.ptr(), draw_instruction_list.data.ptr(), draw_instruction_list.data.size());
-
-		// Run a background task for recording the secondary command buffer.
-		secondary.task = WorkerThreadPool::get_singleton()->add_template_task(this, &RenderingDeviceGraph::_run_secondary_command_buffer_task, &secondary, true);
-
-		// Clear the instruction list and add a single command for executing the secondary command buffer instead.
-		draw_instruction_list.data.clear();
-		add_draw_list_execute_commands(secondary.command_buffer);
-		secondary_buffers_used++;
+		// Split the instruction list into chunks of roughly the threshold's size and record each one on a background task as a secondary
+		// command buffer. The instruction list is replaced by the commands that execute them in order.
+		_record_draw_list_in_secondary_command_buffers(instruction_data_threshold_for_secondary);
 
 		command_buffer_type = RDD::COMMAND_BUFFER_TYPE_SECONDARY;
 	} else {
@@ -1807,6 +2015,10 @@ void RenderingDeviceGraph::end(RDD::CommandBufferID p_command_buffer, bool p_reo
 		return;
 	}
 
+	const uint64_t end_begin_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t reorder_usec = 0;
+	uint32_t level_count = command_count;
+
 	thread_local LocalVector<RecordedCommandSort> commands_sorted;
 	if (p_reorder_commands) {
 		thread_local LocalVector<int64_t> command_stack;
@@ -1910,6 +2122,8 @@ void RenderingDeviceGraph::end(RDD::CommandBufferID p_command_buffer, bool p_reo
 		}
 	}
 
+	reorder_usec = OS::get_singleton()->get_ticks_usec() - end_begin_usec;
+
 	_wait_for_secondary_command_buffer_tasks();
 
 	if (command_count > 0) {
@@ -1923,7 +2137,9 @@ void RenderingDeviceGraph::end(RDD::CommandBufferID p_command_buffer, bool p_reo
 			_print_render_commands(commands_sorted.ptr(), command_count);
 #endif
 
+			const uint64_t sort_begin_usec = OS::get_singleton()->get_ticks_usec();
 			commands_sorted.sort();
+			reorder_usec += OS::get_singleton()->get_ticks_usec() - sort_begin_usec;
 
 #if PRINT_RENDER_GRAPH
 			print_line("AFTER SORT");
@@ -1954,6 +2170,7 @@ void RenderingDeviceGraph::end(RDD::CommandBufferID p_command_buffer, bool p_reo
 			_boost_priority_for_render_commands(level_command_ptr, level_command_count, boosted_priority);
 			_group_barriers_for_render_commands(p_command_buffer, level_command_ptr, level_command_count, p_full_barriers);
 			_run_render_commands(p_command_buffer, current_level, level_command_ptr, level_command_count, current_label_index, current_label_level);
+			level_count = current_level + 1;
 
 #if PRINT_RENDER_GRAPH
 			print_line("COMMANDS", command_count, "LEVELS", current_level + 1);
@@ -1972,10 +2189,26 @@ void RenderingDeviceGraph::end(RDD::CommandBufferID p_command_buffer, bool p_reo
 #endif
 	}
 
+	statistics.build_usec = build_usec;
+	statistics.reorder_usec = reorder_usec;
+	statistics.record_usec = OS::get_singleton()->get_ticks_usec() - end_begin_usec - reorder_usec;
+	statistics.command_count = command_count;
+	statistics.level_count = level_count;
+	statistics.secondary_command_buffer_count = frames[frame].secondary_command_buffers_used;
+	statistics.command_data_size = command_data.size();
+
 	// Advance the frame counter. It's not necessary to do this if no commands are recorded because that means no secondary command buffers were used.
 	frame = (frame + 1) % frames.size();
 }
 
+void RenderingDeviceGraph::request_statistics() {
+	statistics_requested.set();
+}
+
+const RenderingDeviceGraph::Statistics &RenderingDeviceGraph::get_statistics() const {
+	return statistics;
+}
+
 #if PRINT_RESOURCE_TRACKER_TOTAL
 static uint32_t resource_tracker_total = 0;
 #endif
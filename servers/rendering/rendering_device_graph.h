@@ -69,6 +69,8 @@ public:
 			TYPE_CLEAR_ATTACHMENTS,
 			TYPE_DRAW,
 			TYPE_DRAW_INDEXED,
+			TYPE_DRAW_INDIRECT,
+			TYPE_DRAW_INDEXED_INDIRECT,
 			TYPE_EXECUTE_COMMANDS,
 			TYPE_NEXT_SUBPASS,
 			TYPE_SET_BLEND_CONSTANTS,
@@ -184,6 +186,20 @@ public:
 		}
 	};
 
+	struct Statistics {
+		// Time spent adding commands to the graph and resolving their dependencies.
+		uint64_t build_usec = 0;
+		// Time spent computing the levels of the graph and sorting the commands.
+		uint64_t reorder_usec = 0;
+		// Time spent recording the commands and barriers into the command buffer.
+		uint64_t record_usec = 0;
+		uint32_t command_count = 0;
+		uint32_t level_count = 0;
+		uint32_t secondary_command_buffer_count = 0;
+		// Size of the commands recorded by the CPU, including draw and compute list instructions.
+		uint64_t command_data_size = 0;
+	};
+
 private:
 	struct InstructionList {
 		LocalVector<uint8_t> data;
@@ -435,6 +451,13 @@ private:
 		uint32_t first_index = 0;
 	};
 
+	struct DrawListDrawIndirectInstruction : DrawListInstruction {
+		RDD::BufferID buffer;
+		uint32_t offset = 0;
+		uint32_t draw_count = 0;
+		uint32_t stride = 0;
+	};
+
 	struct DrawListEndRenderPassInstruction : DrawListInstruction {
 		// No contents.
 	};
@@ -584,6 +607,9 @@ private:
 	bool driver_honors_barriers = false;
 	TightLocalVector<Frame> frames;
 	uint32_t frame = 0;
+	Statistics statistics;
+	SafeFlag statistics_requested; // Timing every command isn't free, so it only starts once someone asks for the statistics.
+	uint64_t build_usec = 0;
 
 #ifdef DEV_ENABLED
 	RBMap<ResourceTracker *, uint32_t> write_dependency_counters;
@@ -606,6 +632,8 @@ private:
 #endif
 	void _run_compute_list_command(RDD::CommandBufferID p_command_buffer, const uint8_t *p_instruction_data, uint32_t p_instruction_data_size);
 	void _run_draw_list_command(RDD::CommandBufferID p_command_buffer, const uint8_t *p_instruction_data, uint32_t p_instruction_data_size);
+	static uint32_t _get_draw_list_instruction_size(const DrawListInstruction *p_instruction);
+	void _record_draw_list_in_secondary_command_buffers(uint32_t p_chunk_size);
 	void _run_secondary_command_buffer_task(const SecondaryCommandBuffer *p_secondary);
 	void _wait_for_secondary_command_buffer_tasks();
 	void _run_render_commands(RDD::CommandBufferID p_command_buffer, int32_t p_level, const RecordedCommandSort *p_sorted_commands, uint32_t p_sorted_commands_count, int32_t &r_current_label_index, int32_t &r_current_label_level);
@@ -622,6 +650,13 @@ public:
 	void initialize(RDD *p_driver, uint32_t p_frame_count, RDD::CommandQueueFamilyID p_secondary_command_queue_family, uint32_t p_secondary_command_buffers_per_frame);
 	void finalize();
 	void begin();
+	// Statistics are only fully measured from the frame after they're requested.
+	void request_statistics();
+	const Statistics &get_statistics() const;
+	// Splits draw list instructions in up to p_max_chunks chunks of about p_chunk_size bytes, only after draws. Every chunk after the first
+	// starts with the instructions that set the state in effect at that point. Returns the number of chunks used.
+	static uint32_t split_draw_list_instructions(const uint8_t *p_instruction_data, uint32_t p_instruction_data_size, uint32_t p_chunk_size, LocalVector<uint8_t> *const *r_chunks, uint32_t p_max_chunks);
+	const LocalVector<uint8_t> &get_draw_list_instruction_data() const { return draw_instruction_list.data; }
 	void add_buffer_clear(RDD::BufferID p_dst, ResourceTracker *p_dst_tracker, uint32_t p_offset, uint32_t p_size);
 	void add_buffer_copy(RDD::BufferID p_src, ResourceTracker *p_src_tracker, RDD::BufferID p_dst, ResourceTracker *p_dst_tracker, RDD::BufferCopyRegion p_region);
 	void add_buffer_get_data(RDD::BufferID p_src, ResourceTracker *p_src_tracker, RDD::BufferID p_dst, RDD::BufferCopyRegion p_region);
@@ -644,6 +679,7 @@ public:
 	void add_draw_list_clear_attachments(VectorView<RDD::AttachmentClear> p_attachments_clear, VectorView<Rect2i> p_attachments_clear_rect);
 	void add_draw_list_draw(uint32_t p_vertex_count, uint32_t p_instance_count);
 	void add_draw_list_draw_indexed(uint32_t p_index_count, uint32_t p_instance_count, uint32_t p_first_index);
+	void add_draw_list_draw_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride, bool p_indexed);
 	void add_draw_list_execute_commands(RDD::CommandBufferID p_command_buffer);
 	void add_draw_list_next_subpass(RDD::CommandBufferType p_command_buffer_type);
 	void add_draw_list_set_blend_constants(const Color &p_color);
@@ -355,6 +355,7 @@ public:
 	FUNC3(skeleton_allocate_data, RID, int, bool)
 	FUNC1RC(int, skeleton_get_bone_count, RID)
 	FUNC3(skeleton_bone_set_transform, RID, int, const Transform3D &)
+	FUNC2(skeleton_set_bone_transforms, RID, const Vector<Transform3D> &)
 	FUNC2RC(Transform3D, skeleton_bone_get_transform, RID, int)
 	FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
@@ -973,6 +974,10 @@ public:
 	FUNC0RC(String, get_video_adapter_name)
 	FUNC0RC(String, get_video_adapter_vendor)
 	FUNC0RC(String, get_video_adapter_api_version)
+
+	FUNC0(pipeline_variants_capture_start)
+	FUNC1R(Error, pipeline_variants_capture_stop, const String &)
+	FUNC0RC(bool, is_capturing_pipeline_variants)
 #undef server_name
 #undef ServerName
 #undef WRITE_ACTION
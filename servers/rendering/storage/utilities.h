@@ -183,6 +183,10 @@ public:
 	virtual RenderingDevice::DeviceType get_video_adapter_type() const = 0;
 	virtual String get_video_adapter_api_version() const = 0;
 
+	virtual void pipeline_variants_capture_start() = 0;
+	virtual Error pipeline_variants_capture_stop(const String &p_path) = 0;
+	virtual bool is_capturing_pipeline_variants() const = 0;
+
 	virtual Size2i get_maximum_viewport_size() const = 0;
 };
 
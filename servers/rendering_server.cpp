@@ -3353,6 +3353,10 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_video_adapter_type"), &RenderingServer::get_video_adapter_type);
 	ClassDB::bind_method(D_METHOD("get_video_adapter_api_version"), &RenderingServer::get_video_adapter_api_version);
 
+	ClassDB::bind_method(D_METHOD("pipeline_variants_capture_start"), &RenderingServer::pipeline_variants_capture_start);
+	ClassDB::bind_method(D_METHOD("pipeline_variants_capture_stop", "path"), &RenderingServer::pipeline_variants_capture_stop);
+	ClassDB::bind_method(D_METHOD("is_capturing_pipeline_variants"), &RenderingServer::is_capturing_pipeline_variants);
+
 	ClassDB::bind_method(D_METHOD("make_sphere_mesh", "latitudes", "longitudes", "radius"), &RenderingServer::make_sphere_mesh);
 	ClassDB::bind_method(D_METHOD("get_test_cube"), &RenderingServer::get_test_cube);
 
@@ -3379,6 +3383,9 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_SHADER_COMPILATIONS_QUEUED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_SHADER_COMPILATION_TIME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_TEXTURE_ATLAS_BINDS_SAVED);
 
 	ADD_SIGNAL(MethodInfo("frame_pre_draw"));
 	ADD_SIGNAL(MethodInfo("frame_post_draw"));
@@ -3484,10 +3491,15 @@ void RenderingServer::init() {
 	GLOBAL_DEF("rendering/lights_and_shadows/positional_shadow/soft_shadow_filter_quality.mobile", 0);
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/shadow_atlas/size", PROPERTY_HINT_RANGE, "128,16384"), 2048);
+	GLOBAL_DEF_RST("rendering/2d/texture_atlas/enabled", false);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/texture_atlas/max_texture_size", PROPERTY_HINT_RANGE, "16,1024,1"), 256);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/texture_atlas/page_size", PROPERTY_HINT_RANGE, "256,8192,1"), 2048);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/texture_atlas/max_pages", PROPERTY_HINT_RANGE, "1,16,1"), 4);
 
 	// Number of commands that can be drawn per frame.
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
 
+	GLOBAL_DEF_RST("rendering/shader_compiler/background_compilation/enabled", false);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/compress", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/use_zstd_compression", true);
@@ -3575,6 +3587,9 @@ void RenderingServer::init() {
 
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/update_iterations_per_frame", PROPERTY_HINT_RANGE, "0,1024,1"), 10);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 1000);
+	GLOBAL_DEF_RST("rendering/limits/spatial_indexer/use_temporal_coherence", false);
+
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/canvas/threaded_cull_minimum_children", PROPERTY_HINT_RANGE, "128,65536,1"), 1024);
 
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"), 512);
 
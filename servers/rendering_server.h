@@ -430,6 +430,7 @@ public:
 	virtual void skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) = 0;
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) = 0;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const Vector<Transform3D> &p_transforms) = 0;
 	virtual Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
@@ -1575,6 +1576,9 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_SHADER_COMPILATIONS_QUEUED,
+		RENDERING_INFO_SHADER_COMPILATION_TIME,
+		RENDERING_INFO_CANVAS_TEXTURE_ATLAS_BINDS_SAVED,
 		RENDERING_INFO_MAX
 	};
 
@@ -1584,6 +1588,10 @@ public:
 	virtual RenderingDevice::DeviceType get_video_adapter_type() const = 0;
 	virtual String get_video_adapter_api_version() const = 0;
 
+	virtual void pipeline_variants_capture_start() = 0;
+	virtual Error pipeline_variants_capture_stop(const String &p_path) = 0;
+	virtual bool is_capturing_pipeline_variants() const = 0;
+
 	struct FrameProfileArea {
 		String name;
 		double gpu_msec;
@@ -107,6 +107,73 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped range") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	uint64_t length = f->get_length();
+	Vector<uint8_t> contents = f->get_buffer(length);
+	REQUIRE(uint64_t(contents.size()) == length);
+
+	const uint8_t *mapped = f->get_mapped_range(0, length);
+	if (mapped) {
+		// Not every platform supports memory mapping, but when it does the contents must match.
+		CHECK(memcmp(mapped, contents.ptr(), length) == 0);
+		CHECK(f->get_mapped_range(6, 8) == mapped + 6);
+		CHECK(f->get_mapped_range(length - 1, 2) == nullptr);
+		CHECK(f->get_mapped_range(length + 1, 0) == nullptr);
+	}
+	CHECK_MESSAGE(f->get_position() == length, "Mapping a range should not move the read position.");
+}
+
+static void _async_read_callback(void *p_userdata, const String &p_path, Error p_error, const Vector<uint8_t> &p_data) {
+	if (p_error == OK) {
+		*(String *)p_userdata = String::utf8((const char *)p_data.ptr(), p_data.size());
+	}
+}
+
+TEST_CASE("[FileAccess] Async read") {
+	String whole;
+	String range;
+
+	Vector<FileAccess::AsyncRead> reads;
+	reads.resize(2);
+	reads.write[0].path = TestUtils::get_data_path("line_endings_lf.test.txt");
+	reads.write[0].callback = _async_read_callback;
+	reads.write[0].userdata = &whole;
+	reads.write[1].path = reads[0].path;
+	reads.write[1].offset = 15;
+	reads.write[1].length = 13;
+	reads.write[1].callback = _async_read_callback;
+	reads.write[1].userdata = &range;
+
+	FileAccess::read_async(reads);
+	FileAccess::wait_for_async_reads();
+
+	CHECK(whole == "Hello darkness\nMy old friend\nI've come to talk\nWith you again\n");
+	CHECK(range == "My old friend");
+}
+
+static String _async_resolve_path(const String &p_path) {
+	return TestUtils::get_data_path(p_path);
+}
+
+TEST_CASE("[FileAccess] Async read resolves the path on the I/O thread") {
+	String whole;
+
+	Vector<FileAccess::AsyncRead> reads;
+	reads.resize(1);
+	reads.write[0].path = "line_endings_lf.test.txt";
+	reads.write[0].callback = _async_read_callback;
+	reads.write[0].userdata = &whole;
+	reads.write[0].resolve_path = _async_resolve_path;
+
+	FileAccess::read_async(reads);
+	FileAccess::wait_for_async_reads();
+
+	CHECK(whole == "Hello darkness\nMy old friend\nI've come to talk\nWith you again\n");
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -31,7 +31,10 @@
 #ifndef TEST_JSON_H
 #define TEST_JSON_H
 
+#include "core/io/dir_access.h"
 #include "core/io/json.h"
+#include "core/io/stream_peer.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -232,6 +235,252 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 text") {
+	const String json_string = String::utf8("{\"name\": \"Gödöllő \\u00e9t\\u00e9\", \"values\": [1, -2.5e3, true, null],\n\"nested\": {\"empty\": \"\"}}");
+	const CharString json_utf8 = json_string.utf8();
+
+	JSON json_from_string;
+	REQUIRE(json_from_string.parse(json_string) == OK);
+
+	Vector<uint8_t> bytes;
+	bytes.resize(json_utf8.length());
+	memcpy(bytes.ptrw(), json_utf8.get_data(), json_utf8.length());
+
+	JSON json;
+	CHECK(json.parse_utf8(bytes) == OK);
+	CHECK(json.get_data() == json_from_string.get_data());
+	CHECK(Dictionary(json.get_data())["name"] == String::utf8("Gödöllő été"));
+
+	// A byte order mark is skipped.
+	Vector<uint8_t> bytes_with_bom = bytes;
+	bytes_with_bom.insert(0, 0xBF);
+	bytes_with_bom.insert(0, 0xBB);
+	bytes_with_bom.insert(0, 0xEF);
+	CHECK(json.parse_utf8(bytes_with_bom) == OK);
+	CHECK(json.get_data() == json_from_string.get_data());
+
+	// Errors are reported on the same line as when parsing a String.
+	bytes.resize(bytes.size() - 1);
+	CHECK(json.parse_utf8(bytes) == ERR_PARSE_ERROR);
+	CHECK(json_from_string.parse(json_string.substr(0, json_string.length() - 1)) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == json_from_string.get_error_line());
+}
+
+TEST_CASE("[JSON] Parsing a file in chunks") {
+	// Big enough to span several chunks, with strings and numbers crossing chunk boundaries.
+	Array array;
+	for (int i = 0; i < 20000; i++) {
+		array.push_back(String::utf8("Gödöllő ") + itos(i));
+		array.push_back(i * 1.5);
+	}
+	const String json_string = JSON::stringify(array, "\t");
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_json_chunks.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_8(0xEF); // Byte order mark.
+		f->store_8(0xBB);
+		f->store_8(0xBF);
+		f->store_string(json_string);
+	}
+
+	JSON json;
+	CHECK(json.parse_file(FileAccess::open(path, FileAccess::READ)) == OK);
+	CHECK(json.get_data() == Variant(array));
+	CHECK(json.get_parsed_text().is_empty());
+
+	CHECK(json.parse_file(FileAccess::open(path, FileAccess::READ), true) == OK);
+	CHECK(json.get_data() == Variant(array));
+	CHECK(json.get_parsed_text() == json_string);
+
+	// Errors are reported on the same line as when parsing a String.
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(json_string.substr(0, json_string.length() - 1));
+	}
+	JSON json_from_string;
+	CHECK(json.parse_file(FileAccess::open(path, FileAccess::READ)) == ERR_PARSE_ERROR);
+	CHECK(json_from_string.parse(json_string.substr(0, json_string.length() - 1)) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == json_from_string.get_error_line());
+
+	DirAccess::remove_absolute(path);
+}
+
+// Records the events as text, and counts them.
+class JSONTestSink : public JSON::EventSink {
+public:
+	String events;
+	bool record = true;
+	int values = 0;
+	int keys = 0;
+	int containers = 0;
+
+	virtual void begin_object() override {
+		containers++;
+		if (record) {
+			events += "{";
+		}
+	}
+	virtual void key(const String &p_key) override {
+		keys++;
+		if (record) {
+			events += p_key + ":";
+		}
+	}
+	virtual void end_object() override {
+		if (record) {
+			events += "}";
+		}
+	}
+	virtual void begin_array() override {
+		containers++;
+		if (record) {
+			events += "[";
+		}
+	}
+	virtual void end_array() override {
+		if (record) {
+			events += "]";
+		}
+	}
+	virtual void value(const Variant &p_value) override {
+		values++;
+		if (record) {
+			events += Variant::get_type_name(p_value.get_type()) + "(" + p_value.stringify() + ")";
+		}
+	}
+};
+
+TEST_CASE("[JSON] Parsing with an event sink") {
+	JSON json;
+	JSONTestSink sink;
+	CHECK(json.parse_events("{\"a\": [1, \"two\", true, null], \"b\": {\"c\": {}}}", &sink) == OK);
+	CHECK(sink.events == "{a:[float(1)String(two)bool(true)Nil(<null>)]b:{c:{}}}");
+	CHECK_MESSAGE(json.get_data() == Variant(), "Parsing events should not set the data.");
+
+	JSONTestSink error_sink;
+	JSON json_from_string;
+	CHECK(json.parse_events("[1,\n2,\n}", &error_sink) == ERR_PARSE_ERROR);
+	CHECK(json_from_string.parse("[1,\n2,\n}") == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == json_from_string.get_error_line());
+	CHECK(json.get_error_message() == json_from_string.get_error_message());
+	CHECK_MESSAGE(error_sink.events == "[float(1)float(2)", "Events should be reported up to the error.");
+}
+
+TEST_CASE("[JSON] Parsing a stream") {
+	Dictionary dictionary;
+	dictionary["name"] = String::utf8("Gödöllő");
+	Array values;
+	values.push_back(1.0);
+	values.push_back(2.5);
+	values.push_back("three");
+	dictionary["values"] = values;
+	const CharString json_utf8 = JSON::stringify(dictionary).utf8();
+
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	stream->put_data((const uint8_t *)json_utf8.get_data(), json_utf8.length());
+	stream->put_u32(0x12345678); // Followed by something else.
+	stream->seek(0);
+
+	JSON json;
+	CHECK(json.parse_stream(stream, json_utf8.length()) == OK);
+	CHECK(json.get_data() == Variant(dictionary));
+	CHECK_MESSAGE(stream->get_u32() == 0x12345678, "Only the text should be read from the stream.");
+
+	// The whole text is consumed even if it's invalid, so the stream stays in sync.
+	stream->seek(0);
+	CHECK(json.parse_stream(stream, 4) == ERR_PARSE_ERROR);
+	CHECK(stream->get_position() == 4);
+
+	stream->seek(0);
+	JSONTestSink sink;
+	CHECK(json.parse_stream_events(stream, json_utf8.length(), &sink) == OK);
+	CHECK(sink.values == 4);
+	CHECK(sink.keys == 2);
+}
+
+static String make_large_json(int p_items) {
+	String json_string = "[";
+	for (int i = 0; i < p_items; i++) {
+		if (i > 0) {
+			json_string += ",\n";
+		}
+		json_string += vformat("{\"id\": %d, \"name\": \"item %d\", \"position\": [%f, %f, %f], \"tags\": [\"a\", \"b\"], \"visible\": %s}", i, i, i * 0.5, i * 0.25, -i * 1.5, i % 2 ? "true" : "false");
+	}
+	json_string += "]";
+	return json_string;
+}
+
+TEST_CASE("[JSON] Parsing a large file with an event sink") {
+	// Several megabytes, without building a Variant holding all of them.
+	const int items = 50000;
+	const String json_string = make_large_json(items);
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_json_large.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(json_string);
+	}
+
+	JSON json;
+	JSONTestSink sink;
+	sink.record = false;
+	CHECK(json.parse_file_events(FileAccess::open(path, FileAccess::READ), &sink) == OK);
+	CHECK(sink.containers == 1 + items * 3);
+	CHECK(sink.keys == items * 5);
+	CHECK(sink.values == items * 8);
+
+	// Building the data from the file gives the same result as from the text.
+	JSON json_from_string;
+	CHECK(json_from_string.parse(json_string) == OK);
+	CHECK(json.parse_file(FileAccess::open(path, FileAccess::READ)) == OK);
+	CHECK(json.get_data() == json_from_string.get_data());
+
+	DirAccess::remove_absolute(path);
+}
+
+// Run with `--test --no-skip --test-case="*Benchmark*"`.
+TEST_CASE_PENDING("[JSON] Benchmark parsing throughput") {
+	const String json_string = make_large_json(500000);
+	const CharString json_utf8 = json_string.utf8();
+	const double size_mib = json_utf8.length() / (1024.0 * 1024.0);
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_json_benchmark.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer((const uint8_t *)json_utf8.get_data(), json_utf8.length());
+	}
+	Vector<uint8_t> json_buffer;
+	json_buffer.resize(json_utf8.length());
+	memcpy(json_buffer.ptrw(), json_utf8.get_data(), json_utf8.length());
+
+	JSON json;
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	CHECK(json.parse(json_string) == OK);
+	const double string_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	CHECK(json.parse_utf8(json_buffer) == OK);
+	const double utf8_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	CHECK(json.parse_file(FileAccess::open(path, FileAccess::READ)) == OK);
+	const double file_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+	JSONTestSink sink;
+	sink.record = false;
+	from = OS::get_singleton()->get_ticks_usec();
+	CHECK(json.parse_file_events(FileAccess::open(path, FileAccess::READ), &sink) == OK);
+	const double events_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+	print_line(vformat("Parsing %.1f MiB of JSON: %.1f MiB/s from a String, %.1f MiB/s from UTF-8, %.1f MiB/s from a file, %.1f MiB/s from a file to an event sink.", size_mib, size_mib / (string_msec / 1000.0), size_mib / (utf8_msec / 1000.0), size_mib / (file_msec / 1000.0), size_mib / (events_msec / 1000.0)));
+
+	DirAccess::remove_absolute(path);
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -326,6 +326,59 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] Single pass Variant encoding") {
+	Dictionary d;
+	d["string"] = "Hello, world";
+	d[StringName("string_name")] = 42;
+	d[Vector2(1, 2)] = PackedStringArray({ "a", "bcd", "" });
+	Array a;
+	a.push_back(PackedInt32Array({ 1, -2, 3 }));
+	a.push_back(PackedFloat64Array({ 0.25, 1e100 }));
+	a.push_back(PackedColorArray({ Color(1, 0.5, 0.25, 1) }));
+	a.push_back(d);
+	a.push_back(Variant());
+	a.push_back(1e100);
+
+	int len;
+	REQUIRE(encode_variant(a, nullptr, len) == OK);
+	Vector<uint8_t> two_pass;
+	two_pass.resize(len);
+	REQUIRE(encode_variant(a, two_pass.ptrw(), len) == OK);
+
+	LocalVector<uint8_t> single_pass;
+	single_pass.push_back(0xff); // Encoding is appended to the existing contents.
+	REQUIRE(encode_variant(a, single_pass) == OK);
+	REQUIRE(single_pass.size() == uint32_t(len + 1));
+	CHECK(single_pass[0] == 0xff);
+	CHECK(memcmp(single_pass.ptr() + 1, two_pass.ptr(), len) == 0);
+
+	Variant decoded;
+	int r_len;
+	CHECK(decode_variant(decoded, single_pass.ptr() + 1, len, &r_len) == OK);
+	CHECK(r_len == len);
+	CHECK(decoded == Variant(a));
+}
+
+TEST_CASE("[Marshalls] Single pass Variant encoding stops at the size limit") {
+	PackedByteArray big;
+	big.resize(1024);
+	Array a;
+	a.push_back("small");
+	a.push_back(big);
+	a.push_back("never encoded");
+
+	int len;
+	REQUIRE(encode_variant(a, nullptr, len) == OK);
+
+	LocalVector<uint8_t> buffer;
+	CHECK(encode_variant(a, buffer, false, len) == OK);
+	CHECK(buffer.size() == uint32_t(len));
+
+	buffer.clear();
+	CHECK(encode_variant(a, buffer, false, 512) == ERR_OUT_OF_MEMORY);
+	CHECK_MESSAGE(buffer.size() <= 512, "The buffer should never grow past the limit.");
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
@@ -31,8 +31,10 @@
 #ifndef TEST_PCK_PACKER_H
 #define TEST_PCK_PACKER_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -40,6 +42,11 @@
 
 namespace TestPCKPacker {
 
+static void read_compressed_file_task(void *p_userdata) {
+	Vector<uint8_t> *data = (Vector<uint8_t> *)p_userdata;
+	*data = FileAccess::get_file_as_bytes("res://pck_compression_test/large.bin");
+}
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_empty.pck");
@@ -117,6 +124,260 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Identical files share stored data") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	Vector<uint8_t> data;
+	data.resize(16384);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = i * 7;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join(vformat("pck_dedup_%d.bin", i)), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+		if (i == 2) {
+			f->store_8(1); // Different contents.
+		}
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = cache_path.path_join("output_dedup.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	for (int i = 0; i < 3; i++) {
+		CHECK(pck_packer.add_file(vformat("res://pck_dedup_test/file_%d.bin", i), cache_path.path_join(vformat("pck_dedup_%d.bin", i))) == OK);
+	}
+	CHECK(pck_packer.add_file("res://pck_dedup_test/file_0_copy.bin", cache_path.path_join("pck_dedup_0.bin")) == OK);
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(
+				f->get_length() >= 2 * 16384,
+				"The generated PCK file should hold two distinct payloads.");
+		CHECK_MESSAGE(
+				f->get_length() < 3 * 16384,
+				"Identical files should be stored only once.");
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	Vector<uint8_t> different = data;
+	different.push_back(1);
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes("res://pck_dedup_test/file_0.bin") == data,
+			"The first copy should read back its contents.");
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes("res://pck_dedup_test/file_1.bin") == data,
+			"An identical file should read back the shared contents.");
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes("res://pck_dedup_test/file_0_copy.bin") == data,
+			"A file added twice should read back the shared contents.");
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes("res://pck_dedup_test/file_2.bin") == different,
+			"A file with different contents should read back its own contents.");
+
+	PackedData::get_singleton()->clear();
+	CHECK_FALSE(FileAccess::exists("res://pck_dedup_test/file_0.bin"));
+	for (int i = 0; i < 3; i++) {
+		DirAccess::remove_absolute(cache_path.path_join(vformat("pck_dedup_%d.bin", i)));
+	}
+	DirAccess::remove_absolute(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Packing the same files twice gives identical output") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+
+	// Enough files of different sizes to be prepared on several workers.
+	const int file_count = 64;
+	for (int i = 0; i < file_count; i++) {
+		Vector<uint8_t> data;
+		data.resize(1000 + i * 997);
+		for (int j = 0; j < data.size(); j++) {
+			data.write[j] = (j * (i + 1)) % 251;
+		}
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join(vformat("pck_deterministic_%d.bin", i)), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	Vector<uint8_t> outputs[2];
+	for (int run = 0; run < 2; run++) {
+		PCKPacker pck_packer;
+		const String output_pck_path = cache_path.path_join(vformat("output_deterministic_%d.pck", run));
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		pck_packer.set_compression_enabled(true);
+		pck_packer.set_compression_dictionary_size(4096);
+		for (int i = 0; i < file_count; i++) {
+			CHECK(pck_packer.add_file(vformat("res://pck_deterministic_test/file_%d.bin", i), cache_path.path_join(vformat("pck_deterministic_%d.bin", i))) == OK);
+		}
+		// Identical contents, to also go through deduplication.
+		CHECK(pck_packer.add_file("res://pck_deterministic_test/file_0_copy.bin", cache_path.path_join("pck_deterministic_0.bin")) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		outputs[run] = FileAccess::get_file_as_bytes(output_pck_path);
+		DirAccess::remove_absolute(output_pck_path);
+	}
+
+	CHECK(outputs[0].size() > 0);
+	CHECK_MESSAGE(outputs[0] == outputs[1], "Preparing the files in parallel shouldn't change the output.");
+
+	for (int i = 0; i < file_count; i++) {
+		DirAccess::remove_absolute(cache_path.path_join(vformat("pck_deterministic_%d.bin", i)));
+	}
+}
+
+TEST_CASE("[PCKPacker] Compressed files") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+
+	// Many small similar files, and one spanning enough blocks to be decompressed in parallel.
+	Vector<String> small_texts;
+	for (int i = 0; i < 32; i++) {
+		small_texts.push_back(vformat("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nname = \"item_%d\"\nvalue = %d\n", i, i * 31));
+	}
+	Vector<uint8_t> large;
+	large.resize(2 * 1024 * 1024 + 123);
+	for (int i = 0; i < large.size(); i++) {
+		large.write[i] = (i / 7) % 61;
+	}
+
+	for (int i = 0; i < small_texts.size(); i++) {
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join(vformat("pck_small_%d.tres", i)), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(small_texts[i]);
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join("pck_large.bin"), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(large);
+	}
+
+	uint64_t pck_sizes[2] = {};
+	for (int compressed = 0; compressed < 2; compressed++) {
+		PCKPacker pck_packer;
+		const String output_pck_path = cache_path.path_join(vformat("output_compressed_%d.pck", compressed));
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		pck_packer.set_compression_enabled(compressed);
+		pck_packer.set_compression_dictionary_size(compressed ? 4096 : 0);
+		for (int i = 0; i < small_texts.size(); i++) {
+			CHECK(pck_packer.add_file(vformat("res://pck_compression_test/small_%d.tres", i), cache_path.path_join(vformat("pck_small_%d.tres", i))) == OK);
+		}
+		CHECK(pck_packer.add_file("res://pck_compression_test/large.bin", cache_path.path_join("pck_large.bin")) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		pck_sizes[compressed] = f->get_length();
+		f->seek(4);
+		CHECK_MESSAGE(
+				f->get_32() == uint32_t(compressed ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_UNCOMPRESSED),
+				"Only packs holding compressed files should use the newer format version.");
+	}
+
+	CHECK_MESSAGE(
+			pck_sizes[1] < pck_sizes[0] / 4,
+			"Compressing the files should make the PCK much smaller.");
+
+	REQUIRE(PackedData::get_singleton()->add_pack(cache_path.path_join("output_compressed_1.pck"), true, 0) == OK);
+
+	for (int i = 0; i < small_texts.size(); i++) {
+		CHECK(FileAccess::get_file_as_string(vformat("res://pck_compression_test/small_%d.tres", i)) == small_texts[i]);
+	}
+
+	Ref<FileAccess> f = FileAccess::open("res://pck_compression_test/large.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)large.size());
+
+	Vector<uint8_t> read;
+	read.resize(large.size());
+	CHECK(f->get_buffer(read.ptrw(), read.size()) == (uint64_t)large.size());
+	CHECK_MESSAGE(read == large, "Reading the whole compressed file should return its contents.");
+
+	const uint64_t seek_pos = 1000000;
+	f->prefetch(seek_pos, 65536); // Only a hint, reads must not depend on it.
+	f->seek(seek_pos);
+	CHECK(f->get_8() == large[seek_pos]);
+	uint8_t partial[16];
+	CHECK(f->get_buffer(partial, 16) == 16);
+	CHECK(memcmp(partial, large.ptr() + seek_pos + 1, 16) == 0);
+
+	// Reads made from worker threads are decompressed serially, with the same result.
+	Vector<uint8_t> read_on_worker;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&read_compressed_file_task, &read_on_worker);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	CHECK_MESSAGE(read_on_worker == large, "Reading the compressed file from a worker thread should return its contents.");
+
+	f.unref();
+	PackedData::get_singleton()->clear();
+}
+
+// Run with `--test --no-skip --test-case="*Benchmark*"`.
+TEST_CASE_PENDING("[PCKPacker] Benchmark pack size and read throughput of compressed files") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+
+	// Many small text resources and a few large binary files, roughly like an exported project.
+	const int small_count = 2000;
+	const int large_count = 8;
+	for (int i = 0; i < small_count; i++) {
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join(vformat("pck_bench_small_%d.tres", i)), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(vformat("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nname = \"item_%d\"\nvalue = %d\nweight = %f\n", i, i * 31, i * 0.25));
+	}
+	uint64_t total_size = 0;
+	for (int i = 0; i < large_count; i++) {
+		Vector<uint8_t> large;
+		large.resize(8 * 1024 * 1024);
+		for (int j = 0; j < large.size(); j++) {
+			large.write[j] = ((j / (i + 3)) ^ (j >> 11)) % 97;
+		}
+		total_size += large.size();
+		Ref<FileAccess> f = FileAccess::open(cache_path.path_join(vformat("pck_bench_large_%d.bin", i)), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(large);
+	}
+
+	const char *names[3] = { "uncompressed", "compressed", "compressed with dictionary" };
+	for (int mode = 0; mode < 3; mode++) {
+		const String output_pck_path = cache_path.path_join(vformat("output_bench_%d.pck", mode));
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		pck_packer.set_compression_enabled(mode > 0);
+		pck_packer.set_compression_dictionary_size(mode == 2 ? 65536 : 0);
+		for (int i = 0; i < small_count; i++) {
+			CHECK(pck_packer.add_file(vformat("res://pck_bench_%d/small_%d.tres", mode, i), cache_path.path_join(vformat("pck_bench_small_%d.tres", i))) == OK);
+		}
+		for (int i = 0; i < large_count; i++) {
+			CHECK(pck_packer.add_file(vformat("res://pck_bench_%d/large_%d.bin", mode, i), cache_path.path_join(vformat("pck_bench_large_%d.bin", i))) == OK);
+		}
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		REQUIRE(pck_packer.flush() == OK);
+		const double pack_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+		REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+		from = OS::get_singleton()->get_ticks_usec();
+		uint64_t small_read = 0;
+		for (int i = 0; i < small_count; i++) {
+			small_read += FileAccess::get_file_as_bytes(vformat("res://pck_bench_%d/small_%d.tres", mode, i)).size();
+		}
+		const double small_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+
+		from = OS::get_singleton()->get_ticks_usec();
+		uint64_t large_read = 0;
+		for (int i = 0; i < large_count; i++) {
+			large_read += FileAccess::get_file_as_bytes(vformat("res://pck_bench_%d/large_%d.bin", mode, i)).size();
+		}
+		const double large_msec = (OS::get_singleton()->get_ticks_usec() - from) / 1000.0;
+		CHECK(large_read == total_size);
+
+		print_line(vformat("PCK %s: %d bytes, packed in %.1f ms. Read %d small files (%d bytes) in %.1f ms, %d large files at %.1f MiB/s.", names[mode], FileAccess::open(output_pck_path, FileAccess::READ)->get_length(), pack_msec, small_count, small_read, small_msec, large_count, total_size / (1024.0 * 1024.0) / (large_msec / 1000.0)));
+		PackedData::get_singleton()->clear();
+	}
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
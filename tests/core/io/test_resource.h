@@ -31,10 +31,13 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/dir_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -161,6 +164,205 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+// Loads files with its extension as empty resources, and counts how many were loaded on WorkerThreadPool threads.
+class PoolThreadCountingLoader : public ResourceFormatLoader {
+public:
+	SafeNumeric<uint32_t> loads;
+	SafeNumeric<uint32_t> pool_thread_loads;
+
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) override {
+		loads.increment();
+		if (WorkerThreadPool::get_thread_index() != -1) {
+			pool_thread_loads.increment();
+		}
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_name(p_path.get_file().get_basename());
+		if (r_error) {
+			*r_error = OK;
+		}
+		return resource;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("pooltest");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension() == "pooltest" ? "Resource" : "";
+	}
+};
+
+TEST_CASE("[Resource] Parallel dependency loading") {
+	// Every resource depends on two earlier ones, saved to their own files so they are external dependencies.
+	// Each also depends on a leaf handled by a test loader, which tells which threads the dependencies were loaded on.
+	const int count = 64;
+	const bool was_parallel = ResourceLoader::is_parallel_dependency_loading_enabled();
+	ResourceLoader::set_parallel_dependency_loading(true);
+
+	Ref<PoolThreadCountingLoader> leaf_loader;
+	leaf_loader.instantiate();
+	ResourceLoader::add_resource_format_loader(leaf_loader, true);
+
+	const String cache_path = OS::get_singleton()->get_cache_path();
+
+	for (const String &extension : { String("res"), String("tres") }) {
+		leaf_loader->loads.set(0);
+		leaf_loader->pool_thread_loads.set(0);
+
+		{
+			Vector<Ref<Resource>> resources;
+			for (int i = 0; i < count; i++) {
+				Ref<Resource> resource = memnew(Resource);
+				resource->set_name(itos(i));
+				if (i > 0) {
+					resource->set_meta("previous", resources[i - 1]);
+					resource->set_meta("half", resources[i / 2]);
+				}
+				Ref<Resource> leaf = memnew(Resource);
+				leaf->set_path(cache_path.path_join(vformat("leaf_%d.pooltest", i)));
+				resource->set_meta("leaf", leaf);
+
+				const String save_path = cache_path.path_join(vformat("dependency_%d.%s", i, extension));
+				ResourceSaver::save(resource, save_path);
+				resource->set_path(save_path);
+				resources.push_back(resource);
+			}
+		}
+
+		Ref<Resource> loaded = ResourceLoader::load(cache_path.path_join(vformat("dependency_%d.%s", count - 1, extension)));
+		REQUIRE(loaded.is_valid());
+		for (int i = count - 1; i > 0; i--) {
+			CHECK(loaded->get_name() == itos(i));
+			const Ref<Resource> half = loaded->get_meta("half");
+			REQUIRE(half.is_valid());
+			CHECK(half->get_name() == itos(i / 2));
+			const Ref<Resource> leaf = loaded->get_meta("leaf");
+			REQUIRE(leaf.is_valid());
+			CHECK(leaf->get_name() == vformat("leaf_%d", i));
+			loaded = loaded->get_meta("previous");
+			REQUIRE(loaded.is_valid());
+		}
+		CHECK(loaded->get_name() == "0");
+		loaded.unref();
+
+		CHECK(leaf_loader->loads.get() == count);
+		CHECK_MESSAGE(leaf_loader->pool_thread_loads.get() > 0, "Dependencies should be loaded on WorkerThreadPool threads.");
+
+		for (int i = 0; i < count; i++) {
+			DirAccess::remove_absolute(cache_path.path_join(vformat("dependency_%d.%s", i, extension)));
+		}
+	}
+
+	ResourceLoader::remove_resource_format_loader(leaf_loader);
+	ResourceLoader::set_parallel_dependency_loading(was_parallel);
+}
+
+struct ConcurrentCacheState {
+	static const int THREAD_COUNT = 4;
+	static const int PATHS_PER_THREAD = 8;
+	static const int ITERATIONS = 2000;
+
+	// Each thread has its own paths. Some threads get paths that all land in the same cache shard,
+	// the others get paths spread over shards.
+	Vector<String> thread_paths[THREAD_COUNT];
+	// Only thread 0 sets this path, the others keep looking it up while its resource is being replaced.
+	String shared_path;
+
+	SafeNumeric<uint32_t> errors;
+};
+
+struct ConcurrentCacheThread {
+	ConcurrentCacheState *state = nullptr;
+	int index = 0;
+
+	static void thread_func(void *p_userdata) {
+		ConcurrentCacheThread *self = (ConcurrentCacheThread *)p_userdata;
+		ConcurrentCacheState *state = self->state;
+		const Vector<String> &own_paths = state->thread_paths[self->index];
+
+		for (int i = 0; i < ConcurrentCacheState::ITERATIONS; i++) {
+			// A previous resource with this path may still be kept alive by another thread that looked it up,
+			// in which case the path can't be taken yet. Once it's not found, it can't come back, only this thread sets it.
+			const String &path = own_paths[i % own_paths.size()];
+			Ref<Resource> resource;
+			if (ResourceCache::get_ref(path).is_null()) {
+				resource.instantiate();
+				resource->set_path(path);
+				if (ResourceCache::get_ref(path) != resource) {
+					state->errors.increment();
+				}
+			}
+
+			Ref<Resource> shared;
+			if (self->index == 0) {
+				if (ResourceCache::get_ref(state->shared_path).is_null()) {
+					shared.instantiate();
+					shared->set_path(state->shared_path);
+				}
+			} else {
+				Ref<Resource> found = ResourceCache::get_ref(state->shared_path);
+				if (found.is_valid() && found->get_path() != state->shared_path) {
+					state->errors.increment();
+				}
+			}
+
+			// Other threads' resources may be alive, dying or gone, but never be found under the wrong path.
+			const Vector<String> &other_paths = state->thread_paths[(self->index + 1) % ConcurrentCacheState::THREAD_COUNT];
+			const String &other_path = other_paths[i % other_paths.size()];
+			Ref<Resource> other = ResourceCache::get_ref(other_path);
+			if (other.is_valid() && other->get_path() != other_path) {
+				state->errors.increment();
+			}
+			// Destroyed at the end of the iteration, while the other threads keep using the cache.
+		}
+	}
+};
+
+TEST_CASE("[Resource] Concurrent cache access") {
+	ConcurrentCacheState state;
+	const int initial_count = ResourceCache::get_cached_resource_count();
+
+	// The cache picks shards from the path hash, so paths with equal low hash bits share one.
+	const uint32_t shard_mask = 31;
+	const uint32_t colliding_bits = String("res://concurrent_cache_0_0.tres").hash() & shard_mask;
+	for (int t = 0; t < ConcurrentCacheState::THREAD_COUNT; t++) {
+		const bool colliding = t % 2 == 0;
+		for (int candidate = 0; state.thread_paths[t].size() < ConcurrentCacheState::PATHS_PER_THREAD; candidate++) {
+			const String path = vformat("res://concurrent_cache_%d_%d.tres", t, candidate);
+			if (!colliding || (path.hash() & shard_mask) == colliding_bits) {
+				state.thread_paths[t].push_back(path);
+			}
+		}
+	}
+	state.shared_path = "res://concurrent_cache_shared.tres";
+
+	ConcurrentCacheThread thread_data[ConcurrentCacheState::THREAD_COUNT];
+	Thread threads[ConcurrentCacheState::THREAD_COUNT];
+	for (int t = 0; t < ConcurrentCacheState::THREAD_COUNT; t++) {
+		thread_data[t].state = &state;
+		thread_data[t].index = t;
+		threads[t].start(&ConcurrentCacheThread::thread_func, &thread_data[t]);
+	}
+	for (int t = 0; t < ConcurrentCacheState::THREAD_COUNT; t++) {
+		threads[t].wait_to_finish();
+	}
+
+	CHECK(state.errors.get() == 0);
+	for (int t = 0; t < ConcurrentCacheState::THREAD_COUNT; t++) {
+		for (const String &path : state.thread_paths[t]) {
+			CHECK_FALSE(ResourceCache::has(path));
+		}
+	}
+	CHECK_FALSE(ResourceCache::has(state.shared_path));
+	CHECK_MESSAGE(ResourceCache::get_cached_resource_count() == initial_count, "All resources should have left the cache when freed.");
+}
+
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
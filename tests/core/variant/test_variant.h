@@ -126,6 +126,42 @@ TEST_CASE("[Variant] Writer and parser Variant::FLOAT") {
 	CHECK_MESSAGE(float_parsed == 1.0e+100, "Should match the double literal.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays") {
+	String errs;
+	int line = 1;
+	Variant parsed;
+
+	VariantParser::StreamString ss;
+	ss.s = "PackedFloat32Array(1, -2.5,\n\t3e2 , inf, -0.125e-1 ; comment\n, nan)";
+	CHECK(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	REQUIRE(parsed.get_type() == Variant::PACKED_FLOAT32_ARRAY);
+	PackedFloat32Array floats = parsed;
+	REQUIRE(floats.size() == 6);
+	CHECK(floats[0] == 1.0f);
+	CHECK(floats[1] == -2.5f);
+	CHECK(floats[2] == 300.0f);
+	CHECK(floats[3] == INFINITY);
+	CHECK(floats[4] == -0.0125f);
+	CHECK(Math::is_nan(floats[5]));
+	CHECK(line == 3);
+
+	VariantParser::StreamString bss;
+	bss.s = "PackedByteArray(0, 1,255,  128)";
+	CHECK(VariantParser::parse(&bss, parsed, errs, line) == OK);
+	CHECK(parsed == Variant(PackedByteArray({ 0, 1, 255, 128 })));
+
+	VariantParser::StreamString ess;
+	ess.s = "PackedInt32Array()";
+	CHECK(VariantParser::parse(&ess, parsed, errs, line) == OK);
+	CHECK(parsed == Variant(PackedInt32Array()));
+
+	VariantParser::StreamString invalid_ss;
+	invalid_ss.s = "PackedInt32Array(1, 2 3)";
+	ERR_PRINT_OFF;
+	CHECK(VariantParser::parse(&invalid_ss, parsed, errs, line) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i,Vec4,Vec4i,Rect2,Rect2i,Trans2d,Trans3d,Color,Call,Plane,Basis,AABB,Quant,Proj,RID,and Object") {
 	Variant int_v = 0;
 	Variant bool_v = true;
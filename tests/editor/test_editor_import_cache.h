@@ -0,0 +1,172 @@
+/**************************************************************************/
+/*  test_editor_import_cache.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_IMPORT_CACHE_H
+#define TEST_EDITOR_IMPORT_CACHE_H
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/os/os.h"
+#include "editor/editor_settings.h"
+#include "editor/import/editor_import_cache.h"
+#include "editor/import/resource_importer_layered_texture.h"
+
+#include "tests/test_macros.h"
+
+namespace TestEditorImportCache {
+
+static void write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+TEST_CASE("[Editor][EditorImportCache] Key stability") {
+	Ref<ResourceImporterLayeredTexture> importer;
+	importer.instantiate();
+
+	const String source = OS::get_singleton()->get_cache_path().path_join("import_cache_source.png");
+	write_file(source, "not really a png");
+
+	List<ResourceImporter::ImportOption> options;
+	importer->get_import_options(source, &options);
+	HashMap<StringName, Variant> params;
+	for (const ResourceImporter::ImportOption &E : options) {
+		params[E.option.name] = E.default_value;
+	}
+
+	const String key = EditorImportCache::get_key(source, importer, options, params);
+	CHECK_FALSE(key.is_empty());
+	CHECK_MESSAGE(EditorImportCache::get_key(source, importer, options, params) == key, "The key should not change between calls.");
+
+	const Variant default_lossy_quality = params["compress/lossy_quality"];
+	params["compress/lossy_quality"] = double(default_lossy_quality) * 0.5;
+	CHECK_MESSAGE(EditorImportCache::get_key(source, importer, options, params) != key, "Import options should be part of the key.");
+	params["compress/lossy_quality"] = default_lossy_quality;
+	CHECK(EditorImportCache::get_key(source, importer, options, params) == key);
+
+	// Project settings that change the output of lossless compression.
+	const char *settings[] = {
+		"rendering/textures/lossless_compression/force_png",
+		"rendering/textures/webp_compression/lossless_compression_factor",
+		"rendering/textures/webp_compression/compression_method",
+	};
+	const Variant values[] = { true, 5, 80 };
+	for (int i = 0; i < 3; i++) {
+		const Variant old_value = GLOBAL_GET(settings[i]);
+		ProjectSettings::get_singleton()->set_setting(settings[i], values[i]);
+		CHECK_MESSAGE(EditorImportCache::get_key(source, importer, options, params) != key, vformat("\"%s\" should be part of the key.", settings[i]));
+		ProjectSettings::get_singleton()->set_setting(settings[i], old_value);
+		CHECK(EditorImportCache::get_key(source, importer, options, params) == key);
+	}
+
+	write_file(source, "not really a png either");
+	CHECK_MESSAGE(EditorImportCache::get_key(source, importer, options, params) != key, "The source contents should be part of the key.");
+
+	DirAccess::remove_absolute(source);
+	CHECK_MESSAGE(EditorImportCache::get_key(source, importer, options, params).is_empty(), "A missing source should have no key.");
+}
+
+TEST_CASE("[Editor][EditorImportCache] Store and restore") {
+	const String cache_path = OS::get_singleton()->get_cache_path().path_join("import_cache_test");
+	EditorSettings::get_singleton()->set("filesystem/import/shared_cache_path", cache_path);
+	REQUIRE(EditorImportCache::is_enabled());
+
+	Ref<ResourceImporterLayeredTexture> importer;
+	importer.instantiate();
+
+	const String base_path = OS::get_singleton()->get_cache_path().path_join("import_cache_output");
+	const String extension = importer->get_save_extension();
+	List<String> variants;
+	variants.push_back("s3tc");
+	variants.push_back("etc2");
+	for (const String &E : variants) {
+		write_file(base_path + "." + E + "." + extension, "data for " + E);
+	}
+	Dictionary metadata;
+	metadata["vram_texture"] = true;
+
+	const String key = String("round trip").sha256_text();
+	EditorImportCache::store(key, importer, base_path, variants, metadata);
+	for (const String &E : variants) {
+		DirAccess::remove_absolute(base_path + "." + E + "." + extension);
+	}
+
+	List<String> restored_variants;
+	Variant restored_metadata;
+	CHECK(EditorImportCache::restore(key, base_path, &restored_variants, &restored_metadata));
+	CHECK(restored_variants.size() == 2);
+	CHECK(restored_variants.front()->get() == "s3tc");
+	CHECK(restored_variants.back()->get() == "etc2");
+	CHECK(restored_metadata == Variant(metadata));
+	for (const String &E : variants) {
+		const String path = base_path + "." + E + "." + extension;
+		CHECK(FileAccess::get_file_as_string(path) == "data for " + E);
+		DirAccess::remove_absolute(path);
+	}
+
+	// Storing again under the same key keeps the first entry.
+	write_file(base_path + "." + extension, "unrelated");
+	EditorImportCache::store(key, importer, base_path, List<String>(), Variant());
+	DirAccess::remove_absolute(base_path + "." + extension);
+	restored_variants.clear();
+	CHECK(EditorImportCache::restore(key, base_path, &restored_variants, &restored_metadata));
+	CHECK(restored_variants.size() == 2);
+	for (const String &E : variants) {
+		DirAccess::remove_absolute(base_path + "." + E + "." + extension);
+	}
+
+	restored_variants.clear();
+	CHECK_FALSE(EditorImportCache::restore(String("missing").sha256_text(), base_path, &restored_variants, &restored_metadata));
+	CHECK(restored_variants.is_empty());
+
+	// Damaged entries are rejected and removed.
+	const String entry_dir = cache_path.path_join(key.substr(0, 2)).path_join(key);
+	write_file(entry_dir.path_join("data.etc2." + extension), "damaged data");
+	ERR_PRINT_OFF;
+	CHECK_FALSE(EditorImportCache::restore(key, base_path, &restored_variants, &restored_metadata));
+	ERR_PRINT_ON;
+	CHECK(restored_variants.is_empty());
+	CHECK_FALSE(DirAccess::exists(entry_dir));
+	for (const String &E : variants) {
+		DirAccess::remove_absolute(base_path + "." + E + "." + extension);
+	}
+
+	Ref<DirAccess> da = DirAccess::open(cache_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(cache_path);
+	}
+	EditorSettings::get_singleton()->set("filesystem/import/shared_cache_path", "");
+}
+
+} // namespace TestEditorImportCache
+
+#endif // TEST_EDITOR_IMPORT_CACHE_H
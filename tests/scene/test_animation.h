@@ -309,6 +309,70 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Sample compressed tracks") {
+	Ref<Animation> animation = memnew(Animation);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Enemy:position"));
+	animation->position_track_insert_key(position_track, 0.0, Vector3(0, 1, 2));
+	animation->position_track_insert_key(position_track, 0.5, Vector3(3.5, 4, 5));
+	const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(rotation_track, NodePath("Enemy:rotation"));
+	animation->rotation_track_insert_key(rotation_track, 0.0, Quaternion(Vector3(0, 1, 0), 0.1));
+	animation->rotation_track_insert_key(rotation_track, 0.5, Quaternion(Vector3(0, 1, 0), 0.3));
+	const int blend_shape_track = animation->add_track(Animation::TYPE_BLEND_SHAPE);
+	animation->track_set_path(blend_shape_track, NodePath("Enemy:blend"));
+	animation->blend_shape_track_insert_key(blend_shape_track, 0.0, -1.0);
+	animation->blend_shape_track_insert_key(blend_shape_track, 0.5, 1.0);
+	animation->add_track(Animation::TYPE_VALUE);
+
+	CHECK(!animation->is_compressed());
+	animation->compress();
+	CHECK(animation->is_compressed());
+
+	Animation::SampledPose pose;
+	for (double time : { 0.0, 0.1, 0.25, 0.45, 0.5, 0.75 }) {
+		animation->sample_compressed_tracks(time, pose);
+		REQUIRE(pose.valid.size() == 4);
+		CHECK(pose.valid[position_track]);
+		CHECK(pose.valid[rotation_track]);
+		CHECK(pose.valid[blend_shape_track]);
+		CHECK(!pose.valid[3]);
+
+		Vector3 position = animation->position_track_interpolate(position_track, time);
+		CHECK(Vector3(pose.x[position_track], pose.y[position_track], pose.z[position_track]).is_equal_approx(position));
+		Quaternion rotation = animation->rotation_track_interpolate(rotation_track, time);
+		Quaternion sampled_rotation = Quaternion(pose.x[rotation_track], pose.y[rotation_track], pose.z[rotation_track], pose.w[rotation_track]);
+		CHECK(Math::abs(sampled_rotation.dot(rotation)) == doctest::Approx(1.0));
+		CHECK(pose.x[blend_shape_track] == doctest::Approx(animation->blend_shape_track_interpolate(blend_shape_track, time)));
+	}
+}
+
+TEST_CASE("[Animation] Sample uncompressed tracks") {
+	Ref<Animation> animation = memnew(Animation);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Enemy:position"));
+	animation->position_track_insert_key(position_track, 0.0, Vector3(0, 1, 2));
+	animation->position_track_insert_key(position_track, 0.5, Vector3(3.5, 4, 5));
+	const int scale_track = animation->add_track(Animation::TYPE_SCALE_3D);
+	animation->track_set_path(scale_track, NodePath("Enemy:scale"));
+	animation->scale_track_insert_key(scale_track, 0.0, Vector3(1, 1, 1));
+	animation->scale_track_insert_key(scale_track, 0.5, Vector3(2, 3, 4));
+	const int empty_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(empty_track, NodePath("Enemy:rotation"));
+
+	Animation::SampledPose pose;
+	for (double time : { 0.0, 0.2, 0.5 }) {
+		animation->sample_tracks(time, pose);
+		REQUIRE(pose.valid.size() == 3);
+		CHECK(pose.valid[position_track]);
+		CHECK(pose.valid[scale_track]);
+		CHECK(!pose.valid[empty_track]); // No keys to interpolate.
+
+		CHECK(Vector3(pose.x[position_track], pose.y[position_track], pose.z[position_track]).is_equal_approx(animation->position_track_interpolate(position_track, time)));
+		CHECK(Vector3(pose.x[scale_track], pose.y[scale_track], pose.z[scale_track]).is_equal_approx(animation->scale_track_interpolate(scale_track, time)));
+	}
+}
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
@@ -0,0 +1,338 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/animation/animation_mixer.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+class LODTestMixer : public AnimationMixer {
+	GDCLASS(LODTestMixer, AnimationMixer);
+
+public:
+	bool skip_frame(double p_delta, double &r_delta) {
+		return _lod_skip_frame(p_delta, r_delta);
+	}
+
+	static uint32_t get_current_skipped_count() {
+		return lod_stats_skipped[0].get();
+	}
+};
+
+class PoseCacheTestMixer : public AnimationMixer {
+	GDCLASS(PoseCacheTestMixer, AnimationMixer);
+
+public:
+	const Animation::SampledPose *sample(const Ref<Animation> &p_animation, double p_time) {
+		return _sample_cached_pose(p_animation, p_time);
+	}
+
+	// Makes the cache behave as if its entries were sampled during the previous frame.
+	static void begin_frame() {
+		pose_cache_frame = Engine::get_singleton()->get_process_frames() - 1;
+	}
+
+	static uint32_t get_current_hit_count() {
+		return pose_cache_hits[0];
+	}
+
+	static uint32_t get_current_miss_count() {
+		return pose_cache_misses[0];
+	}
+
+	static uint32_t get_cached_pose_count() {
+		return pose_cache.size();
+	}
+};
+
+TEST_CASE("[AnimationMixer] LOD disabled never skips") {
+	LODTestMixer *mixer = memnew(LODTestMixer);
+
+	for (int i = 0; i < 8; i++) {
+		double delta = 0.0;
+		CHECK_FALSE(mixer->skip_frame(0.1, delta));
+		CHECK(delta == doctest::Approx(0.1));
+	}
+	CHECK(mixer->get_lod_update_interval() == 1);
+
+	memdelete(mixer);
+}
+
+TEST_CASE("[AnimationMixer] LOD priority skips frames and accumulates delta") {
+	LODTestMixer *mixer = memnew(LODTestMixer);
+	mixer->set_lod_mode(AnimationMixer::ANIMATION_LOD_MODE_PRIORITY);
+	mixer->set_lod_max_update_interval(4);
+	mixer->set_lod_interpolate(false);
+
+	SUBCASE("Highest priority updates every frame") {
+		mixer->set_lod_priority(1.0);
+		for (int i = 0; i < 8; i++) {
+			double delta = 0.0;
+			CHECK_FALSE(mixer->skip_frame(0.1, delta));
+			CHECK(delta == doctest::Approx(0.1));
+		}
+		CHECK(mixer->get_lod_update_interval() == 1);
+	}
+
+	SUBCASE("Lowest priority updates at the maximum interval") {
+		mixer->set_lod_priority(0.0);
+		const uint32_t skipped_before = LODTestMixer::get_current_skipped_count();
+
+		int processed = 0;
+		for (int i = 0; i < 12; i++) {
+			double delta = 0.0;
+			if (!mixer->skip_frame(0.1, delta)) {
+				processed++;
+				// The first update only sees its own frame, later ones the whole interval.
+				CHECK(delta == doctest::Approx(i == 0 ? 0.1 : 0.4));
+			}
+		}
+		CHECK(mixer->get_lod_update_interval() == 4);
+		CHECK(processed == 3);
+		CHECK(LODTestMixer::get_current_skipped_count() - skipped_before == 9);
+	}
+
+	SUBCASE("Halfway priority rounds the interval") {
+		mixer->set_lod_priority(0.5);
+		double delta = 0.0;
+		CHECK_FALSE(mixer->skip_frame(0.1, delta));
+		// 1 + round(0.5 * 3) = 3.
+		CHECK(mixer->get_lod_update_interval() == 3);
+		CHECK(mixer->skip_frame(0.1, delta));
+		CHECK(mixer->skip_frame(0.1, delta));
+		CHECK_FALSE(mixer->skip_frame(0.1, delta));
+		CHECK(delta == doctest::Approx(0.3));
+	}
+
+	memdelete(mixer);
+}
+
+TEST_CASE("[AnimationMixer] Changing LOD mode resets the pending delta") {
+	LODTestMixer *mixer = memnew(LODTestMixer);
+	mixer->set_lod_mode(AnimationMixer::ANIMATION_LOD_MODE_PRIORITY);
+	mixer->set_lod_max_update_interval(4);
+	mixer->set_lod_priority(0.0);
+
+	double delta = 0.0;
+	CHECK_FALSE(mixer->skip_frame(0.1, delta));
+	CHECK(mixer->skip_frame(0.1, delta));
+	CHECK(mixer->skip_frame(0.1, delta));
+
+	// Delta accumulated while skipping must not leak into the first update after a mode change.
+	mixer->set_lod_mode(AnimationMixer::ANIMATION_LOD_MODE_DISABLED);
+	CHECK_FALSE(mixer->skip_frame(0.1, delta));
+	CHECK(delta == doctest::Approx(0.1));
+
+	mixer->set_lod_mode(AnimationMixer::ANIMATION_LOD_MODE_PRIORITY);
+	CHECK_FALSE(mixer->skip_frame(0.1, delta));
+	CHECK(delta == doctest::Approx(0.1));
+
+	memdelete(mixer);
+}
+
+// Plays animations moving a node on several players, and returns the transform of every node after each frame.
+static Vector<Transform3D> process_players(bool p_threaded) {
+	const bool was_threaded = AnimationMixer::is_threaded_blending_enabled();
+	AnimationMixer::set_threaded_blending_enabled(p_threaded);
+
+	const int player_count = 4;
+	Vector<Node3D *> scenes;
+	Vector<Node3D *> targets;
+	Vector<AnimationPlayer *> players;
+	for (int i = 0; i < player_count; i++) {
+		Node3D *scene = memnew(Node3D);
+		SceneTree::get_singleton()->get_root()->add_child(scene);
+		Node3D *target = memnew(Node3D);
+		target->set_name("target");
+		scene->add_child(target);
+		AnimationPlayer *player = memnew(AnimationPlayer);
+		scene->add_child(player);
+
+		Ref<AnimationLibrary> library;
+		library.instantiate();
+		for (int a = 0; a < 2; a++) {
+			Ref<Animation> animation;
+			animation.instantiate();
+			animation->set_length(1.0);
+			animation->set_loop_mode(Animation::LOOP_LINEAR);
+			int track = animation->add_track(Animation::TYPE_POSITION_3D);
+			animation->track_set_path(track, NodePath("target"));
+			animation->position_track_insert_key(track, 0.0, Vector3(i, 0, a));
+			animation->position_track_insert_key(track, 0.7, Vector3(0, i + 1, a * 2));
+			track = animation->add_track(Animation::TYPE_ROTATION_3D);
+			animation->track_set_path(track, NodePath("target"));
+			animation->rotation_track_insert_key(track, 0.0, Quaternion());
+			animation->rotation_track_insert_key(track, 1.0, Quaternion(Vector3(0, 1, 0), 1.0 + i + a));
+			track = animation->add_track(Animation::TYPE_VALUE);
+			animation->track_set_path(track, NodePath("target:scale"));
+			animation->track_insert_key(track, 0.0, Vector3(1, 1, 1));
+			animation->track_insert_key(track, 0.5, Vector3(1 + i, 2, 1 + a));
+			library->add_animation(a ? "b" : "a", animation);
+		}
+		player->add_animation_library("", library);
+		player->set_default_blend_time(0.35);
+		player->play("a");
+
+		scenes.push_back(scene);
+		targets.push_back(target);
+		players.push_back(player);
+	}
+
+	Vector<Transform3D> transforms;
+	for (int frame = 0; frame < 12; frame++) {
+		if (frame == 4) {
+			// Blends from one animation to the other over the next frames.
+			for (AnimationPlayer *player : players) {
+				player->play("b");
+			}
+		}
+		SceneTree::get_singleton()->process(0.1);
+		for (const Node3D *target : targets) {
+			transforms.push_back(target->get_transform());
+		}
+	}
+
+	for (Node3D *scene : scenes) {
+		memdelete(scene);
+	}
+	AnimationMixer::set_threaded_blending_enabled(was_threaded);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Threaded blending matches serial blending") {
+	const Vector<Transform3D> serial = process_players(false);
+	const Vector<Transform3D> threaded = process_players(true);
+
+	REQUIRE(serial.size() == threaded.size());
+	bool animated = false;
+	for (int i = 0; i < serial.size(); i++) {
+		CHECK_MESSAGE(threaded[i] == serial[i], vformat("Transform %d differs between threaded and serial blending.", i));
+		animated = animated || serial[i] != Transform3D();
+	}
+	CHECK_MESSAGE(animated, "The players should have moved their nodes.");
+}
+
+static Ref<Animation> create_pose_cache_animation() {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track, NodePath("target"));
+	animation->position_track_insert_key(track, 0.0, Vector3());
+	animation->position_track_insert_key(track, 1.0, Vector3(1, 2, 3));
+	return animation;
+}
+
+TEST_CASE("[AnimationMixer] Pose cache is keyed on the animation and the time") {
+	const bool was_enabled = AnimationMixer::is_pose_cache_enabled();
+	const int saved_fps = AnimationMixer::get_pose_cache_fps();
+	AnimationMixer::set_pose_cache_enabled(true);
+	AnimationMixer::set_pose_cache_fps(10);
+
+	PoseCacheTestMixer *mixer = memnew(PoseCacheTestMixer);
+	Ref<Animation> animation = create_pose_cache_animation();
+	// Same tracks and keys, but another resource.
+	Ref<Animation> other_animation = create_pose_cache_animation();
+
+	PoseCacheTestMixer::begin_frame();
+	mixer->sample(animation, 0.5);
+	CHECK(PoseCacheTestMixer::get_current_miss_count() == 1);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 0);
+
+	// Times rounding to the same step share the pose, which is sampled at the step.
+	const Animation::SampledPose *pose = mixer->sample(animation, 0.53);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 1);
+	REQUIRE(pose != nullptr);
+	REQUIRE(pose->x.size() == 1);
+	CHECK(pose->valid[0]);
+	CHECK(pose->x[0] == doctest::Approx(0.5));
+	CHECK(pose->y[0] == doctest::Approx(1.0));
+	CHECK(pose->z[0] == doctest::Approx(1.5));
+
+	mixer->sample(animation, 0.6);
+	CHECK(PoseCacheTestMixer::get_current_miss_count() == 2);
+	mixer->sample(other_animation, 0.5);
+	CHECK(PoseCacheTestMixer::get_current_miss_count() == 3);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 1);
+	CHECK(PoseCacheTestMixer::get_cached_pose_count() == 3);
+
+	// Blend weights and track filters are applied after sampling, so the same pose is returned to every mixer.
+	PoseCacheTestMixer *other_mixer = memnew(PoseCacheTestMixer);
+	other_mixer->set_deterministic(!mixer->is_deterministic());
+	const Animation::SampledPose *other_pose = other_mixer->sample(animation, 0.6);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 2);
+	CHECK(other_pose->x[0] == doctest::Approx(0.6));
+
+	memdelete(other_mixer);
+	memdelete(mixer);
+	AnimationMixer::set_pose_cache_fps(saved_fps);
+	AnimationMixer::set_pose_cache_enabled(was_enabled);
+}
+
+TEST_CASE("[AnimationMixer] Pose cache is cleared every frame") {
+	const bool was_enabled = AnimationMixer::is_pose_cache_enabled();
+	AnimationMixer::set_pose_cache_enabled(true);
+
+	PoseCacheTestMixer *mixer = memnew(PoseCacheTestMixer);
+	Ref<Animation> animation = create_pose_cache_animation();
+
+	PoseCacheTestMixer::begin_frame();
+	mixer->sample(animation, 0.25);
+	mixer->sample(animation, 0.25);
+	mixer->sample(animation, 0.75);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 1);
+	CHECK(PoseCacheTestMixer::get_current_miss_count() == 2);
+	CHECK(PoseCacheTestMixer::get_cached_pose_count() == 2);
+
+	// The animation could have been edited in between, so nothing is reused in the next frame.
+	PoseCacheTestMixer::begin_frame();
+	mixer->sample(animation, 0.25);
+	CHECK(PoseCacheTestMixer::get_current_hit_count() == 0);
+	CHECK(PoseCacheTestMixer::get_current_miss_count() == 1);
+	CHECK(PoseCacheTestMixer::get_cached_pose_count() == 1);
+
+	// The monitors report the last complete frame.
+	CHECK(AnimationMixer::get_pose_cache_hit_count() == 1);
+	CHECK(AnimationMixer::get_pose_cache_miss_count() == 2);
+
+	memdelete(mixer);
+	AnimationMixer::set_pose_cache_enabled(was_enabled);
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  test_skeleton_3d.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SKELETON_3D_H
+#define TEST_SKELETON_3D_H
+
+#include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSkeleton3D {
+
+TEST_CASE("[Skeleton3D] Global pose propagation") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+
+	// Children are added before their parents, so bone indices don't follow the hierarchy.
+	skeleton->add_bone("leaf");
+	skeleton->add_bone("root");
+	skeleton->add_bone("mid");
+	skeleton->add_bone("other");
+	skeleton->set_bone_parent(0, 2);
+	skeleton->set_bone_parent(2, 1);
+	skeleton->set_bone_parent(3, 1);
+
+	skeleton->set_bone_rest(1, Transform3D(Basis(), Vector3(1, 0, 0)));
+	skeleton->set_bone_rest(2, Transform3D(Basis(), Vector3(0, 1, 0)));
+	skeleton->set_bone_rest(0, Transform3D(Basis(), Vector3(0, 0, 1)));
+	skeleton->set_bone_rest(3, Transform3D(Basis(), Vector3(0, 2, 0)));
+	skeleton->reset_bone_poses();
+
+	SUBCASE("Global rests and poses follow the hierarchy") {
+		CHECK(skeleton->get_bone_global_rest(0).origin.is_equal_approx(Vector3(1, 1, 1)));
+		CHECK(skeleton->get_bone_global_rest(3).origin.is_equal_approx(Vector3(1, 2, 0)));
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 1, 1)));
+		CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(1, 1, 0)));
+		CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(1, 2, 0)));
+	}
+
+	SUBCASE("Disabled bones use their rest") {
+		skeleton->set_bone_pose_position(2, Vector3(0, 5, 0));
+		skeleton->set_bone_enabled(2, false);
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 1, 1)));
+		skeleton->set_bone_enabled(2, true);
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 5, 1)));
+	}
+
+	SUBCASE("Updating the children of a bone only updates its descendants") {
+		// Outside of the tree, changing a pose doesn't trigger an update by itself.
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 1, 1)));
+		skeleton->set_bone_pose_position(2, Vector3(0, 3, 0));
+		skeleton->set_bone_pose_position(3, Vector3(0, 4, 0));
+		skeleton->force_update_bone_children_transforms(2);
+		CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(1, 3, 0)));
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 3, 1)));
+		CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(1, 2, 0)));
+	}
+
+	SUBCASE("Global pose overrides are propagated to the children") {
+		skeleton->set_bone_global_pose_override(2, Transform3D(Basis(), Vector3(0, 0, 0)), 1.0, true);
+		skeleton->force_update_all_bone_transforms();
+		CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(0, 0, 0)));
+		CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(0, 0, 1)));
+		CHECK(skeleton->get_bone_global_pose_no_override(0).origin.is_equal_approx(Vector3(1, 1, 1)));
+	}
+
+	SUBCASE("Pose changes are signaled breadth-first") {
+		SIGNAL_WATCH(skeleton, "bone_pose_changed");
+		skeleton->force_update_all_bone_transforms();
+
+		Array args;
+		for (int bone : { 1, 2, 3, 0 }) {
+			Array arg;
+			arg.push_back(bone);
+			args.push_back(arg);
+		}
+		SIGNAL_CHECK("bone_pose_changed", args);
+
+		SIGNAL_UNWATCH(skeleton, "bone_pose_changed");
+	}
+
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Threaded updates queue each skeleton once") {
+	const bool was_threaded = Skeleton3D::is_threaded_update_enabled();
+	Skeleton3D::set_threaded_update_enabled(true);
+	Skeleton3D::flush_threaded_updates();
+
+	Skeleton3D *skeletons[2];
+	for (Skeleton3D *&skeleton : skeletons) {
+		skeleton = memnew(Skeleton3D);
+		skeleton->add_bone("root");
+		skeleton->add_bone("child");
+		skeleton->set_bone_parent(1, 0);
+		skeleton->set_bone_rest(1, Transform3D(Basis(), Vector3(0, 1, 0)));
+		skeleton->reset_bone_poses();
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	}
+	Skeleton3D::flush_threaded_updates();
+	CHECK(Skeleton3D::get_threaded_update_queue_size() == 0);
+
+	// Dirty, then updated synchronously by a getter, then dirty again in the same frame.
+	skeletons[0]->set_bone_pose_position(0, Vector3(1, 0, 0));
+	skeletons[1]->set_bone_pose_position(0, Vector3(2, 0, 0));
+	CHECK(Skeleton3D::get_threaded_update_queue_size() == 2);
+	CHECK(skeletons[0]->get_bone_global_pose(1).origin.is_equal_approx(Vector3(1, 1, 0)));
+	skeletons[0]->set_bone_pose_position(0, Vector3(3, 0, 0));
+	CHECK_MESSAGE(Skeleton3D::get_threaded_update_queue_size() == 2, "A skeleton updated synchronously must not be queued twice.");
+
+	Skeleton3D::flush_threaded_updates();
+	CHECK(Skeleton3D::get_threaded_update_queue_size() == 0);
+	CHECK(skeletons[0]->get_bone_global_pose(1).origin.is_equal_approx(Vector3(3, 1, 0)));
+	CHECK(skeletons[1]->get_bone_global_pose(1).origin.is_equal_approx(Vector3(2, 1, 0)));
+
+	// Flushing leaves the skeletons ready to be queued again.
+	skeletons[1]->set_bone_pose_position(0, Vector3(4, 0, 0));
+	CHECK(Skeleton3D::get_threaded_update_queue_size() == 1);
+	Skeleton3D::flush_threaded_updates();
+	CHECK(skeletons[1]->get_bone_global_pose(1).origin.is_equal_approx(Vector3(4, 1, 0)));
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+	Skeleton3D::set_threaded_update_enabled(was_threaded);
+}
+
+} // namespace TestSkeleton3D
+
+#endif // TEST_SKELETON_3D_H
@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*  test_pipeline_cache_rd.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PIPELINE_CACHE_RD_H
+#define TEST_PIPELINE_CACHE_RD_H
+
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPipelineCacheRD {
+
+PipelineCacheRD::VariantMap create_test_variants() {
+	PipelineCacheRD::VariantMap variants;
+
+	PipelineCacheRD::VariantDescription mesh_variant;
+	mesh_variant.uses_vertex_format = true;
+	RD::VertexAttribute attribute;
+	attribute.location = 1;
+	attribute.offset = 12;
+	attribute.format = RD::DATA_FORMAT_R32G32B32_SFLOAT;
+	attribute.stride = 24;
+	attribute.frequency = RD::VERTEX_FREQUENCY_INSTANCE;
+	mesh_variant.vertex_attributes.push_back(attribute);
+	RD::AttachmentFormat attachment;
+	attachment.format = RD::DATA_FORMAT_R16G16B16A16_SFLOAT;
+	attachment.samples = RD::TEXTURE_SAMPLES_4;
+	attachment.usage_flags = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT;
+	mesh_variant.attachments.push_back(attachment);
+	RD::FramebufferPass pass;
+	pass.color_attachments.push_back(0);
+	pass.resolve_attachments.push_back(RD::ATTACHMENT_UNUSED);
+	pass.depth_attachment = 1;
+	mesh_variant.passes.push_back(pass);
+	mesh_variant.view_count = 2;
+	mesh_variant.wireframe = true;
+	mesh_variant.render_pass = 1;
+	mesh_variant.bool_specializations = 5;
+	variants[0x123456789abcdef0].push_back(mesh_variant);
+
+	PipelineCacheRD::VariantDescription empty_variant;
+	empty_variant.empty_samples = RD::TEXTURE_SAMPLES_8;
+	variants[0x123456789abcdef0].push_back(empty_variant);
+	variants[42].push_back(empty_variant);
+
+	return variants;
+}
+
+TEST_CASE("[PipelineCacheRD] Captured variants survive a save and load round trip") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_pipeline_variants.bin");
+	const PipelineCacheRD::VariantMap variants = create_test_variants();
+	REQUIRE(PipelineCacheRD::save_variants(path, "Vulkan", variants) == OK);
+
+	String api_name;
+	PipelineCacheRD::VariantMap loaded;
+	REQUIRE(PipelineCacheRD::load_variants(path, api_name, loaded) == OK);
+	CHECK(api_name == "Vulkan");
+	REQUIRE(loaded.size() == 2);
+	REQUIRE(loaded.has(42));
+	CHECK(loaded[42].size() == 1);
+	CHECK(loaded[42][0].empty_samples == RD::TEXTURE_SAMPLES_8);
+	CHECK(loaded[42][0].attachments.is_empty());
+	REQUIRE(loaded.has(0x123456789abcdef0));
+	REQUIRE(loaded[0x123456789abcdef0].size() == 2);
+
+	const PipelineCacheRD::VariantDescription &expected = variants[0x123456789abcdef0][0];
+	const PipelineCacheRD::VariantDescription &variant = loaded[0x123456789abcdef0][0];
+	CHECK(variant.uses_vertex_format);
+	CHECK(variant.wireframe);
+	CHECK(variant.render_pass == expected.render_pass);
+	CHECK(variant.bool_specializations == expected.bool_specializations);
+	CHECK(variant.view_count == expected.view_count);
+	REQUIRE(variant.vertex_attributes.size() == 1);
+	CHECK(variant.vertex_attributes[0].location == expected.vertex_attributes[0].location);
+	CHECK(variant.vertex_attributes[0].offset == expected.vertex_attributes[0].offset);
+	CHECK(variant.vertex_attributes[0].format == expected.vertex_attributes[0].format);
+	CHECK(variant.vertex_attributes[0].stride == expected.vertex_attributes[0].stride);
+	CHECK(variant.vertex_attributes[0].frequency == expected.vertex_attributes[0].frequency);
+	REQUIRE(variant.attachments.size() == 1);
+	CHECK(variant.attachments[0].format == expected.attachments[0].format);
+	CHECK(variant.attachments[0].samples == expected.attachments[0].samples);
+	CHECK(variant.attachments[0].usage_flags == expected.attachments[0].usage_flags);
+	REQUIRE(variant.passes.size() == 1);
+	CHECK(variant.passes[0].color_attachments == expected.passes[0].color_attachments);
+	CHECK(variant.passes[0].input_attachments.is_empty());
+	CHECK(variant.passes[0].resolve_attachments == expected.passes[0].resolve_attachments);
+	CHECK(variant.passes[0].preserve_attachments.is_empty());
+	CHECK(variant.passes[0].depth_attachment == expected.passes[0].depth_attachment);
+	CHECK(variant.passes[0].vrs_attachment == expected.passes[0].vrs_attachment);
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[PipelineCacheRD] Truncated or corrupt variants files are rejected") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_pipeline_variants.bin");
+	REQUIRE(PipelineCacheRD::save_variants(path, "Vulkan", create_test_variants()) == OK);
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(path);
+	REQUIRE(data.size() > 0);
+
+	SUBCASE("Truncated file") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		f->store_buffer(data.ptr(), data.size() - 6);
+	}
+
+	SUBCASE("Huge element count") {
+		// The first key's variant count follows the header: magic, version, API name and key count, then the key itself.
+		const int variant_count_offset = 4 + 4 + 4 + String("Vulkan").utf8().length() + 4 + 8;
+		data.write[variant_count_offset + 3] = 0xff;
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	String api_name;
+	PipelineCacheRD::VariantMap loaded;
+	ERR_PRINT_OFF;
+	CHECK(PipelineCacheRD::load_variants(path, api_name, loaded) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(loaded.is_empty());
+
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestPipelineCacheRD
+
+#endif // TEST_PIPELINE_CACHE_RD_H
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "core/config/project_settings.h"
+#include "core/math/random_pcg.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+RID create_canvas_item(RendererCanvasCull *p_canvas_cull, RID p_parent, RandomPCG &p_rng, LocalVector<RID> &r_items) {
+	RID item = p_canvas_cull->canvas_item_allocate();
+	p_canvas_cull->canvas_item_initialize(item);
+	p_canvas_cull->canvas_item_set_parent(item, p_parent);
+	p_canvas_cull->canvas_item_set_transform(item, Transform2D(0, Vector2(p_rng.random(0.0f, 1000.0f), p_rng.random(0.0f, 1000.0f))));
+	p_canvas_cull->canvas_item_set_z_index(item, p_rng.rand(7) - 3);
+	p_canvas_cull->canvas_item_set_z_as_relative_to_parent(item, p_rng.rand(2) == 0);
+	p_canvas_cull->canvas_item_add_rect(item, Rect2(0, 0, 10, 10), Color(1, 1, 1, 1));
+	r_items.push_back(item);
+	return item;
+}
+
+// Builds the same canvas with a given threaded cull threshold, culls it and returns the indices of the items in draw order.
+LocalVector<uint32_t> cull_canvas_draw_order(int p_threaded_cull_minimum_children) {
+	ProjectSettings::get_singleton()->set_setting("rendering/limits/canvas/threaded_cull_minimum_children", p_threaded_cull_minimum_children);
+	RendererCanvasCull *canvas_cull = memnew(RendererCanvasCull);
+
+	RandomPCG rng(1234);
+	RID canvas = canvas_cull->canvas_allocate();
+	canvas_cull->canvas_initialize(canvas);
+	LocalVector<RID> items;
+
+	// Many children directly in the canvas, some of them y-sorting their own children.
+	for (int i = 0; i < 1500; i++) {
+		RID item = create_canvas_item(canvas_cull, canvas, rng, items);
+		if (i % 100 == 0) {
+			canvas_cull->canvas_item_set_sort_children_by_y(item, true);
+			for (int j = 0; j < 5; j++) {
+				create_canvas_item(canvas_cull, item, rng, items);
+			}
+		}
+	}
+
+	// A single item with many children, some drawn behind it.
+	RID parent = create_canvas_item(canvas_cull, canvas, rng, items);
+	for (int i = 0; i < 1500; i++) {
+		RID item = create_canvas_item(canvas_cull, parent, rng, items);
+		canvas_cull->canvas_item_set_draw_behind_parent(item, i % 3 == 0);
+	}
+
+	HashMap<RendererCanvasRender::Item *, uint32_t> indices;
+	for (uint32_t i = 0; i < items.size(); i++) {
+		indices.insert(canvas_cull->canvas_item_owner.get_or_null(items[i]), i);
+	}
+
+	RendererCanvasCull::Canvas *canvas_ptr = canvas_cull->canvas_owner.get_or_null(canvas);
+	canvas_cull->render_canvas(RID(), canvas_ptr, Transform2D(), nullptr, nullptr, Rect2(-100, -100, 1200, 1200), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, false, false, 0xFFFFFFFF);
+
+	// The culled items are linked in draw order, find the first one and follow the list.
+	HashSet<RendererCanvasRender::Item *> linked;
+	for (const KeyValue<RendererCanvasRender::Item *, uint32_t> &E : indices) {
+		if (E.key->next) {
+			linked.insert(E.key->next);
+		}
+	}
+	RendererCanvasRender::Item *first = nullptr;
+	for (const KeyValue<RendererCanvasRender::Item *, uint32_t> &E : indices) {
+		if (!linked.has(E.key)) {
+			CHECK_MESSAGE(first == nullptr, "All items should be culled into a single list.");
+			first = E.key;
+		}
+	}
+
+	LocalVector<uint32_t> order;
+	for (RendererCanvasRender::Item *item = first; item && order.size() <= items.size(); item = item->next) {
+		order.push_back(indices[item]);
+	}
+	CHECK(order.size() == items.size());
+
+	for (const RID &item : items) {
+		canvas_cull->free(item);
+	}
+	canvas_cull->free(canvas);
+	memdelete(canvas_cull);
+
+	return order;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling keeps the serial draw order") {
+	const Variant saved_threshold = ProjectSettings::get_singleton()->get_setting("rendering/limits/canvas/threaded_cull_minimum_children");
+	const LocalVector<uint32_t> serial = cull_canvas_draw_order(INT32_MAX);
+	const LocalVector<uint32_t> threaded = cull_canvas_draw_order(128);
+	ProjectSettings::get_singleton()->set_setting("rendering/limits/canvas/threaded_cull_minimum_children", saved_threshold);
+
+	CHECK_MESSAGE(WorkerThreadPool::get_singleton()->get_thread_count() >= 2, "Culling only runs on threads with more than one worker.");
+	REQUIRE(serial.size() == threaded.size());
+	bool same_order = true;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		if (serial[i] != threaded[i]) {
+			same_order = false;
+			break;
+		}
+	}
+	CHECK(same_order);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,295 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/projection.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+RendererSceneCull::Frustum create_test_frustum() {
+	Projection projection;
+	projection.set_perspective(75, 16.0 / 9.0, 0.05, 500);
+	Transform3D camera_transform;
+	camera_transform.origin = Vector3(0, 0, 10);
+	return RendererSceneCull::Frustum(projection.get_projection_planes(camera_transform));
+}
+
+TEST_CASE("[RendererSceneCull] Batched frustum culling matches per instance culling") {
+	const RendererSceneCull::Frustum frustum = create_test_frustum();
+
+	RandomPCG rng(12345);
+	LocalVector<RendererSceneCull::InstanceBounds> bounds;
+	// Use a count which isn't a multiple of the batch size.
+	for (uint32_t i = 0; i < 1003; i++) {
+		Vector3 position(rng.random(-600.0f, 600.0f), rng.random(-600.0f, 600.0f), rng.random(-600.0f, 600.0f));
+		Vector3 size(rng.random(0.0f, 50.0f), rng.random(0.0f, 50.0f), rng.random(0.0f, 50.0f));
+		bounds.push_back(RendererSceneCull::InstanceBounds(AABB(position, size)));
+	}
+
+	LocalVector<uint32_t> visible;
+	visible.resize(bounds.size());
+	uint32_t visible_count = RendererSceneCull::InstanceBounds::cull_frustum(bounds.ptr(), bounds.size(), frustum, visible.ptr());
+
+	LocalVector<uint32_t> expected;
+	for (uint32_t i = 0; i < bounds.size(); i++) {
+		if (bounds[i].in_frustum(frustum)) {
+			expected.push_back(i);
+		}
+	}
+
+	CHECK(expected.size() > 0);
+	CHECK(expected.size() < bounds.size());
+	REQUIRE(visible_count == expected.size());
+	for (uint32_t i = 0; i < visible_count; i++) {
+		CHECK(visible[i] == expected[i]);
+	}
+
+	// Empty and partial batches.
+	CHECK(RendererSceneCull::InstanceBounds::cull_frustum(bounds.ptr(), 0, frustum, visible.ptr()) == 0);
+	const uint32_t first_count = RendererSceneCull::InstanceBounds::cull_frustum(bounds.ptr(), 3, frustum, visible.ptr());
+	CHECK(first_count == (uint32_t)(bounds[0].in_frustum(frustum) + bounds[1].in_frustum(frustum) + bounds[2].in_frustum(frustum)));
+}
+
+void check_frustum_cull_cache(const RendererSceneCull::Scenario *p_scenario, const RendererSceneCull::FrustumCullCache &p_cache, const RendererSceneCull::Frustum &p_frustum) {
+	LocalVector<uint32_t> expected;
+	for (uint32_t i = 0; i < p_scenario->instance_aabbs.size(); i++) {
+		if (p_scenario->instance_aabbs[i].in_frustum(p_frustum)) {
+			expected.push_back(i);
+		}
+	}
+
+	REQUIRE(p_cache.visible.size() == expected.size());
+	for (uint32_t i = 0; i < expected.size(); i++) {
+		CHECK(p_cache.visible[i] == expected[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Frustum cull cache only retests changed instances") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	REQUIRE(scene_cull != nullptr);
+
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	LocalVector<RID> instances;
+	for (int x = 0; x < 20; x++) {
+		for (int z = 0; z < 100; z++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, Transform3D(Basis(), Vector3((x - 10) * 40.0, 0, z * -4.0)));
+			instances.push_back(instance);
+		}
+	}
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario_ptr = scene_cull->scenario_owner.get_or_null(scenario);
+	REQUIRE(scenario_ptr != nullptr);
+
+	const RendererSceneCull::Frustum frustum = create_test_frustum();
+	RendererSceneCull::FrustumCullCache *cache = &scenario_ptr->frustum_cull_caches.insert(RID::from_uint64(1), RendererSceneCull::FrustumCullCache())->value;
+
+	scene_cull->_update_frustum_cull_cache(scenario_ptr, *cache, frustum);
+	CHECK(cache->visible.size() > 0);
+	CHECK(cache->visible.size() < instances.size());
+	check_frustum_cull_cache(scenario_ptr, *cache, frustum);
+
+	// Move instances in and out of the frustum, remove some (which reorders the arrays) and add new ones.
+	for (uint32_t i = 0; i < instances.size(); i += 7) {
+		rs->instance_set_transform(instances[i], Transform3D(Basis(), Vector3(0, 0, (i % 3) == 0 ? 10000.0 : -20.0)));
+	}
+	for (uint32_t i = 0; i < 100; i++) {
+		rs->free(instances[instances.size() - 1 - i * 3]);
+		instances.remove_at(instances.size() - 1 - i * 3);
+	}
+	for (int i = 0; i < 50; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(0, i, -10.0)));
+		instances.push_back(instance);
+	}
+	scene_cull->update_dirty_instances();
+
+	CHECK(scenario_ptr->instance_bounds_changes.size() > 0);
+	CHECK(cache->planes == frustum.planes);
+	scene_cull->_update_frustum_cull_cache(scenario_ptr, *cache, frustum);
+	check_frustum_cull_cache(scenario_ptr, *cache, frustum);
+
+	// Nothing changed, the cache is kept as is.
+	scene_cull->_update_frustum_cull_cache(scenario_ptr, *cache, frustum);
+	check_frustum_cull_cache(scenario_ptr, *cache, frustum);
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Threaded pair queries match serial pair queries") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	REQUIRE(scene_cull != nullptr);
+
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	RandomPCG rng(4321);
+	LocalVector<RID> instances;
+	for (int i = 0; i < 300; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f))));
+		instances.push_back(instance);
+	}
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario_ptr = scene_cull->scenario_owner.get_or_null(scenario);
+	REQUIRE(scenario_ptr != nullptr);
+
+	// Meshes only pair with lights and volumes, which the dummy renderer can't create,
+	// so query meshes against each other the way lights query them.
+	const uint32_t saved_threshold = scene_cull->threaded_pair_minimum_instances;
+	LocalVector<LocalVector<RendererSceneCull::Instance *>> results[2];
+	for (int pass = 0; pass < 2; pass++) {
+		scene_cull->threaded_pair_minimum_instances = pass == 0 ? UINT32_MAX : 1;
+		scene_cull->pair_queries.resize(instances.size());
+		scene_cull->pair_query_count = instances.size();
+		for (uint32_t i = 0; i < instances.size(); i++) {
+			RendererSceneCull::PairQuery &query = scene_cull->pair_queries[i];
+			query.instance = scene_cull->instance_owner.get_or_null(instances[i]);
+			query.bvh = &scenario_ptr->indexers[RendererSceneCull::Scenario::INDEXER_GEOMETRY];
+			query.bvh2 = nullptr;
+			query.pair_mask = RS::INSTANCE_GEOMETRY_MASK;
+			query.cull_mask = 0xFFFFFFFF;
+		}
+
+		scene_cull->_run_pair_queries();
+
+		for (uint32_t i = 0; i < instances.size(); i++) {
+			RendererSceneCull::PairQuery &query = scene_cull->pair_queries[i];
+			results[pass].push_back(query.found);
+			query.instance = nullptr;
+			query.bvh = nullptr;
+			query.found.clear();
+		}
+		scene_cull->pair_query_count = 0;
+	}
+	scene_cull->threaded_pair_minimum_instances = saved_threshold;
+
+	uint32_t pair_count = 0;
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		REQUIRE(results[0][i].size() == results[1][i].size());
+		for (uint32_t j = 0; j < results[0][i].size(); j++) {
+			CHECK(results[0][i][j] == results[1][i][j]);
+		}
+		pair_count += results[0][i].size();
+	}
+	CHECK_MESSAGE(pair_count > 0, "The instances should overlap.");
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+// Run with `--test --no-skip --test-case="*Benchmark*"`.
+TEST_CASE_PENDING("[SceneTree][RendererSceneCull] Benchmark frustum culling of 1M instances") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	REQUIRE(scene_cull != nullptr);
+
+	// Instances are only added to the scenario arrays by the dummy renderer, nothing is drawn.
+	const int side = 100;
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	LocalVector<RID> instances;
+	for (int x = 0; x < side; x++) {
+		for (int y = 0; y < side; y++) {
+			for (int z = 0; z < side; z++) {
+				RID instance = rs->instance_create2(mesh, scenario);
+				rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+				rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(x - side / 2, y - side / 2, -z) * 4.0));
+				instances.push_back(instance);
+			}
+		}
+	}
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario_ptr = scene_cull->scenario_owner.get_or_null(scenario);
+	REQUIRE(scenario_ptr != nullptr);
+	const PagedArray<RendererSceneCull::InstanceBounds> &aabbs = scenario_ptr->instance_aabbs;
+	const uint64_t count = aabbs.size();
+	CHECK(count == instances.size());
+
+	const RendererSceneCull::Frustum frustum = create_test_frustum();
+	const uint32_t page_size = 1 << scene_cull->instance_aabb_page_pool.get_page_size_shift();
+	LocalVector<uint32_t> visible;
+	visible.resize(page_size);
+	const int iterations = 20;
+
+	uint64_t scalar_visible = 0;
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		for (uint64_t i = 0; i < count; i++) {
+			scalar_visible += aabbs[i].in_frustum(frustum);
+		}
+	}
+	const double scalar_msec = (OS::get_singleton()->get_ticks_usec() - from) / (1000.0 * iterations);
+
+	uint64_t batched_visible = 0;
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		for (uint64_t i = 0; i < count; i += page_size) {
+			const uint32_t batch = MIN((uint64_t)page_size, count - i);
+			batched_visible += RendererSceneCull::InstanceBounds::cull_frustum(&aabbs[i], batch, frustum, visible.ptr());
+		}
+	}
+	const double batched_msec = (OS::get_singleton()->get_ticks_usec() - from) / (1000.0 * iterations);
+
+	CHECK(scalar_visible == batched_visible);
+	print_line(vformat("Frustum culling %d instances (%d visible): %.3f ms one by one, %.3f ms batched.", count, batched_visible / iterations, scalar_msec, batched_msec));
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  test_renderer_scene_occlusion_cull.h                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_OCCLUSION_CULL_H
+#define TEST_RENDERER_SCENE_OCCLUSION_CULL_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull_software.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneOcclusionCull {
+
+// Creating a backend replaces the global occlusion culling singleton, which the rendering server
+// may still be using. This is never instantiated, it only gives the test access to the singleton.
+class OcclusionCullSingletonAccess : public RendererSceneOcclusionCull {
+public:
+	static void set_singleton(RendererSceneOcclusionCull *p_singleton) {
+		singleton = p_singleton;
+	}
+};
+
+bool is_box_occluded(RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const Vector3 end = p_box.get_end();
+	const real_t bounds[6] = { p_box.position.x, p_box.position.y, p_box.position.z, end.x, end.y, end.z };
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near());
+}
+
+TEST_CASE("[RendererSceneOcclusionCull] Software rasterizer fills the depth buffer") {
+	RendererSceneOcclusionCull *previous_singleton = RendererSceneOcclusionCull::get_singleton();
+	RendererSceneOcclusionCullSoftware *occlusion_cull = memnew(RendererSceneOcclusionCullSoftware);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	RID occluder = occlusion_cull->occluder_allocate();
+	occlusion_cull->occluder_initialize(occluder);
+	CHECK(occlusion_cull->is_occluder(occluder));
+
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-1, -1, 0));
+	vertices.push_back(Vector3(1, -1, 0));
+	vertices.push_back(Vector3(1, 1, 0));
+	vertices.push_back(Vector3(-1, 1, 0));
+	PackedInt32Array indices;
+	for (int index : { 0, 1, 2, 0, 2, 3 }) {
+		indices.push_back(index);
+	}
+	occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+
+	occlusion_cull->add_scenario(scenario);
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -5)), true);
+
+	occlusion_cull->add_buffer(buffer);
+	occlusion_cull->buffer_set_scenario(buffer, scenario);
+	occlusion_cull->buffer_set_size(buffer, Vector2i(64, 64));
+
+	SUBCASE("Perspective") {
+		Projection projection;
+		projection.set_perspective(75, 1.0, 0.05, 100);
+		Transform3D camera_transform;
+
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		REQUIRE(hz_buffer);
+
+		CHECK_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box behind the occluder should be occluded.");
+		CHECK_MESSAGE(!is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -0.5, -4), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box in front of the occluder should not be occluded.");
+		CHECK_MESSAGE(!is_box_occluded(hz_buffer, AABB(Vector3(9.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box beside the occluder should not be occluded.");
+
+		// Occluders are double-sided.
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(Vector3(0, 1, 0), Math_PI), Vector3(0, 0, -5)), true);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK(is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+
+		// Occluders crossing the near plane are clipped rather than discarded.
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(Vector3(1, 0, 0), Math_PI * 0.5).scaled(Vector3(20, 20, 20)), Vector3(0, -1, 0)), true);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK(is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -5, -10), Vector3(1, 1, 1)), camera_transform, projection));
+
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -5)), false);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK_MESSAGE(!is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"Disabled occluders should not occlude anything.");
+	}
+
+	SUBCASE("Off-center occluder and non-square buffer") {
+		// Nothing here is mirrored, so flipped axes in the rasterizer or in the occlusion test show up.
+		occlusion_cull->buffer_set_size(buffer, Vector2i(96, 48));
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(2, 1, -5)), true);
+
+		Projection projection;
+		projection.set_perspective(75, 2.0, 0.05, 100);
+		Transform3D camera_transform;
+
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		REQUIRE(hz_buffer);
+
+		CHECK_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(7.5, 3.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box behind the occluder should be occluded.");
+		CHECK_MESSAGE(!is_box_occluded(hz_buffer, AABB(Vector3(-8.5, 3.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box mirrored horizontally should not be occluded.");
+		CHECK_MESSAGE(!is_box_occluded(hz_buffer, AABB(Vector3(7.5, -4.5, -21), Vector3(1, 1, 1)), camera_transform, projection),
+				"A box mirrored vertically should not be occluded.");
+
+		// Moving the camera on both axes lines the occluder up with the view axis.
+		camera_transform.origin = Vector3(2, 1, 0);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK(is_box_occluded(hz_buffer, AABB(Vector3(1.5, 0.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+		CHECK(!is_box_occluded(hz_buffer, AABB(Vector3(-8.5, 0.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+
+		// Turning the camera to the left leaves the occluder behind it.
+		camera_transform = Transform3D(Basis(Vector3(0, 1, 0), Math_PI * 0.5), Vector3());
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK(!is_box_occluded(hz_buffer, AABB(Vector3(7.5, 3.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+		CHECK(!is_box_occluded(hz_buffer, AABB(Vector3(-21, -0.5, -0.5), Vector3(1, 1, 1)), camera_transform, projection));
+	}
+
+	SUBCASE("Orthogonal") {
+		Projection projection;
+		projection.set_orthogonal(10, 1.0, 0.05, 100);
+		Transform3D camera_transform;
+
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, true);
+		RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		REQUIRE(hz_buffer);
+
+		CHECK(is_box_occluded(hz_buffer, AABB(Vector3(-0.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+		CHECK(!is_box_occluded(hz_buffer, AABB(Vector3(2.5, -0.5, -21), Vector3(1, 1, 1)), camera_transform, projection));
+	}
+
+	occlusion_cull->remove_buffer(buffer);
+	occlusion_cull->scenario_remove_instance(scenario, instance);
+	occlusion_cull->remove_scenario(scenario);
+	occlusion_cull->free_occluder(occluder);
+	memdelete(occlusion_cull);
+	OcclusionCullSingletonAccess::set_singleton(previous_singleton);
+}
+
+} // namespace TestRendererSceneOcclusionCull
+
+#endif // TEST_RENDERER_SCENE_OCCLUSION_CULL_H
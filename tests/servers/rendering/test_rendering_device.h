@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  test_rendering_device.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_DEVICE_H
+#define TEST_RENDERING_DEVICE_H
+
+#include "servers/rendering/rendering_device.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingDevice {
+
+RID create_point_shader(RenderingDevice *p_rd) {
+	// Each vertex lights up the pixel of a 4x1 framebuffer matching its index.
+	const String vertex_source = R"(
+#version 450
+void main() {
+	gl_Position = vec4(float(gl_VertexIndex) * 0.5 - 0.75, 0.0, 0.0, 1.0);
+	gl_PointSize = 1.0;
+}
+)";
+	const String fragment_source = R"(
+#version 450
+layout(location = 0) out vec4 frag_color;
+void main() {
+	frag_color = vec4(1.0);
+}
+)";
+
+	Vector<RenderingDevice::ShaderStageSPIRVData> stages;
+	for (const RenderingDevice::ShaderStage stage : { RenderingDevice::SHADER_STAGE_VERTEX, RenderingDevice::SHADER_STAGE_FRAGMENT }) {
+		String error;
+		RenderingDevice::ShaderStageSPIRVData stage_data;
+		stage_data.shader_stage = stage;
+		stage_data.spirv = p_rd->shader_compile_spirv_from_source(stage, stage == RenderingDevice::SHADER_STAGE_VERTEX ? vertex_source : fragment_source, RenderingDevice::SHADER_LANGUAGE_GLSL, &error, false);
+		if (stage_data.spirv.is_empty()) {
+			MESSAGE("Shader compilation failed: ", error);
+			return RID();
+		}
+		stages.push_back(stage_data);
+	}
+	return p_rd->shader_create_from_spirv(stages);
+}
+
+TEST_CASE("[RenderingDevice] Indirect draws read commands with a non-tight stride") {
+	if (RenderingDevice::get_singleton() == nullptr) {
+		MESSAGE("Skipping, no rendering device available.");
+		return;
+	}
+	RenderingDevice *rd = RenderingDevice::get_singleton()->create_local_device();
+	REQUIRE(rd != nullptr);
+
+	RID shader = create_point_shader(rd);
+	REQUIRE(shader.is_valid());
+
+	RenderingDevice::TextureFormat format;
+	format.format = RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM;
+	format.width = 4;
+	format.height = 1;
+	format.usage_bits = RenderingDevice::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT;
+	RID texture = rd->texture_create(format, RenderingDevice::TextureView());
+	Vector<RID> attachments;
+	attachments.push_back(texture);
+	RID framebuffer = rd->framebuffer_create(attachments);
+
+	RenderingDevice::PipelineRasterizationState rasterization_state;
+	RID pipeline = rd->render_pipeline_create(shader, rd->framebuffer_get_format(framebuffer), RenderingDevice::INVALID_ID, RenderingDevice::RENDER_PRIMITIVE_POINTS, rasterization_state, RenderingDevice::PipelineMultisampleState(), RenderingDevice::PipelineDepthStencilState(), RenderingDevice::PipelineColorBlendState::create_disabled());
+	REQUIRE(pipeline.is_valid());
+
+	// Two draw commands (vertex_count, instance_count, first_vertex, first_instance), 32 bytes apart.
+	// The words in between form another valid command, so reading them as tightly packed would light
+	// up pixel 1 instead of pixel 2.
+	const uint32_t commands[16] = {
+		1, 1, 0, 0, 1, 1, 1, 0,
+		1, 1, 2, 0, 1, 1, 3, 0
+	};
+	Vector<uint8_t> command_data;
+	command_data.resize(sizeof(commands));
+	memcpy(command_data.ptrw(), commands, sizeof(commands));
+	RID command_buffer = rd->storage_buffer_create(command_data.size(), command_data, RenderingDevice::STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT);
+
+	Vector<Color> clear_colors;
+	clear_colors.push_back(Color(0, 0, 0, 0));
+	RenderingDevice::DrawListID draw_list = rd->draw_list_begin(framebuffer, RenderingDevice::INITIAL_ACTION_CLEAR, RenderingDevice::FINAL_ACTION_STORE, RenderingDevice::INITIAL_ACTION_DISCARD, RenderingDevice::FINAL_ACTION_DISCARD, clear_colors);
+	rd->draw_list_bind_render_pipeline(draw_list, pipeline);
+	rd->draw_list_draw_indirect(draw_list, false, command_buffer, 0, 2, 32);
+	rd->draw_list_end();
+	rd->submit();
+	rd->sync();
+
+	const Vector<uint8_t> pixels = rd->texture_get_data(texture, 0);
+	REQUIRE(pixels.size() == 16);
+	CHECK(pixels[0 * 4 + 3] == 255);
+	CHECK(pixels[1 * 4 + 3] == 0);
+	CHECK(pixels[2 * 4 + 3] == 255);
+	CHECK(pixels[3 * 4 + 3] == 0);
+
+	rd->free(command_buffer);
+	rd->free(pipeline);
+	rd->free(framebuffer);
+	rd->free(texture);
+	rd->free(shader);
+	memdelete(rd);
+}
+
+} // namespace TestRenderingDevice
+
+#endif // TEST_RENDERING_DEVICE_H
@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  test_rendering_device_graph.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_DEVICE_GRAPH_H
+#define TEST_RENDERING_DEVICE_GRAPH_H
+
+#include "servers/rendering/rendering_device_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingDeviceGraph {
+
+struct TestInstruction {
+	enum Type {
+		TYPE_VIEWPORT,
+		TYPE_SCISSOR,
+		TYPE_PIPELINE,
+		TYPE_PUSH_CONSTANT,
+		TYPE_UNIFORM_SET,
+		TYPE_DRAW,
+	};
+
+	Type type = TYPE_DRAW;
+	uint32_t value = 0;
+	uint32_t set_index = 0;
+
+	// Where the instruction ends up in the draw list, filled when adding it.
+	uint32_t begin = 0;
+	uint32_t end = 0;
+
+	// Same order as the state is replayed in, or -1 for draws.
+	int get_state_slot() const {
+		switch (type) {
+			case TYPE_VIEWPORT:
+				return 0;
+			case TYPE_SCISSOR:
+				return 1;
+			case TYPE_PIPELINE:
+				return 4;
+			case TYPE_PUSH_CONSTANT:
+				return 7;
+			case TYPE_UNIFORM_SET:
+				return 8 + set_index;
+			default:
+				return -1;
+		}
+	}
+};
+
+void add_test_instruction(RenderingDeviceGraph &p_graph, TestInstruction &r_instruction) {
+	r_instruction.begin = p_graph.get_draw_list_instruction_data().size();
+	switch (r_instruction.type) {
+		case TestInstruction::TYPE_VIEWPORT: {
+			p_graph.add_draw_list_set_viewport(Rect2i(0, 0, r_instruction.value, r_instruction.value));
+		} break;
+		case TestInstruction::TYPE_SCISSOR: {
+			p_graph.add_draw_list_set_scissor(Rect2i(0, 0, r_instruction.value, r_instruction.value));
+		} break;
+		case TestInstruction::TYPE_PIPELINE: {
+			p_graph.add_draw_list_bind_pipeline(RDD::PipelineID(r_instruction.value), BitField<RDD::PipelineStageBits>());
+		} break;
+		case TestInstruction::TYPE_PUSH_CONSTANT: {
+			const uint32_t data[4] = { r_instruction.value, 1, 2, 3 };
+			p_graph.add_draw_list_set_push_constant(RDD::ShaderID(1), data, sizeof(data));
+		} break;
+		case TestInstruction::TYPE_UNIFORM_SET: {
+			p_graph.add_draw_list_bind_uniform_set(RDD::ShaderID(1), RDD::UniformSetID(r_instruction.value), r_instruction.set_index);
+		} break;
+		case TestInstruction::TYPE_DRAW: {
+			p_graph.add_draw_list_draw(3, r_instruction.value);
+		} break;
+	}
+	r_instruction.end = p_graph.get_draw_list_instruction_data().size();
+}
+
+TEST_CASE("[RenderingDeviceGraph] Draw lists are split after draws and replay the state in every chunk") {
+	LocalVector<TestInstruction> instructions;
+	const TestInstruction::Type initial_state[] = { TestInstruction::TYPE_VIEWPORT, TestInstruction::TYPE_PIPELINE, TestInstruction::TYPE_UNIFORM_SET, TestInstruction::TYPE_UNIFORM_SET };
+	for (uint32_t i = 0; i < 4; i++) {
+		TestInstruction instruction;
+		instruction.type = initial_state[i];
+		instruction.value = 64;
+		instruction.set_index = i == 3 ? 2 : 0;
+		instructions.push_back(instruction);
+	}
+	for (uint32_t i = 0; i < 48; i++) {
+		TestInstruction draw;
+		draw.value = i + 1;
+		instructions.push_back(draw);
+
+		// Change some of the state along the way, so chunks don't all start with the initial state.
+		if (i % 10 == 4) {
+			TestInstruction pipeline;
+			pipeline.type = TestInstruction::TYPE_PIPELINE;
+			pipeline.value = 100 + i;
+			instructions.push_back(pipeline);
+			TestInstruction push_constant;
+			push_constant.type = TestInstruction::TYPE_PUSH_CONSTANT;
+			push_constant.value = i;
+			instructions.push_back(push_constant);
+		} else if (i % 10 == 8) {
+			TestInstruction uniform_set;
+			uniform_set.type = TestInstruction::TYPE_UNIFORM_SET;
+			uniform_set.value = 200 + i;
+			instructions.push_back(uniform_set);
+			TestInstruction scissor;
+			scissor.type = TestInstruction::TYPE_SCISSOR;
+			scissor.value = i;
+			instructions.push_back(scissor);
+		}
+	}
+
+	RenderingDeviceGraph graph;
+	graph.add_draw_list_begin(RDD::RenderPassID(), RDD::FramebufferID(), Rect2i(0, 0, 64, 64), VectorView<RDD::RenderPassClearValue>(), true, false);
+	for (TestInstruction &instruction : instructions) {
+		add_test_instruction(graph, instruction);
+	}
+	const LocalVector<uint8_t> &data = graph.get_draw_list_instruction_data();
+
+	const uint32_t max_chunks = 8;
+	LocalVector<uint8_t> chunks[max_chunks];
+	LocalVector<uint8_t> *chunk_ptrs[max_chunks];
+	for (uint32_t i = 0; i < max_chunks; i++) {
+		chunk_ptrs[i] = &chunks[i];
+	}
+
+	SUBCASE("Small draw lists aren't split") {
+		CHECK(RenderingDeviceGraph::split_draw_list_instructions(data.ptr(), data.size(), data.size(), chunk_ptrs, max_chunks) == 1);
+		REQUIRE(chunks[0].size() == data.size());
+		CHECK(memcmp(chunks[0].ptr(), data.ptr(), data.size()) == 0);
+	}
+
+	SUBCASE("Chunks are limited to the buffers available") {
+		CHECK(RenderingDeviceGraph::split_draw_list_instructions(data.ptr(), data.size(), 16, chunk_ptrs, 2) == 2);
+	}
+
+	SUBCASE("Chunks continue where the previous one stopped, after replaying the state") {
+		const uint32_t chunk_count = RenderingDeviceGraph::split_draw_list_instructions(data.ptr(), data.size(), data.size() / 4 + 1, chunk_ptrs, max_chunks);
+		REQUIRE(chunk_count == 4);
+
+		uint32_t split = 0;
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			// The state set before the split, in replay order.
+			LocalVector<uint8_t> expected;
+			if (c > 0) {
+				LocalVector<int> latest;
+				for (uint32_t i = 0; i < instructions.size() && instructions[i].end <= split; i++) {
+					const int slot = instructions[i].get_state_slot();
+					if (slot < 0) {
+						continue;
+					}
+					if (slot >= int(latest.size())) {
+						const uint32_t previous_size = latest.size();
+						latest.resize(slot + 1);
+						for (uint32_t j = previous_size; j < latest.size(); j++) {
+							latest[j] = -1;
+						}
+					}
+					latest[slot] = i;
+				}
+				for (int index : latest) {
+					if (index >= 0) {
+						for (uint32_t j = instructions[index].begin; j < instructions[index].end; j++) {
+							expected.push_back(data[j]);
+						}
+					}
+				}
+			}
+
+			REQUIRE(chunks[c].size() > expected.size());
+			CHECK_MESSAGE(memcmp(chunks[c].ptr(), expected.ptr(), expected.size()) == 0, vformat("Chunk %d should start by restoring the state.", c));
+
+			const uint32_t instructions_size = chunks[c].size() - expected.size();
+			REQUIRE(split + instructions_size <= data.size());
+			CHECK(memcmp(chunks[c].ptr() + expected.size(), data.ptr() + split, instructions_size) == 0);
+			split += instructions_size;
+
+			if (c < chunk_count - 1) {
+				bool after_draw = false;
+				for (const TestInstruction &instruction : instructions) {
+					after_draw = after_draw || (instruction.type == TestInstruction::TYPE_DRAW && instruction.end == split);
+				}
+				CHECK_MESSAGE(after_draw, vformat("Chunk %d should end right after a draw.", c));
+			}
+		}
+		CHECK_MESSAGE(split == data.size(), "Every instruction should be in a chunk.");
+	}
+}
+
+} // namespace TestRenderingDeviceGraph
+
+#endif // TEST_RENDERING_DEVICE_GRAPH_H
@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  test_texture_storage_rd.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TEXTURE_STORAGE_RD_H
+#define TEST_TEXTURE_STORAGE_RD_H
+
+#include "servers/rendering/renderer_rd/storage_rd/texture_storage.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTextureStorageRD {
+
+using RendererRD::TextureStorage;
+
+TEST_CASE("[TextureStorageRD] Canvas texture atlas only accepts textures that fit a page with padding") {
+	const int padding = TextureStorage::CANVAS_TEXTURE_ATLAS_PADDING;
+
+	CHECK(TextureStorage::canvas_texture_atlas_fits(Size2i(64, 32), 256, 2048));
+	CHECK_FALSE(TextureStorage::canvas_texture_atlas_fits(Size2i(257, 32), 256, 2048));
+	CHECK_FALSE(TextureStorage::canvas_texture_atlas_fits(Size2i(0, 32), 256, 2048));
+
+	// A texture allowed by the maximum texture size can still be too large for the page once padded.
+	CHECK(TextureStorage::canvas_texture_atlas_fits(Size2i(256 - padding * 2, 16), 1024, 256));
+	CHECK_FALSE(TextureStorage::canvas_texture_atlas_fits(Size2i(256, 16), 1024, 256));
+	CHECK_FALSE(TextureStorage::canvas_texture_atlas_fits(Size2i(16, 256 - padding), 1024, 256));
+}
+
+TEST_CASE("[TextureStorageRD] Canvas texture atlas packing") {
+	const int padding = TextureStorage::CANVAS_TEXTURE_ATLAS_PADDING;
+	const int page_size = 256;
+
+	LocalVector<TextureStorage::CanvasTextureAtlasItem> items;
+	const Size2i sizes[] = { Size2i(100, 60), Size2i(30, 30), Size2i(250, 10), Size2i(120, 120), Size2i(16, 16), Size2i(400, 8), Size2i(1, 1) };
+	for (const Size2i &size : sizes) {
+		TextureStorage::CanvasTextureAtlasItem item;
+		item.size = size;
+		items.push_back(item);
+	}
+
+	SUBCASE("Packed textures don't overlap each other's padding") {
+		LocalVector<TextureStorage::CanvasTextureAtlasShelf> shelves = TextureStorage::canvas_texture_atlas_pack(items, page_size, 4);
+		REQUIRE(shelves.size() == 1);
+
+		CHECK_MESSAGE(items[5].page == -1, "Textures larger than a page are left out.");
+
+		for (uint32_t i = 0; i < items.size(); i++) {
+			if (i == 5) {
+				continue;
+			}
+			CHECK(items[i].page == 0);
+
+			const Rect2i padded_rect = Rect2i(items[i].position, items[i].size).grow(padding);
+			CHECK_MESSAGE(Rect2i(0, 0, page_size, shelves[0].get_used_height()).encloses(padded_rect), "Padding stays inside the used part of the page.");
+			for (uint32_t j = i + 1; j < items.size(); j++) {
+				if (j == 5) {
+					continue;
+				}
+				const Rect2i other_padded_rect = Rect2i(items[j].position, items[j].size).grow(padding);
+				CHECK_FALSE(padded_rect.intersects(other_padded_rect));
+			}
+		}
+	}
+
+	SUBCASE("Textures spill over to new pages until the page limit") {
+		LocalVector<TextureStorage::CanvasTextureAtlasItem> large_items;
+		for (int i = 0; i < 5; i++) {
+			TextureStorage::CanvasTextureAtlasItem item;
+			item.size = Size2i(page_size - padding * 2, page_size - padding * 2);
+			large_items.push_back(item);
+		}
+
+		LocalVector<TextureStorage::CanvasTextureAtlasShelf> shelves = TextureStorage::canvas_texture_atlas_pack(large_items, page_size, 3);
+		CHECK(shelves.size() == 3);
+		int packed = 0;
+		for (const TextureStorage::CanvasTextureAtlasItem &item : large_items) {
+			if (item.page >= 0) {
+				CHECK(item.position == Point2i(padding, padding));
+				packed++;
+			}
+		}
+		CHECK(packed == 3);
+	}
+
+	SUBCASE("Nothing to pack") {
+		LocalVector<TextureStorage::CanvasTextureAtlasItem> oversized;
+		TextureStorage::CanvasTextureAtlasItem item;
+		item.size = Size2i(page_size, 4);
+		oversized.push_back(item);
+
+		CHECK(TextureStorage::canvas_texture_atlas_pack(oversized, page_size, 4).is_empty());
+		CHECK(oversized[0].page == -1);
+	}
+
+	SUBCASE("Textures added later go after the packed ones") {
+		LocalVector<TextureStorage::CanvasTextureAtlasShelf> shelves = TextureStorage::canvas_texture_atlas_pack(items, page_size, 4);
+		REQUIRE(shelves.size() == 1);
+		// Pages are allocated with the used height rounded up, like the atlas does.
+		const Size2i used_page_size(page_size, nearest_power_of_2_templated(uint32_t(shelves[0].get_used_height())));
+
+		LocalVector<Rect2i> padded_rects;
+		for (const TextureStorage::CanvasTextureAtlasItem &item : items) {
+			if (item.page == 0) {
+				padded_rects.push_back(Rect2i(item.position, item.size).grow(padding));
+			}
+		}
+
+		int added = 0;
+		for (int i = 0; i < 64; i++) {
+			TextureStorage::CanvasTextureAtlasItem item;
+			item.size = Size2i(20 + i % 5, 10 + i % 3);
+			const TextureStorage::CanvasTextureAtlasShelf previous_shelf = shelves[0];
+			if (!TextureStorage::canvas_texture_atlas_place(shelves[0], item, 0, used_page_size)) {
+				CHECK_MESSAGE(shelves[0].cursor == previous_shelf.cursor, "A texture that doesn't fit leaves the shelf as is.");
+				CHECK(item.page == -1);
+				break;
+			}
+			added++;
+
+			const Rect2i padded_rect = Rect2i(item.position, item.size).grow(padding);
+			CHECK(Rect2i(Point2i(), used_page_size).encloses(padded_rect));
+			for (const Rect2i &other_padded_rect : padded_rects) {
+				CHECK_FALSE(padded_rect.intersects(other_padded_rect));
+			}
+			padded_rects.push_back(padded_rect);
+		}
+		CHECK(added > 0);
+		CHECK_MESSAGE(added < 64, "The page should overflow.");
+	}
+}
+
+} // namespace TestTextureStorageRD
+
+#endif // TEST_TEXTURE_STORAGE_RD_H
@@ -92,7 +92,9 @@
 #include "tests/core/variant/test_dictionary.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
+#include "tests/editor/test_editor_import_cache.h"
 #include "tests/scene/test_animation.h"
+#include "tests/scene/test_animation_mixer.h"
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_audio_stream_wav.h"
 #include "tests/scene/test_bit_map.h"
@@ -117,7 +119,14 @@
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
+#include "tests/servers/rendering/test_pipeline_cache_rd.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+#include "tests/servers/rendering/test_renderer_scene_cull.h"
+#include "tests/servers/rendering/test_renderer_scene_occlusion_cull.h"
+#include "tests/servers/rendering/test_rendering_device.h"
+#include "tests/servers/rendering/test_rendering_device_graph.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/rendering/test_texture_storage_rd.h"
 #include "tests/servers/test_navigation_server_2d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
@@ -128,6 +137,7 @@
 #include "tests/scene/test_navigation_obstacle_3d.h"
 #include "tests/scene/test_navigation_region_3d.h"
 #include "tests/scene/test_path_3d.h"
+#include "tests/scene/test_skeleton_3d.h"
 #include "tests/servers/test_navigation_server_3d.h"
 #endif // _3D_DISABLED
 